@@ -212,6 +212,11 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
         if (!ret) {
             LOGE() << "failed batch convert, error: " << ret.toString();
         }
+    } else if (task.isPartsMode) {
+        ret = converter()->partsConvert(task.inputFile, task.outputFile);
+        if (!ret) {
+            LOGE() << "failed parts convert, error: " << ret.toString();
+        }
     } else {
         ret = converter()->fileConvert(task.inputFile, task.outputFile);
         if (!ret) {
@@ -37,6 +37,7 @@ void CommandLineController::parse(const QStringList& args)
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
+    m_parser.addOption(QCommandLineOption({ "P", "export-score-parts" }, "Use with -o: export each part of the score to its own file"));
 
     m_parser.process(args);
 }
@@ -85,6 +86,7 @@ void CommandLineController::apply()
             }
             m_converterTask.inputFile = scorefiles[0];
             m_converterTask.outputFile = m_parser.value("o");
+            m_converterTask.isPartsMode = m_parser.isSet("P");
         }
     }
 
@@ -38,6 +38,7 @@ public:
 
     struct ConverterTask {
         bool isBatchMode = false;
+        bool isPartsMode = false;
         QString inputFile;
         QString outputFile;
     };
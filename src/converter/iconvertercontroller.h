@@ -31,6 +31,8 @@ public:
     virtual ~IConverterController() = default;
 
     virtual Ret fileConvert(const io::path& in, const io::path& out) = 0;
+    //! writes each part of the score to its own file, <out basename>-<part name>.<out suffix>
+    virtual Ret partsConvert(const io::path& in, const io::path& out) = 0;
     virtual Ret batchConvert(const io::path& batchJobFile) = 0;
 };
 }
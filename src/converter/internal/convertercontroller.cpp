@@ -18,7 +18,11 @@
 //=============================================================================
 #include "convertercontroller.h"
 
+#include <memory>
+#include <vector>
+
 #include <QFile>
+#include <QSet>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -40,7 +44,7 @@ mu::Ret ConverterController::batchConvert(const io::path& batchJobFile)
 
     Ret ret = make_ret(Ret::Code::Ok);
     for (const Job& job : batchJob.val) {
-        ret = fileConvert(job.in, job.out);
+        ret = job.parts ? partsConvert(job.in, job.out) : fileConvert(job.in, job.out);
         if (!ret) {
             LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
             break;
@@ -87,6 +91,75 @@ mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out
     return make_ret(Ret::Code::Ok);
 }
 
+mu::Ret ConverterController::partsConvert(const io::path& in, const io::path& out)
+{
+    TRACEFUNC;
+    LOGI() << "in: " << in << ", out: " << out;
+    auto masterNotation = notationCreator()->newMasterNotation();
+    IF_ASSERT_FAILED(masterNotation) {
+        return make_ret(Err::UnknownError);
+    }
+
+    std::string suffix = io::syffix(out);
+    auto writer = writers()->writer(suffix);
+    if (!writer) {
+        return make_ret(Err::ConvertTypeUnknown);
+    }
+
+    Ret ret = masterNotation->load(in);
+    if (!ret) {
+        LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << in;
+        return make_ret(Err::InFileFailedLoad);
+    }
+
+    notation::INotationPtr notation = masterNotation->notation();
+
+    //! NOTE all parts are written in one pass, so the files are opened up front.
+    //! A part without a name or with the name of an earlier part gets its number appended
+    std::vector<std::unique_ptr<QFile> > files;
+    std::vector<system::IODevice*> devices;
+    QSet<QString> names;
+
+    auto removeFiles = [&files]() {
+        for (const std::unique_ptr<QFile>& file : files) {
+            file->remove();
+        }
+    };
+
+    int partNo = 0;
+    for (const notation::Part* part : notation->parts()->partList()) {
+        ++partNo;
+        QString name = io::escapeFileName(part->partName()).toQString();
+        if (name.isEmpty()) {
+            name = QString::number(partNo);
+        }
+        while (names.contains(name.toLower())) {
+            name += "-" + QString::number(partNo);
+        }
+        names.insert(name.toLower());
+
+        io::path partOut = io::dirpath(out) + "/" + io::basename(out) + "-" + name + "." + suffix.c_str();
+        auto file = std::make_unique<QFile>(partOut.toQString());
+        if (!file->open(QFile::WriteOnly)) {
+            LOGE() << "failed open, path: " << partOut;
+            removeFiles();
+            return make_ret(Err::OutFileFailedOpen);
+        }
+
+        devices.push_back(file.get());
+        files.push_back(std::move(file));
+    }
+
+    ret = writer->writeParts(notation, devices);
+    if (!ret) {
+        LOGE() << "failed write parts, err: " << ret.toString() << ", path: " << out;
+        removeFiles();
+        return make_ret(Err::OutFileFailedWrite);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
 mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(const io::path& batchJobFile) const
 {
     RetVal<BatchJob> rv;
@@ -112,6 +185,7 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
         Job job;
         job.in = obj["in"].toString();
         job.out = obj["out"].toString();
+        job.parts = obj["parts"].toBool();
 
         if (!job.in.empty() && !job.out.empty()) {
             rv.val.push_back(std::move(job));
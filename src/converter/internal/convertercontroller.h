@@ -39,6 +39,7 @@ public:
     ConverterController() = default;
 
     Ret fileConvert(const io::path& in, const io::path& out) override;
+    Ret partsConvert(const io::path& in, const io::path& out) override;
     Ret batchConvert(const io::path& batchJobFile) override;
 
 private:
@@ -46,6 +47,7 @@ private:
     struct Job {
         io::path in;
         io::path out;
+        bool parts = false;
     };
 
     using BatchJob = std::list<Job>;
@@ -0,0 +1,75 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include <gtest/gtest.h>
+
+#include "appshell/commandlinecontroller.h"
+
+#include "framework/global/tests/mocks/applicationmock.h"
+
+using ::testing::_;
+using ::testing::NiceMock;
+
+using namespace mu;
+using namespace mu::appshell;
+using namespace mu::framework;
+
+class CommandLineControllerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_controller = std::make_shared<CommandLineController>();
+        m_application = std::make_shared<NiceMock<ApplicationMock> >();
+
+        m_controller->setapplication(m_application);
+    }
+
+    std::shared_ptr<CommandLineController> m_controller;
+    std::shared_ptr<ApplicationMock> m_application;
+};
+
+TEST_F(CommandLineControllerTest, ExportParts)
+{
+    // [THEN] MuseScore runs as converter
+    EXPECT_CALL(*m_application, setRunMode(IApplication::RunMode::Converter));
+
+    // [WHEN] The parts of a score are exported
+    m_controller->parse({ "mscore", "-o", "score.pdf", "-P", "score.mscz" });
+    m_controller->apply();
+
+    // [THEN] The converter exports the parts
+    CommandLineController::ConverterTask task = m_controller->converterTask();
+    EXPECT_FALSE(task.isBatchMode);
+    EXPECT_TRUE(task.isPartsMode);
+    EXPECT_EQ(task.inputFile, "score.mscz");
+    EXPECT_EQ(task.outputFile, "score.pdf");
+}
+
+TEST_F(CommandLineControllerTest, ExportScore)
+{
+    // [WHEN] A score is exported without -P
+    m_controller->parse({ "mscore", "--export-to", "score.pdf", "score.mscz" });
+    m_controller->apply();
+
+    // [THEN] The converter exports the whole score
+    CommandLineController::ConverterTask task = m_controller->converterTask();
+    EXPECT_FALSE(task.isPartsMode);
+    EXPECT_EQ(task.outputFile, "score.pdf");
+}
@@ -0,0 +1,245 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "converter/internal/convertercontroller.h"
+#include "converter/convertercodes.h"
+#include "libmscore/part.h"
+
+#include "notation/tests/mocks/notationcreatormock.h"
+#include "notation/tests/mocks/masternotationmock.h"
+#include "notation/tests/mocks/notationmock.h"
+#include "notation/tests/mocks/notationpartsmock.h"
+#include "notation/tests/mocks/notationwritersregistermock.h"
+#include "notation/tests/mocks/notationwritermock.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::converter;
+using namespace mu::notation;
+
+class ConverterControllerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+
+        m_controller = std::make_shared<ConverterController>();
+        m_notationCreator = std::make_shared<NiceMock<NotationCreatorMock> >();
+        m_writers = std::make_shared<NiceMock<NotationWritersRegisterMock> >();
+        m_writer = std::make_shared<NiceMock<NotationWriterMock> >();
+        m_masterNotation = std::make_shared<NiceMock<MasterNotationMock> >();
+        m_notation = std::make_shared<NiceMock<NotationMock> >();
+        m_parts = std::make_shared<NiceMock<NotationPartsMock> >();
+
+        m_controller->setnotationCreator(m_notationCreator);
+        m_controller->setwriters(m_writers);
+
+        ON_CALL(*m_notationCreator, newMasterNotation()).WillByDefault(Return(m_masterNotation));
+        ON_CALL(*m_writers, writer("pdf")).WillByDefault(Return(m_writer));
+        ON_CALL(*m_masterNotation, load(_)).WillByDefault(Return(make_ret(Ret::Code::Ok)));
+        ON_CALL(*m_masterNotation, notation()).WillByDefault(Return(m_notation));
+        ON_CALL(*m_notation, parts()).WillByDefault(Return(m_parts));
+        ON_CALL(*m_parts, partList()).WillByDefault(Invoke([this]() {
+            async::NotifyList<const Part*> list;
+            for (const std::unique_ptr<Part>& part : m_partList) {
+                list.push_back(part.get());
+            }
+            return list;
+        }));
+    }
+
+    void setPartNames(const QStringList& names)
+    {
+        m_partList.clear();
+        for (const QString& name : names) {
+            auto part = std::make_unique<Part>();
+            part->setPartName(name);
+            m_partList.push_back(std::move(part));
+        }
+    }
+
+    //! NOTE the writer writes the name of each part into its device
+    Ret writePartNames(const INotationPtr, const std::vector<system::IODevice*>& devices)
+    {
+        if (devices.size() != m_partList.size()) {
+            return make_ret(Ret::Code::UnknownError);
+        }
+        for (size_t i = 0; i < devices.size(); ++i) {
+            devices[i]->write(m_partList[i]->partName().toUtf8());
+        }
+        return make_ret(Ret::Code::Ok);
+    }
+
+    io::path outPath() const
+    {
+        return io::path(m_dir.filePath("score.pdf"));
+    }
+
+    QStringList outFiles() const
+    {
+        return QDir(m_dir.path()).entryList(QDir::Files, QDir::Name);
+    }
+
+    QByteArray readFile(const QString& name) const
+    {
+        QFile file(m_dir.filePath(name));
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    QTemporaryDir m_dir;
+    std::vector<std::unique_ptr<Part> > m_partList;
+
+    std::shared_ptr<ConverterController> m_controller;
+    std::shared_ptr<NotationCreatorMock> m_notationCreator;
+    std::shared_ptr<NotationWritersRegisterMock> m_writers;
+    std::shared_ptr<NotationWriterMock> m_writer;
+    std::shared_ptr<MasterNotationMock> m_masterNotation;
+    std::shared_ptr<NotationMock> m_notation;
+    std::shared_ptr<NotationPartsMock> m_parts;
+};
+
+TEST_F(ConverterControllerTest, PartsConvert_WritesAllPartsInOnePass)
+{
+    // [GIVEN] A score with two parts
+    setPartNames({ "Flute", "Violin" });
+
+    // [THEN] The parts are written with one call, in their order
+    EXPECT_CALL(*m_writer, writeParts(_, _, _))
+    .Times(1)
+    .WillOnce(Invoke([this](const INotationPtr notation, const std::vector<system::IODevice*>& devices,
+                            const INotationWriter::Options&) {
+        return writePartNames(notation, devices);
+    }));
+    EXPECT_CALL(*m_writer, write(_, _, _)).Times(0);
+
+    // [WHEN] The parts are exported
+    Ret ret = m_controller->partsConvert("score.mscz", outPath());
+
+    // [THEN] Each part is in its own file, named after the score and the part
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(outFiles(), QStringList({ "score-Flute.pdf", "score-Violin.pdf" }));
+    EXPECT_EQ(readFile("score-Flute.pdf"), QByteArray("Flute"));
+    EXPECT_EQ(readFile("score-Violin.pdf"), QByteArray("Violin"));
+}
+
+TEST_F(ConverterControllerTest, PartsConvert_UniqueNames)
+{
+    // [GIVEN] Parts with the same name in different case, without a name,
+    // with the number of the unnamed one as name and with characters a file name can't have
+    setPartNames({ "Violin", "violin", "", "3", "Alto Sax: 1/2" });
+
+    EXPECT_CALL(*m_writer, writeParts(_, _, _))
+    .WillOnce(Invoke([this](const INotationPtr notation, const std::vector<system::IODevice*>& devices,
+                            const INotationWriter::Options&) {
+        return writePartNames(notation, devices);
+    }));
+
+    // [WHEN] The parts are exported
+    Ret ret = m_controller->partsConvert("score.mscz", outPath());
+
+    // [THEN] Every part gets a file of its own
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(outFiles().size(), 5);
+    EXPECT_EQ(readFile("score-Violin.pdf"), QByteArray("Violin"));
+    EXPECT_EQ(readFile("score-violin-2.pdf"), QByteArray("violin"));
+    EXPECT_EQ(readFile("score-3.pdf"), QByteArray(""));
+    EXPECT_EQ(readFile("score-3-4.pdf"), QByteArray("3"));
+    EXPECT_EQ(readFile("score-Alto_Sax__1_2.pdf"), QByteArray("Alto Sax: 1/2"));
+}
+
+TEST_F(ConverterControllerTest, PartsConvert_RemovesFilesWhenWriteFails)
+{
+    // [GIVEN] A writer that fails after writing the first part
+    setPartNames({ "Flute", "Violin" });
+
+    EXPECT_CALL(*m_writer, writeParts(_, _, _))
+    .WillOnce(Invoke([](const INotationPtr, const std::vector<system::IODevice*>& devices,
+                        const INotationWriter::Options&) {
+        devices.front()->write("Flute");
+        return make_ret(Ret::Code::UnknownError);
+    }));
+
+    // [WHEN] The parts are exported
+    Ret ret = m_controller->partsConvert("score.mscz", outPath());
+
+    // [THEN] No file is left behind
+    EXPECT_EQ(ret.code(), static_cast<int>(Err::OutFileFailedWrite));
+    EXPECT_TRUE(outFiles().isEmpty());
+}
+
+TEST_F(ConverterControllerTest, PartsConvert_RemovesFilesWhenOpenFails)
+{
+    // [GIVEN] The file of the second part can't be opened
+    setPartNames({ "Flute", "Violin", "Cello" });
+    ASSERT_TRUE(QDir(m_dir.path()).mkdir("score-Violin.pdf"));
+
+    // [THEN] Nothing is written
+    EXPECT_CALL(*m_writer, writeParts(_, _, _)).Times(0);
+
+    // [WHEN] The parts are exported
+    Ret ret = m_controller->partsConvert("score.mscz", outPath());
+
+    // [THEN] The file opened before is removed again
+    EXPECT_EQ(ret.code(), static_cast<int>(Err::OutFileFailedOpen));
+    EXPECT_TRUE(outFiles().isEmpty());
+}
+
+TEST_F(ConverterControllerTest, BatchConvert_PartsJob)
+{
+    // [GIVEN] A batch job exporting the parts of one score and another score as a whole
+    setPartNames({ "Flute", "Violin" });
+
+    QFile job(m_dir.filePath("job.json"));
+    ASSERT_TRUE(job.open(QIODevice::WriteOnly));
+    job.write(QString("[ { \"in\": \"a.mscz\", \"out\": \"%1\", \"parts\": true },"
+                      "  { \"in\": \"b.mscz\", \"out\": \"%2\" } ]")
+              .arg(m_dir.filePath("a.pdf"), m_dir.filePath("b.pdf")).toUtf8());
+    job.close();
+
+    // [THEN] The first job writes the parts, the second the score
+    EXPECT_CALL(*m_masterNotation, load(io::path("a.mscz"))).WillOnce(Return(make_ret(Ret::Code::Ok)));
+    EXPECT_CALL(*m_masterNotation, load(io::path("b.mscz"))).WillOnce(Return(make_ret(Ret::Code::Ok)));
+    EXPECT_CALL(*m_writer, writeParts(_, _, _))
+    .Times(1)
+    .WillOnce(Invoke([this](const INotationPtr notation, const std::vector<system::IODevice*>& devices,
+                            const INotationWriter::Options&) {
+        return writePartNames(notation, devices);
+    }));
+    EXPECT_CALL(*m_writer, write(_, _, _))
+    .Times(1)
+    .WillOnce(Return(make_ret(Ret::Code::Ok)));
+
+    // [WHEN] The batch job is run
+    Ret ret = m_controller->batchConvert(io::path(job.fileName()));
+
+    // [THEN] All files are there
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(outFiles(), QStringList({ "a-Flute.pdf", "a-Violin.pdf", "b.pdf", "job.json" }));
+}
@@ -35,9 +35,11 @@
 #include "internal/audiosanitizer.h"
 #include "internal/audiothread.h"
 #include "internal/audiobuffer.h"
+#include "internal/offlinerenderer.h"
 
 // synthesizers
 #include "internal/synthesizers/fluidsynth/fluidsynth.h"
+#include "internal/synthesizers/fluidsynth/fluidsoundfontcache.h"
 #include "internal/synthesizers/zerberus/zerberussynth.h"
 #include "internal/synthesizers/soundfontsprovider.h"
 #include "internal/synthesizers/synthesizercontroller.h"
@@ -98,6 +100,7 @@ void AudioModule::registerExports()
     ioc()->registerExport<IAudioConfiguration>(moduleName(), s_audioConfiguration);
     ioc()->registerExport<IAudioDriver>(moduleName(), s_audioDriver);
     ioc()->registerExport<ISequencer>(moduleName(), s_rpcSequencer);
+    ioc()->registerExport<IOfflineRenderer>(moduleName(), std::make_shared<OfflineRenderer>());
 
     // synthesizers
     std::shared_ptr<synth::ISynthesizersRegister> sreg = std::make_shared<synth::SynthesizersRegister>();
@@ -160,6 +163,11 @@ void AudioModule::onInit(const framework::IApplication::RunMode&)
     // Init configuration
     s_audioConfiguration->init();
 
+    //! NOTE Decode the soundfonts while the worker and the driver start,
+    //! the synthesizers then take them from the cache
+    auto soundFonts = ioc()->resolve<synth::ISoundFontsProvider>(moduleName());
+    synth::FluidSoundFontCache::instance()->preload(soundFonts->soundFontPathsForSynth("Fluid"));
+
     // Setup rpc system and worker
     s_rpcSequencer->setup();
     s_audioWorker->channel()->setupMainThread();
@@ -54,12 +54,12 @@ void AudioEngineDevTools::setMuteSine(bool mute)
 
 void AudioEngineDevTools::setLevelSine(float level)
 {
-    rpcChannel()->send(Msg(TargetName::DevTools, "setLevelSine", Args::make_arg1<float>(level)));
+    rpcChannel()->sendCommand(Command::makeValue(TargetName::DevTools, CommandID::SetLevel, SineChannel, level));
 }
 
 void AudioEngineDevTools::setBalanceSine(float balance)
 {
-    rpcChannel()->send(Msg(TargetName::DevTools, "setBalanceSine", Args::make_arg1<float>(balance)));
+    rpcChannel()->sendCommand(Command::makeValue(TargetName::DevTools, CommandID::SetBalance, SineChannel, balance));
 }
 
 // Noise
@@ -80,12 +80,12 @@ void AudioEngineDevTools::setMuteNoise(bool mute)
 
 void AudioEngineDevTools::setLevelNoise(float level)
 {
-    rpcChannel()->send(Msg(TargetName::DevTools, "setLevelNoise", Args::make_arg1<float>(level)));
+    rpcChannel()->sendCommand(Command::makeValue(TargetName::DevTools, CommandID::SetLevel, NoiseChannel, level));
 }
 
 void AudioEngineDevTools::setBalanceNoise(float balance)
 {
-    rpcChannel()->send(Msg(TargetName::DevTools, "setBalanceSine", Args::make_arg1<float>(balance)));
+    rpcChannel()->sendCommand(Command::makeValue(TargetName::DevTools, CommandID::SetBalance, NoiseChannel, balance));
 }
 
 void AudioEngineDevTools::enableNoiseEq(bool enable)
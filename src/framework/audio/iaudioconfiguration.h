@@ -34,6 +34,9 @@ public:
 
     virtual unsigned int driverBufferSize() const = 0; // samples
 
+    // ms of each Zerberus sample kept in memory, the rest is streamed from disk; 0 loads samples completely
+    virtual int zerberusStreamingPreloadTime() const = 0;
+
     // synthesizers
     virtual std::vector<io::path> soundFontPaths() const = 0;
     virtual const synth::SynthesizerState& synthesizerState() const = 0;
@@ -35,7 +35,8 @@ public:
     //! return streams count for this insert: 1 for mono, 2 for stereo
     virtual unsigned int streamCount() const = 0;
 
-    virtual void process(float* input, float* output, unsigned int sampleCount) = 0;
+    //! process a block in place: one planar buffer of sampleCount samples per stream
+    virtual void process(float** buffers, unsigned int sampleCount) = 0;
 };
 
 using IAudioProcessorPtr = std::shared_ptr<IAudioProcessor>;
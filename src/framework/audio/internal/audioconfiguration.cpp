@@ -20,6 +20,8 @@
 #include "settings.h"
 #include "stringutils.h"
 
+#include "internal/synthesizers/zerberus/internal/zerberus.h"
+
 #include "global/xmlreader.h"
 #include "global/xmlwriter.h"
 
@@ -35,6 +37,7 @@ using namespace mu::audio::synth;
 
 //TODO: add other setting: audio device etc
 static const Settings::Key AUDIO_BUFFER_SIZE("audio", "driver_buffer");
+static const Settings::Key ZERBERUS_STREAMING_PRELOAD_TIME("audio", "zerberus_streaming_preload");
 
 static const Settings::Key MY_SOUNDFONTS("midi", "application/paths/mySoundfonts");
 
@@ -51,6 +54,13 @@ void AudioConfiguration::init()
     defaultBufferSize = 1024;
 #endif
     settings()->setDefaultValue(AUDIO_BUFFER_SIZE, Val(defaultBufferSize));
+
+    //! NOTE Applies to the samples loaded afterwards
+    settings()->setDefaultValue(ZERBERUS_STREAMING_PRELOAD_TIME, Val(0));
+    zerberus::Zerberus::setStreamingPreloadTime(zerberusStreamingPreloadTime());
+    settings()->valueChanged(ZERBERUS_STREAMING_PRELOAD_TIME).onReceive(nullptr, [](const Val& val) {
+        zerberus::Zerberus::setStreamingPreloadTime(val.toInt());
+    });
 }
 
 unsigned int AudioConfiguration::driverBufferSize() const
@@ -58,6 +68,11 @@ unsigned int AudioConfiguration::driverBufferSize() const
     return settings()->value(AUDIO_BUFFER_SIZE).toInt();
 }
 
+int AudioConfiguration::zerberusStreamingPreloadTime() const
+{
+    return settings()->value(ZERBERUS_STREAMING_PRELOAD_TIME).toInt();
+}
+
 std::vector<io::path> AudioConfiguration::soundFontPaths() const
 {
     std::string pathsStr = settings()->value(MY_SOUNDFONTS).toString();
@@ -34,6 +34,8 @@ public:
 
     unsigned int driverBufferSize() const override;
 
+    int zerberusStreamingPreloadTime() const override;
+
     std::vector<io::path> soundFontPaths() const override;
 
     const synth::SynthesizerState& defaultSynthesizerState() const;
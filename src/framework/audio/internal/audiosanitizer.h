@@ -35,11 +35,16 @@ public:
     static void setupWorkerThread();
     static std::thread::id workerThread();
     static bool isWorkerThread();
+
+    //! NOTE threads rendering for the worker thread, which waits for them, and offline render threads
+    static void setupRenderThread();
+    static bool isRenderThread();
 };
 }
 
 #define ONLY_AUDIO_WORKER_THREAD assert(mu::audio::AudioSanitizer::isWorkerThread())
 #define ONLY_AUDIO_MAIN_THREAD assert(mu::audio::AudioSanitizer::isMainThread())
+#define ONLY_AUDIO_WORKER_OR_RENDER_THREAD assert((mu::audio::AudioSanitizer::isWorkerThread() || mu::audio::AudioSanitizer::isRenderThread()))
 #define ONLY_AUDIO_MAIN_OR_WORKER_THREAD assert((mu::audio::AudioSanitizer::isWorkerThread() || mu::audio::AudioSanitizer::isMainThread()))
 
 #endif // MU_AUDIO_AUDIOSANITIZER_H
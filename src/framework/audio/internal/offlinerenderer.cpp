@@ -0,0 +1,206 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "offlinerenderer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include "log.h"
+#include "audioerrors.h"
+#include "internal/audiosanitizer.h"
+#include "internal/worker/clock.h"
+#include "internal/worker/midiplayer.h"
+#include "internal/worker/mixer.h"
+#include "internal/worker/renderpool.h"
+#include "internal/synthesizers/synthesizersregister.h"
+#include "internal/synthesizers/fluidsynth/fluidsynth.h"
+#include "internal/synthesizers/zerberus/zerberussynth.h"
+#include "midi/imidiportdatasender.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+
+namespace {
+//! NOTE an offline render must not play on the midi output ports
+class NoMidiPortDataSender : public IMidiPortDataSender
+{
+public:
+    void setMidiStream(std::shared_ptr<MidiStream>) override {}
+    bool sendEvents(tick_t, tick_t) override { return true; }
+    bool sendSingleEvent(const Event&) override { return true; }
+};
+
+ISynthesizerPtr createSynthesizer(const SynthName& name)
+{
+    if (name == "Fluid") {
+        return std::make_shared<FluidSynth>();
+    }
+    if (name == "Zerberus") {
+        return std::make_shared<ZerberusSynth>();
+    }
+    return nullptr;
+}
+
+bool isSilent(const float* data, unsigned int samples)
+{
+    return std::all_of(data, data + samples, [](float v) { return std::fabs(v) < 1e-6f; });
+}
+}
+
+Ret OfflineRenderer::render(const std::shared_ptr<MidiStream>& stream, const Options& options, const std::vector<Job>& jobs)
+{
+    IF_ASSERT_FAILED(stream) {
+        return make_ret(Err::AudioStreamNotPresent);
+    }
+
+    IF_ASSERT_FAILED(options.sampleRate > 0 && options.blockSize > 0) {
+        return make_ret(Err::EngineInvalidParameter);
+    }
+
+    //! NOTE stems render one per thread; a single render spreads its synthesizers over the threads instead
+    const unsigned int threadCount = std::min<unsigned int>(RenderPool::defaultThreadCount(), jobs.size());
+    const unsigned int mixerThreads = jobs.size() > 1 ? 1 : RenderPool::defaultThreadCount();
+
+    std::vector<Ret> rets(jobs.size(), make_ret(Ret::Code::Ok));
+    std::atomic<size_t> nextJob { 0 };
+
+    //! NOTE the main thread is not an audio thread, the render runs on its own threads even for one job.
+    //! The jobs of a thread share its synthesizers, so the soundfonts are set up once per thread;
+    //! their sample data comes from the caches the playback synthesizers use as well
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        threads.emplace_back([&]() {
+            AudioSanitizer::setupRenderThread();
+            ISynthesizersRegisterPtr synths;
+            for (size_t j = nextJob++; j < jobs.size(); j = nextJob++) {
+                if (!synths) {
+                    synths = createSynthesizers(options.sampleRate);
+                } else {
+                    resetSynthesizers(synths);
+                }
+                rets[j] = renderJob(stream, options, jobs[j], synths, mixerThreads);
+            }
+        });
+    }
+
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    for (const Ret& ret : rets) {
+        if (!ret) {
+            return ret;
+        }
+    }
+    return make_ret(Ret::Code::Ok);
+}
+
+ISynthesizersRegisterPtr OfflineRenderer::createSynthesizers(unsigned int sampleRate) const
+{
+    auto reg = std::make_shared<SynthesizersRegister>();
+    for (const ISynthesizerPtr& shared : synthesizersRegister()->synthesizers()) {
+        SynthName name = shared->name();
+        ISynthesizerPtr synth = createSynthesizer(name);
+        if (!synth) {
+            LOGW() << "synth " << name << " can't be rendered offline";
+            continue;
+        }
+
+        synth->setSampleRate(sampleRate);
+        synth->init();
+        synth->addSoundFonts(soundFontsProvider()->soundFontPathsForSynth(name));
+        reg->registerSynthesizer(name, synth);
+    }
+
+    if (ISynthesizerPtr def = synthesizersRegister()->defaultSynthesizer()) {
+        reg->setDefaultSynthesizer(def->name());
+    }
+    return reg;
+}
+
+//! NOTE silences the previous job; the player of the next job sets the channels up again
+void OfflineRenderer::resetSynthesizers(const ISynthesizersRegisterPtr& synths) const
+{
+    for (const ISynthesizerPtr& synth : synths->synthesizers()) {
+        synth->flushSound();
+    }
+}
+
+//! NOTE the same pipeline as playback: the mixer moves the clock, the clock drives the player,
+//! the player schedules events to the synthesizers and the mixer renders them.
+//! The loop below pulls the blocks instead of the audio driver.
+Ret OfflineRenderer::renderJob(const std::shared_ptr<MidiStream>& stream, const Options& options, const Job& job,
+                               const ISynthesizersRegisterPtr& synths, unsigned int mixerThreads) const
+{
+    auto clock = std::make_shared<Clock>();
+
+    auto player = std::make_shared<MIDIPlayer>();
+    player->setsynthesizersRegister(synths);
+    player->setmidiPortDataSender(std::make_shared<NoMidiPortDataSender>());
+    player->setClock(clock);
+    player->loadMIDI(stream);
+
+    if (!job.tracks.empty()) {
+        for (const Track& track : stream->initData.tracks) {
+            if (job.tracks.find(track.num) == job.tracks.end()) {
+                player->setIsTrackMuted(track.num, true);
+            }
+        }
+    }
+
+    Clock* clockPtr = clock.get();
+    clock->addAfterCallback([clockPtr, player](Clock::time_t) {
+        player->forwardTime(clockPtr->timeInMiliSeconds());
+    });
+
+    auto mixer = std::make_shared<Mixer>();
+    mixer->setRenderThreadCount(mixerThreads);
+    mixer->setClock(clock);
+    mixer->setBufferSize(options.blockSize);
+    for (const ISynthesizerPtr& synth : synths->synthesizers()) {
+        mixer->addChannel(synth);
+    }
+    mixer->setSampleRate(options.sampleRate);
+
+    clock->start();
+    player->run();
+
+    const unsigned long maxTailFrames = static_cast<unsigned long>(options.sampleRate) * MAX_TAIL_MSEC / 1000;
+    unsigned long tailFrames = 0;
+    while (tailFrames < maxTailFrames) {
+        mixer->forward(options.blockSize);
+
+        if (!player->isRunning()) {
+            if (isSilent(mixer->data(), options.blockSize * mixer->streamCount())) {
+                break;
+            }
+            tailFrames += options.blockSize;
+        }
+
+        if (!job.writer(mixer->data(), options.blockSize)) {
+            return make_ret(Ret::Code::Cancel);
+        }
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
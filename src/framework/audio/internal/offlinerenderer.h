@@ -0,0 +1,47 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_OFFLINERENDERER_H
+#define MU_AUDIO_OFFLINERENDERER_H
+
+#include "iofflinerenderer.h"
+#include "modularity/ioc.h"
+#include "isynthesizersregister.h"
+#include "isoundfontsprovider.h"
+
+namespace mu::audio {
+class OfflineRenderer : public IOfflineRenderer
+{
+    INJECT(audio, synth::ISynthesizersRegister, synthesizersRegister)
+    INJECT(audio, synth::ISoundFontsProvider, soundFontsProvider)
+
+public:
+    Ret render(const std::shared_ptr<midi::MidiStream>& stream, const Options& options, const std::vector<Job>& jobs) override;
+
+private:
+    //! a player keeps sending note offs for this long after the end of the score
+    static constexpr unsigned int MAX_TAIL_MSEC = 3000;
+
+    synth::ISynthesizersRegisterPtr createSynthesizers(unsigned int sampleRate) const;
+    void resetSynthesizers(const synth::ISynthesizersRegisterPtr& synths) const;
+    Ret renderJob(const std::shared_ptr<midi::MidiStream>& stream, const Options& options, const Job& job,
+                  const synth::ISynthesizersRegisterPtr& synths, unsigned int mixerThreads) const;
+};
+}
+
+#endif // MU_AUDIO_OFFLINERENDERER_H
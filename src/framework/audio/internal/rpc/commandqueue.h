@@ -0,0 +1,113 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_AUDIO_COMMANDQUEUE_H
+#define MU_AUDIO_COMMANDQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace mu::audio::rpc {
+//! Bounded lock free queue with any number of producers and a single consumer.
+//! The cells are preallocated, push and pop neither allocate nor block;
+//! push fails when the queue is full.
+//! Each cell has a sequence number telling whether it is free for the producer
+//! that claimed its position or holds a value for the consumer.
+template<typename T, size_t Capacity>
+class CommandQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    CommandQueue()
+    {
+        for (size_t i = 0; i < Capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    //! any thread
+    bool push(const T& value)
+    {
+        size_t pos = m_pushPos.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        for (;;) {
+            cell = &m_cells[pos & MASK];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos);
+            if (diff == 0) {
+                if (m_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_pushPos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! the consumer thread only, the value stays in the queue
+    const T* peek() const
+    {
+        const Cell& cell = m_cells[m_popPos & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != m_popPos + 1) {
+            return nullptr;
+        }
+        return &cell.value;
+    }
+
+    //! the consumer thread only
+    bool pop(T& value)
+    {
+        Cell& cell = m_cells[m_popPos & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != m_popPos + 1) {
+            return false;
+        }
+
+        value = cell.value;
+        cell.sequence.store(m_popPos + Capacity, std::memory_order_release);
+        ++m_popPos;
+        return true;
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    //! NOTE a cache line per cell, producers writing neighbour cells don't share a line
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence { 0 };
+        T value;
+    };
+
+    std::array<Cell, Capacity> m_cells;
+    alignas(64) std::atomic<size_t> m_pushPos { 0 };
+    alignas(64) size_t m_popPos = 0;
+};
+}
+
+#endif // MU_AUDIO_COMMANDQUEUE_H
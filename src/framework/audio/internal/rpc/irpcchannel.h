@@ -35,6 +35,7 @@ public:
 
     using ListenID = int;
     using Handler = std::function<void (const Msg& msg)>;
+    using CommandHandler = std::function<void (const Command& cmd)>;
 
     virtual bool isSerialized() const = 0;
 
@@ -42,6 +43,11 @@ public:
 
     virtual ListenID listen(Handler h) = 0;
     virtual void unlisten(ListenID id) = 0;
+
+    //! from the main thread to the worker, the main thread is the only sender
+    virtual void sendCommand(const Command& cmd) = 0;
+    //! the worker's only command handler
+    virtual void listenCommands(CommandHandler h) = 0;
 };
 
 using IRpcChannelPtr = std::shared_ptr<IRpcChannel>;
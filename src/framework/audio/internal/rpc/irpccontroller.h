@@ -34,6 +34,7 @@ public:
     virtual void init(const IRpcChannelPtr& channel) = 0;
 
     virtual void handle(const Msg& msg) = 0;
+    virtual void handleCommand(const Command& cmd) = 0;
 };
 
 using IRpcControllerPtr = std::shared_ptr<IRpcController>;
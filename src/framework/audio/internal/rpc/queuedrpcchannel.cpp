@@ -31,16 +31,41 @@ void QueuedRpcChannel::send(const Msg& msg)
 {
     if (isWorkerThread()) {
         std::lock_guard<std::mutex> lock(m_workerTh.mutex);
-        m_workerTh.queue.push(msg);
+        m_workerTh.queue.push({ 0, msg, false, Command() });
 
         //! NOTE Calls the `process` method on the main thread
         m_mainThreadInvoker->invoke([this]() { process(); });
     } else {
         std::lock_guard<std::mutex> lock(m_mainTh.mutex);
-        m_mainTh.queue.push(msg);
+        m_mainTh.queue.push({ m_seq++, msg, false, Command() });
     }
 }
 
+void QueuedRpcChannel::sendCommand(const Command& cmd)
+{
+    IF_ASSERT_FAILED(!isWorkerThread()) {
+        return;
+    }
+
+    uint64_t seq = m_seq++;
+    if (m_commands.push({ seq, cmd })) {
+        return;
+    }
+
+    //! NOTE the worker is late by a full queue, a command must not be lost.
+    //! Warned once per queue size of overflowed commands
+    if (m_overflowedCommands++ % COMMAND_QUEUE_SIZE == 0) {
+        LOGW() << "command queue is full, " << m_overflowedCommands << " commands went through the message queue";
+    }
+    std::lock_guard<std::mutex> lock(m_mainTh.mutex);
+    m_mainTh.queue.push({ seq, Msg(), true, cmd });
+}
+
+void QueuedRpcChannel::listenCommands(CommandHandler h)
+{
+    m_commandHandler = h;
+}
+
 IRpcChannel::ListenID QueuedRpcChannel::listen(Handler h)
 {
     if (isWorkerThread()) {
@@ -85,7 +110,7 @@ void QueuedRpcChannel::setupMainThread()
 void QueuedRpcChannel::process()
 {
     if (isWorkerThread()) {
-        doProcess(m_mainTh, m_workerTh);
+        processWithCommands(m_mainTh, m_workerTh);
     } else {
         doProcess(m_workerTh, m_mainTh);
     }
@@ -104,10 +129,55 @@ void QueuedRpcChannel::doProcess(RpcData& from, RpcData& to)
     }
 
     while (!fromMQ.empty()) {
-        const Msg& m = fromMQ.front();
+        const Msg& m = fromMQ.front().msg;
         for (auto it = to.listens.begin(); it != to.listens.end(); ++it) {
             it->second(m);
         }
         fromMQ.pop();
     }
 }
+
+void QueuedRpcChannel::processWithCommands(RpcData& from, RpcData& to)
+{
+    //! NOTE messages are numbered under the lock, so all the messages numbered
+    //! below the snapshot are in the swapped queue. The commands numbered below
+    //! it are either in the command queue or, as fallbacks, in the swapped queue,
+    //! the ones sent later are left for the next round
+    MQ fromMQ;
+    uint64_t seqEnd = 0;
+    {
+        std::lock_guard<std::mutex> lock(from.mutex);
+        fromMQ.swap(from.queue);
+        seqEnd = m_seq.load();
+    }
+
+    auto nextCommand = [this, seqEnd]() {
+        const QueuedCommand* qc = m_commands.peek();
+        return qc && qc->seq < seqEnd ? qc : nullptr;
+    };
+
+    const QueuedCommand* qc = nextCommand();
+    while (qc || !fromMQ.empty()) {
+        if (qc && (fromMQ.empty() || qc->seq < fromMQ.front().seq)) {
+            QueuedCommand command;
+            m_commands.pop(command);
+            if (m_commandHandler) {
+                m_commandHandler(command.cmd);
+            }
+            qc = nextCommand();
+            continue;
+        }
+
+        const QueuedMsg& qm = fromMQ.front();
+        if (qm.isCommand) {
+            if (m_commandHandler) {
+                m_commandHandler(qm.cmd);
+            }
+        } else {
+            for (auto it = to.listens.begin(); it != to.listens.end(); ++it) {
+                it->second(qm.msg);
+            }
+        }
+        fromMQ.pop();
+    }
+}
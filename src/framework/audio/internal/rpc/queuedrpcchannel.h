@@ -19,12 +19,14 @@
 #ifndef MU_AUDIO_QUEUEDRPCCHANNEL_H
 #define MU_AUDIO_QUEUEDRPCCHANNEL_H
 
+#include <atomic>
 #include <thread>
 #include <mutex>
 #include <queue>
 #include <memory>
 
 #include "irpcchannel.h"
+#include "commandqueue.h"
 #include "invoker.h"
 
 namespace mu::audio::rpc {
@@ -39,6 +41,9 @@ public:
     ListenID listen(Handler h) override;
     void unlisten(ListenID id) override;
 
+    void sendCommand(const Command& cmd) override;
+    void listenCommands(CommandHandler h) override;
+
     bool isWorkerThread() const;
     void setupWorkerThread(); //! NOTE Must called from worker thread
 
@@ -48,7 +53,25 @@ public:
 
 private:
 
-    using MQ = std::queue<Msg>;
+    static constexpr size_t COMMAND_QUEUE_SIZE = 1024;
+
+    //! NOTE messages and commands are sent from the main thread only. They are
+    //! numbered as they are sent; when the worker takes the queued messages, it
+    //! also takes the number of the next one to be sent, and handles only the
+    //! commands numbered below it. So it handles both in the order they were sent
+    struct QueuedMsg {
+        uint64_t seq = 0;
+        Msg msg;
+        bool isCommand = false;     //! a command that didn't fit in the command queue
+        Command cmd;
+    };
+
+    struct QueuedCommand {
+        uint64_t seq = 0;
+        Command cmd;
+    };
+
+    using MQ = std::queue<QueuedMsg>;
 
     struct RpcData {
         std::mutex mutex;
@@ -58,11 +81,17 @@ private:
     };
 
     void doProcess(RpcData& from, RpcData& to);
+    void processWithCommands(RpcData& from, RpcData& to);
 
     std::shared_ptr<framework::Invoker> m_mainThreadInvoker;
     std::thread::id m_streamThreadID;
     RpcData m_workerTh;
     RpcData m_mainTh;
+
+    std::atomic<uint64_t> m_seq { 0 };
+    CommandQueue<QueuedCommand, COMMAND_QUEUE_SIZE> m_commands;
+    uint64_t m_overflowedCommands = 0;  //! main thread
+    CommandHandler m_commandHandler;
 };
 
 using QueuedRpcChannelPtr = std::shared_ptr<QueuedRpcChannel>;
@@ -36,6 +36,11 @@ void RpcControllerBase::handle(const Msg& msg)
     doCall(msg);
 }
 
+void RpcControllerBase::handleCommand(const Command& cmd)
+{
+    LOGE() << "not supported command: " << static_cast<int>(cmd.id);
+}
+
 bool RpcControllerBase::isSerialized() const
 {
     IF_ASSERT_FAILED(m_channel) {
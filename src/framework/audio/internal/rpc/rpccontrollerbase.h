@@ -33,6 +33,7 @@ public:
     void init(const IRpcChannelPtr& channel) override;
 
     void handle(const Msg& msg) override;
+    void handleCommand(const Command& cmd) override;
 
 protected:
 
@@ -49,6 +49,14 @@ void RpcControllers::init(const IRpcChannelPtr& channel)
                 }
             }
         });
+
+        m_channel->listenCommands([this](const Command& cmd) {
+            for (auto& cont : m_controllers) {
+                if (cont->target() == cmd.target.name) {
+                    cont->handleCommand(cmd);
+                }
+            }
+        });
     }
 }
 
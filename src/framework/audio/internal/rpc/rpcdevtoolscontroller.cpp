@@ -30,6 +30,30 @@ TargetName RpcDevToolsController::target() const
     return TargetName::DevTools;
 }
 
+void RpcDevToolsController::handleCommand(const Command& cmd)
+{
+    std::optional<unsigned int> channelId = cmd.arg(0) == SineChannel ? m_sineChannelId : m_noiseChannel;
+    if (!channelId) {
+        return;
+    }
+
+    auto channel = audioEngine()->mixer()->channel(channelId.value());
+    if (!channel) {
+        return;
+    }
+
+    switch (cmd.id) {
+    case CommandID::SetLevel:
+        channel->setLevel(cmd.value);
+        break;
+    case CommandID::SetBalance:
+        channel->setBalance(cmd.value);
+        break;
+    default:
+        RpcControllerBase::handleCommand(cmd);
+    }
+}
+
 AudioEngine* RpcDevToolsController::audioEngine() const
 {
     return AudioEngine::instance();
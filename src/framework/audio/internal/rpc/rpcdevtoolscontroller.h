@@ -31,6 +31,8 @@ public:
 
     TargetName target() const override;
 
+    void handleCommand(const Command& cmd) override;
+
 protected:
 
     void doBind() override;
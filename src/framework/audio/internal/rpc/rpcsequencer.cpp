@@ -122,37 +122,37 @@ void RpcSequencer::setAudioTrack(TrackID id, const std::shared_ptr<audio::IAudio
 
 void RpcSequencer::play()
 {
-    rpcChannel()->send(Msg(m_target, "play"));
+    rpcChannel()->sendCommand(Command(m_target, CommandID::Play));
 }
 
 void RpcSequencer::pause()
 {
-    rpcChannel()->send(Msg(m_target, "pause"));
+    rpcChannel()->sendCommand(Command(m_target, CommandID::Pause));
 }
 
 void RpcSequencer::stop()
 {
-    rpcChannel()->send(Msg(m_target, "stop"));
+    rpcChannel()->sendCommand(Command(m_target, CommandID::Stop));
 }
 
 void RpcSequencer::seek(uint64_t position)
 {
-    rpcChannel()->send(Msg(m_target, "seek", Args::make_arg1<uint64_t>(position)));
+    rpcChannel()->sendCommand(Command(m_target, CommandID::Seek, position));
 }
 
 void RpcSequencer::rewind()
 {
-    rpcChannel()->send(Msg(m_target, "rewind"));
+    rpcChannel()->sendCommand(Command(m_target, CommandID::Rewind));
 }
 
 void RpcSequencer::setLoop(uint64_t fromMilliseconds, uint64_t toMilliseconds)
 {
-    rpcChannel()->send(Msg(m_target, "setLoop", Args::make_arg2<uint64_t, uint64_t>(fromMilliseconds, toMilliseconds)));
+    rpcChannel()->sendCommand(Command(m_target, CommandID::SetLoop, fromMilliseconds, toMilliseconds));
 }
 
 void RpcSequencer::unsetLoop()
 {
-    rpcChannel()->send(Msg(m_target, "unsetLoop"));
+    rpcChannel()->sendCommand(Command(m_target, CommandID::UnsetLoop));
 }
 
 async::Channel<mu::midi::tick_t> RpcSequencer::midiTickPlayed(TrackID id) const
@@ -31,6 +31,35 @@ TargetName RpcSequencerController::target() const
     return TargetName::Sequencer;
 }
 
+void RpcSequencerController::handleCommand(const Command& cmd)
+{
+    switch (cmd.id) {
+    case CommandID::Play:
+        sequencer()->play();
+        break;
+    case CommandID::Pause:
+        sequencer()->pause();
+        break;
+    case CommandID::Stop:
+        sequencer()->stop();
+        break;
+    case CommandID::Seek:
+        sequencer()->seek(cmd.arg(0));
+        break;
+    case CommandID::Rewind:
+        sequencer()->rewind();
+        break;
+    case CommandID::SetLoop:
+        sequencer()->setLoop(cmd.arg(0), cmd.arg(1));
+        break;
+    case CommandID::UnsetLoop:
+        sequencer()->unsetLoop();
+        break;
+    default:
+        RpcControllerBase::handleCommand(cmd);
+    }
+}
+
 ISequencerPtr RpcSequencerController::sequencer() const
 {
     return AudioEngine::instance()->sequencer();
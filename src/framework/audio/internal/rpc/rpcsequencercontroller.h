@@ -28,6 +28,8 @@ class RpcSequencerController : public RpcControllerBase, public async::Asyncable
 public:
     TargetName target() const override;
 
+    void handleCommand(const Command& cmd) override;
+
 protected:
 
     void doBind() override;
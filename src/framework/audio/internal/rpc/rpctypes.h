@@ -19,6 +19,7 @@
 #ifndef MU_AUDIO_RPCTYPES_H
 #define MU_AUDIO_RPCTYPES_H
 
+#include <cstdint>
 #include <string>
 #include <map>
 #include <memory>
@@ -129,6 +130,48 @@ private:
     std::map<int, std::shared_ptr<IArg> > m_args;
 };
 
+//! NOTE Commands are the frequent calls of the main thread that must reach the audio worker
+//! without delay: transport, seek and level changes. Unlike a Msg they have a numeric id
+//! and an inline payload, so they are passed without allocation or lock (see QueuedRpcChannel).
+enum class CommandID : uint8_t {
+    Undefined = 0,
+    Play,
+    Pause,
+    Stop,
+    Seek,           // arg(0) - position, msec
+    Rewind,
+    SetLoop,        // arg(0), arg(1) - from, to, msec
+    UnsetLoop,
+    SetLevel,       // arg(0) - channel of the target, value - level
+    SetBalance      // arg(0) - channel of the target, value - balance
+};
+
+//! channels of the DevTools target
+enum DevToolsChannel {
+    SineChannel = 0,
+    NoiseChannel = 1
+};
+
+struct Command {
+    Target target;
+    CommandID id = CommandID::Undefined;
+    uint64_t args[2] = { 0, 0 };
+    float value = 0.f;
+
+    Command() = default;
+    Command(const Target& t, CommandID i, uint64_t arg0 = 0, uint64_t arg1 = 0)
+        : target(t), id(i), args{ arg0, arg1 } {}
+
+    static Command makeValue(const Target& t, CommandID i, uint64_t arg0, float value)
+    {
+        Command c(t, i, arg0);
+        c.value = value;
+        return c;
+    }
+
+    uint64_t arg(int i) const { return args[i]; }
+};
+
 struct Msg {
     Target target;
     Method method;
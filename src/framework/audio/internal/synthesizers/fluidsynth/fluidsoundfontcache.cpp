@@ -0,0 +1,208 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "fluidsoundfontcache.h"
+
+#include <algorithm>
+
+extern "C" {
+#include "fluid_sfont.h"
+#include "fluid_defsfont.h"
+}
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::audio::synth;
+
+FluidSoundFontCache::Font::~Font()
+{
+    FluidSoundFontCache::instance()->freeSfont(m_sfont);
+}
+
+FluidSoundFontCache* FluidSoundFontCache::instance()
+{
+    static FluidSoundFontCache cache;
+    return &cache;
+}
+
+FluidSoundFontCache::~FluidSoundFontCache()
+{
+    if (m_preloadThread.joinable()) {
+        m_preloadThread.join();
+    }
+
+    m_preloaded.clear();
+
+    std::lock_guard<std::mutex> lock(m_sfontMutex);
+    freeReleasedSfonts();
+    if (!m_releasedSfonts.empty()) {
+        LOGW() << "soundfont samples still in use at exit, not freed";
+    }
+
+    if (m_loader) {
+        fluid_sfloader_delete(m_loader);
+        delete_fluid_settings(m_settings);
+    }
+}
+
+void FluidSoundFontCache::preload(const std::vector<io::path>& paths)
+{
+    if (m_preloadThread.joinable()) {
+        m_preloadThread.join();
+    }
+
+    m_preloadThread = std::thread(&FluidSoundFontCache::runPreload, this, paths);
+}
+
+framework::ProgressChannel FluidSoundFontCache::preloadProgress() const
+{
+    return m_preloadProgress;
+}
+
+void FluidSoundFontCache::runPreload(const std::vector<io::path>& paths)
+{
+    std::vector<FontPtr> fonts;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        m_preloadProgress.send(framework::Progress(i, paths.size(), paths[i].toStdString()));
+        if (FontPtr f = font(paths[i])) {
+            fonts.push_back(f);
+        }
+    }
+    m_preloadProgress.send(framework::Progress(paths.size(), paths.size()));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_preloaded = std::move(fonts);
+}
+
+FluidSoundFontCache::FontPtr FluidSoundFontCache::font(const io::path& path)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Entry& entry = m_fonts[path.toStdString()];
+    m_loaded.wait(lock, [&entry]() { return !entry.loading; });
+
+    if (FontPtr f = entry.font.lock()) {
+        return f;
+    }
+
+    entry.loading = true;
+    lock.unlock();
+
+    FontPtr f = load(path);
+
+    lock.lock();
+    entry.loading = false;
+    entry.font = f;
+    m_loaded.notify_all();
+
+    return f;
+}
+
+FluidSoundFontCache::FontPtr FluidSoundFontCache::load(const io::path& path)
+{
+    fluid_sfont_t* sfont = loadSfont(path);
+    if (!sfont) {
+        LOGE() << "failed load soundfont: " << path;
+        return nullptr;
+    }
+
+    auto f = std::make_shared<Font>();
+    f->m_sfont = sfont;
+
+    LOGI() << "soundfont loaded: " << path;
+    return f;
+}
+
+fluid_sfont_t* FluidSoundFontCache::loadInstanceFont(const io::path& path)
+{
+    FontPtr f = font(path);
+    if (!f) {
+        return nullptr;
+    }
+
+    fluid_sfont_t* sfont = loadSfont(path);
+    if (!sfont) {
+        return nullptr;
+    }
+
+    //! NOTE the instance frees its font through the cache, to lock the sample cache
+    //! and to release the cached font with it
+    sfont->free = &FluidSoundFontCache::freeInstanceFont;
+
+    std::lock_guard<std::mutex> lock(m_sfontMutex);
+    m_instanceFonts[sfont] = f;
+    return sfont;
+}
+
+fluid_sfont_t* FluidSoundFontCache::loadSfont(const io::path& path)
+{
+    std::lock_guard<std::mutex> lock(m_sfontMutex);
+    freeReleasedSfonts();
+
+    if (!m_loader) {
+        m_settings = new_fluid_settings();
+        fluid_settings_setint(m_settings, "synth.lock-memory", 0);
+        fluid_settings_setint(m_settings, "synth.dynamic-sample-loading", 0);
+        m_loader = new_fluid_defsfloader(m_settings);
+    }
+
+    //! NOTE the sample data is read from the sample cache if a font of the same file holds it
+    return fluid_sfloader_load(m_loader, path.c_str());
+}
+
+void FluidSoundFontCache::freeSfont(fluid_sfont_t* sfont)
+{
+    if (!sfont) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_sfontMutex);
+    m_releasedSfonts.push_back(sfont);
+    freeReleasedSfonts();
+}
+
+//! NOTE FluidSynth refuses to free the samples of a font while a voice plays them,
+//! the font is then freed on a later load or free
+void FluidSoundFontCache::freeReleasedSfonts()
+{
+    auto freed = std::remove_if(m_releasedSfonts.begin(), m_releasedSfonts.end(), [](fluid_sfont_t* sfont) {
+        return fluid_defsfont_sfont_delete(sfont) == FLUID_OK;
+    });
+    m_releasedSfonts.erase(freed, m_releasedSfonts.end());
+}
+
+int FluidSoundFontCache::freeInstanceFont(fluid_sfont_t* sfont)
+{
+    FluidSoundFontCache* cache = instance();
+
+    FontPtr f;
+    {
+        std::lock_guard<std::mutex> lock(cache->m_sfontMutex);
+        auto it = cache->m_instanceFonts.find(sfont);
+        if (it != cache->m_instanceFonts.end()) {
+            f = it->second;
+            cache->m_instanceFonts.erase(it);
+        }
+        cache->m_releasedSfonts.push_back(sfont);
+        cache->freeReleasedSfonts();
+    }
+
+    //! the instance's font is gone for FluidSynth, even if its samples are freed later
+    return FLUID_OK;
+}
@@ -0,0 +1,110 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_AUDIO_FLUIDSOUNDFONTCACHE_H
+#define MU_AUDIO_FLUIDSOUNDFONTCACHE_H
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fluidsynth.h>
+
+#include "io/path.h"
+#include "global/progress.h"
+
+namespace mu::audio::synth {
+//! Soundfonts of FluidSynth, shared by all its instances.
+//! Each instance loads a font of its own: presets, zones and samples, whose reference
+//! counts FluidSynth changes while it plays, on the thread the instance renders on.
+//! Only the sample data is shared: it is read (and SF3 decoded) once per process, into
+//! FluidSynth's sample cache, and kept there while the cache or an instance holds the font.
+class FluidSoundFontCache
+{
+public:
+    class Font
+    {
+    public:
+        ~Font();
+
+        //! the cache's own load of the font, it keeps the sample data; no instance plays it
+        fluid_sfont_t* sfont() const { return m_sfont; }
+
+    private:
+        friend class FluidSoundFontCache;
+
+        fluid_sfont_t* m_sfont = nullptr;
+    };
+
+    using FontPtr = std::shared_ptr<const Font>;
+
+    static FluidSoundFontCache* instance();
+
+    //! loads the fonts on a background thread; they stay cached until the next preload,
+    //! even if no instance uses them yet
+    void preload(const std::vector<io::path>& paths);
+    framework::ProgressChannel preloadProgress() const;
+
+    //! returns the cached font, waits for it if it is being loaded
+    //! and loads it on the calling thread if nobody did yet
+    FontPtr font(const io::path& path);
+
+    //! the loader of the instances: a font of their own, on the sample data of the cached font.
+    //! The instance holds the cached font until it frees its own
+    fluid_sfont_t* loadInstanceFont(const io::path& path);
+
+private:
+    FluidSoundFontCache() = default;
+    ~FluidSoundFontCache();
+
+    FontPtr load(const io::path& path);
+    fluid_sfont_t* loadSfont(const io::path& path);
+    void freeSfont(fluid_sfont_t* sfont);
+    void freeReleasedSfonts();
+    static int freeInstanceFont(fluid_sfont_t* sfont);
+    void runPreload(const std::vector<io::path>& paths);
+
+    struct Entry {
+        std::weak_ptr<const Font> font;
+        bool loading = false;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_loaded;
+    std::map<std::string, Entry> m_fonts;
+    std::vector<FontPtr> m_preloaded;
+
+    //! NOTE FluidSynth is built without threads, its sample cache is not locked:
+    //! the fonts are loaded and freed under this mutex
+    std::mutex m_sfontMutex;
+    fluid_settings_t* m_settings = nullptr;
+    fluid_sfloader_t* m_loader = nullptr;
+    std::map<fluid_sfont_t*, FontPtr> m_instanceFonts;
+    std::vector<fluid_sfont_t*> m_releasedSfonts;     //! their samples were still played when freed
+
+    std::thread m_preloadThread;
+    framework::ProgressChannel m_preloadProgress;
+};
+}
+
+#endif // MU_AUDIO_FLUIDSOUNDFONTCACHE_H
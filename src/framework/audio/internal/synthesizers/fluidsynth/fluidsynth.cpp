@@ -28,8 +28,10 @@
 
 #include "log.h"
 #include "audioerrors.h"
+#include "fluidsoundfontcache.h"
 
 static const double FLUID_GLOBAL_VOLUME_GAIN{ 1.8 };
+static const int FLUSH_FRAMES{ 128 }; // rendering a block stops the voices turned off
 
 using namespace mu;
 using namespace mu::midi;
@@ -46,6 +48,13 @@ struct mu::audio::synth::Fluid {
     }
 };
 
+namespace {
+fluid_sfont_t* loadInstanceFont(fluid_sfloader_t*, const char* filename)
+{
+    return FluidSoundFontCache::instance()->loadInstanceFont(io::path(filename));
+}
+}
+
 FluidSynth::FluidSynth()
 {
     m_fluid = std::make_shared<Fluid>();
@@ -134,6 +143,9 @@ Ret FluidSynth::init()
 
     m_fluid->synth = new_fluid_synth(m_fluid->settings);
 
+    //! NOTE soundfonts are loaded through the process wide cache, the default loader stays as the fallback
+    fluid_synth_add_sfloader(m_fluid->synth, new_fluid_sfloader(loadInstanceFont, delete_fluid_sfloader));
+
     LOGD() << "synth inited\n";
     return true;
 }
@@ -182,6 +194,12 @@ Ret FluidSynth::removeSoundFonts()
         return make_ret(Err::NoError);
     }
 
+    //! NOTE the font can only be freed once no voice plays its samples
+    fluid_synth_all_sounds_off(m_fluid->synth, -1);
+    if (!m_preallocated.empty()) {
+        fluid_synth_write_float(m_fluid->synth, FLUSH_FRAMES, &m_preallocated[0], 0, 1, &m_preallocated[0], FLUSH_FRAMES, 1);
+    }
+
     bool ok = true;
     for (const SoundFont& sf : m_soundFonts) {
         int ret = fluid_synth_sfunload(m_fluid->synth, sf.id, true);
@@ -272,12 +290,18 @@ bool FluidSynth::handleEvent(const Event& e)
     return ret == FLUID_OK;
 }
 
+void FluidSynth::scheduleEvent(const Event& e, unsigned int sampleOffset)
+{
+    m_events.push(e, sampleOffset);
+}
+
 void FluidSynth::allSoundsOff()
 {
     IF_ASSERT_FAILED(m_fluid->synth) {
         return;
     }
 
+    m_events.clear();
     fluid_synth_all_notes_off(m_fluid->synth, -1);
     fluid_synth_all_sounds_off(m_fluid->synth, -1);
 }
@@ -288,6 +312,7 @@ void FluidSynth::flushSound()
         return;
     }
 
+    m_events.clear();
     fluid_synth_all_notes_off(m_fluid->synth, -1);
     fluid_synth_all_sounds_off(m_fluid->synth, -1);
 
@@ -367,9 +392,18 @@ void FluidSynth::writeBuf(float* stream, unsigned int samples)
         return;
     }
 
-    fluid_synth_write_float(m_fluid->synth, static_cast<int>(samples),
-                            stream, 0, AUDIO_CHANNELS,
-                            stream, 1, AUDIO_CHANNELS);
+    //! NOTE FluidSynth renders in blocks of FLUID_BUFSIZE (64) frames of its own timeline
+    //! and keeps the rest of a block for the next write. An event handled between two
+    //! writes therefore takes effect on the next 64 frame boundary of that timeline:
+    //! up to 63 frames late, but the same whatever the block size of the host
+    m_events.process(samples, [this, stream](unsigned int from, unsigned int count) {
+        float* out = stream + from * AUDIO_CHANNELS;
+        fluid_synth_write_float(m_fluid->synth, static_cast<int>(count),
+                                out, 0, AUDIO_CHANNELS,
+                                out, 1, AUDIO_CHANNELS);
+    }, [this](const Event& e) {
+        handleEvent(e);
+    });
 }
 
 unsigned int FluidSynth::streamCount() const
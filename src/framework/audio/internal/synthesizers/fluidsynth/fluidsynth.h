@@ -26,6 +26,7 @@
 #include <functional>
 
 #include "isynthesizer.h"
+#include "internal/synthesizers/timedeventqueue.h"
 
 namespace mu::audio::synth {
 struct Fluid;
@@ -49,6 +50,7 @@ public:
 
     Ret setupChannels(const std::vector<midi::Event>& events) override;
     bool handleEvent(const midi::Event& e) override;
+    void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) override;
     void writeBuf(float* stream, unsigned int samples) override;
 
     void allSoundsOff() override; // all channels
@@ -85,6 +87,7 @@ private:
 
     bool m_isLoggingSynthEvents = false;
 
+    TimedEventQueue m_events;
     std::vector<float> m_preallocated; // used to flush a sound
     bool m_isActive = false;
 
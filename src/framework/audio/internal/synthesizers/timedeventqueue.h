@@ -0,0 +1,81 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_TIMEDEVENTQUEUE_H
+#define MU_AUDIO_TIMEDEVENTQUEUE_H
+
+#include <algorithm>
+#include <vector>
+
+#include "midi/miditypes.h"
+
+namespace mu::audio::synth {
+//! Events a synthesizer is to handle at a sample offset into the next block it renders.
+//! process() splits the block at the offsets, so an event takes effect on the sample it
+//! was stamped with, whatever the block size.
+class TimedEventQueue
+{
+public:
+    TimedEventQueue()
+    {
+        m_events.reserve(256);
+    }
+
+    bool empty() const { return m_events.empty(); }
+    void clear() { m_events.clear(); }
+
+    void push(const midi::Event& e, unsigned int sampleOffset)
+    {
+        //! NOTE keeps events with the same offset in the order they came
+        auto pos = std::upper_bound(m_events.begin(), m_events.end(), sampleOffset,
+                                    [](unsigned int offset, const TimedEvent& te) { return offset < te.offset; });
+        m_events.insert(pos, { sampleOffset, e });
+    }
+
+    //! render(from, count) renders the parts of the block between the events, handle(e) is
+    //! called for each event at its offset; events past the block end are handled at its end
+    template<typename Render, typename Handle>
+    void process(unsigned int samples, Render render, Handle handle)
+    {
+        unsigned int pos = 0;
+        for (const TimedEvent& te : m_events) {
+            unsigned int offset = std::min(te.offset, samples);
+            if (offset > pos) {
+                render(pos, offset - pos);
+                pos = offset;
+            }
+            handle(te.event);
+        }
+        m_events.clear();
+
+        if (pos < samples) {
+            render(pos, samples - pos);
+        }
+    }
+
+private:
+    struct TimedEvent {
+        unsigned int offset = 0;
+        midi::Event event;
+    };
+
+    std::vector<TimedEvent> m_events;
+};
+}
+
+#endif // MU_AUDIO_TIMEDEVENTQUEUE_H
@@ -127,6 +127,16 @@ sf_count_t AudioFile::readData(short* data, sf_count_t frames)
     return resFrames;
 }
 
+//---------------------------------------------------------
+//   seekFrame
+//    position the decoder at frame for the next readData()
+//---------------------------------------------------------
+
+sf_count_t AudioFile::seekFrame(sf_count_t frame)
+{
+    return sf_seek(sf, frame, SEEK_SET);
+}
+
 //---------------------------------------------------------
 //   seek
 //---------------------------------------------------------
@@ -154,7 +164,7 @@ sf_count_t AudioFile::seek(sf_count_t offset, int whence)
 sf_count_t AudioFile::read(void* ptr, sf_count_t count)
 {
     count = qMin(count, (sf_count_t)(buf.size() - idx));
-    memcpy(ptr, buf.data() + idx, count);
+    memcpy(ptr, buf.constData() + idx, count);
     idx += count;
     return count;
 }
@@ -43,6 +43,7 @@ public:
     bool open(const QByteArray&);
     const char* error() const;
     sf_count_t readData(short* data, sf_count_t frames);
+    sf_count_t seekFrame(sf_count_t frame);
 
     int channels() const { return info.channels; }
     sf_count_t frames() const { return info.frames; }
@@ -15,6 +15,7 @@
 #ifndef _USE_MATH_DEFINES
 #define _USE_MATH_DEFINES
 #endif
+#include <algorithm>
 #include <cmath>
 
 #include "channel.h"
@@ -41,6 +42,7 @@ Channel::Channel(Zerberus* ms, int i)
     _panLeftGain  = cosf(static_cast<float>(M_PI_2 * 64.0 / 126.0));
     _panRightGain = sinf(static_cast<float>(M_PI_2 * 64.0 / 126.0));
     memset(ctrl, 0, 128 * sizeof(char));
+    std::fill(std::begin(_keyVoices), std::end(_keyVoices), nullptr);
     ctrl[CTRL_EXPRESSION] = 127;
 }
 
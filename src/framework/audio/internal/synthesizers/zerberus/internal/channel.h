@@ -14,6 +14,7 @@
 #define MU_ZERBERUS_MCHANNEL_H
 
 namespace mu::zerberus {
+class Voice;
 class Zerberus;
 class ZInstrument;
 
@@ -30,6 +31,7 @@ class Channel
     float _panRightGain;
     float _midiVolume;
     char ctrl[128];
+    Voice* _keyVoices[128];   // active voices by key, linked by Voice::keyNext()
 
     int _idx;                 // channel index
 #if 0 // yet (?) unused
@@ -50,6 +52,7 @@ public:
     float panRightGain() const { return _panRightGain; }
     int idx() const { return _idx; }
     int getCtrl(int CTRL) const;
+    Voice*& keyVoices(int key) { return _keyVoices[key]; }
     void resetCC();
 };
 }
@@ -20,6 +20,7 @@
 #endif
 #include <cmath>
 
+#include <algorithm>
 #include <functional>
 
 #include "zerberus.h"
@@ -285,6 +286,89 @@ float ZFilter::apply(float inputValue, bool leftChannel)
     return value;
 }
 
+//---------------------------------------------------------
+//   applyBlock
+//    filter frames values of the left and, for stereo
+//    samples, the right channel in place. Gives the same
+//    result as calling apply() for left and right frame by
+//    frame: while the coefficients are still moving to new
+//    values it does just that, afterwards each channel is
+//    filtered in one loop.
+//---------------------------------------------------------
+
+void ZFilter::applyBlock(float* left, float* right, int frames)
+{
+    int i = 0;
+    for (; i < frames && filter_coeff_incr_count; ++i) {
+        left[i] = apply(left[i], true);
+        if (right) {
+            right[i] = apply(right[i], false);
+        }
+    }
+    if (i < frames) {
+        applyConstant(left + i, frames - i, monoL);
+        if (right) {
+            applyConstant(right + i, frames - i, monoR);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   applyConstant
+//    apply() without coefficient changes and with the
+//    filter type switch moved out of the loop
+//---------------------------------------------------------
+
+void ZFilter::applyConstant(float* values, int frames, FilterData& d) const
+{
+    switch (sampleZone->fil_type) {
+    case FilterType::hpf_2p:
+    case FilterType::lpf_2p:
+    case FilterType::bpf_2p:
+    case FilterType::brf_2p:
+        for (int i = 0; i < frames; ++i) {
+            const float x = values[i];
+            const float y = b0 * x + b1 * d.histX1 + b2 * d.histX2 + a1 * d.histY1 + a2 * d.histY2;
+            d.histX2 = d.histX1;
+            d.histX1 = x;
+            d.histY2 = d.histY1;
+            d.histY1 = y;
+            values[i] = y;
+        }
+        break;
+    case FilterType::hpf_1p:
+        for (int i = 0; i < frames; ++i) {
+            const float x = values[i];
+            const float y = b0 * x + b1 * d.histX1 - a1 * d.histY1;
+            d.histX1 = x;
+            d.histY1 = y;
+            values[i] = y;
+        }
+        break;
+    case FilterType::lpf_1p:
+        for (int i = 0; i < frames; ++i) {
+            const float y = b0 * values[i] - a1 * d.histY1;
+            d.histY1 = y;
+            values[i] = y;
+        }
+        break;
+    default:
+        qWarning() << "this equation is not implemented" << (int)sampleZone->fil_type;
+        std::fill(values, values + frames, 0.f);
+    }
+}
+
+//---------------------------------------------------------
+//   interpolationCoefficients
+//    the four weights interpolate() uses for phase; they
+//    include the conversion of short samples to float
+//---------------------------------------------------------
+
+const float* ZFilter::interpolationCoefficients(unsigned phase)
+{
+    return interpCoeff[phase];
+}
+
 //---------------------------------------------------------
 //   interpolate
 //---------------------------------------------------------
@@ -31,7 +31,9 @@ public:
 
     void update();
     float apply(float inputValue, bool leftChannel);
+    void applyBlock(float* left, float* right, int frames);
     float interpolate(unsigned phase, short prevVal, short currVal, short nextVal, short nextNextVal) const;   //pure function
+    static const float* interpolationCoefficients(unsigned phase);
 
 private:
     const Zerberus* zerberus;
@@ -58,6 +60,8 @@ private:
     FilterData monoL;
     FilterData monoR;
 
+    void applyConstant(float* values, int frames, FilterData& d) const;
+
     // normalized filter coefficients (bX = bX/a0 and aX = aX/a0)
     // see Robert Bristow-Johnson's 'Cookbook formulae for audio EQ biquad filter coefficients'
     float b0 = 0.f;                // b0 / a0
@@ -12,6 +12,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <memory>
 #include <QFile>
 #include <QFileInfo>
 #include <QStringList>
@@ -23,6 +24,7 @@
 #include "instrument.h"
 #include "zone.h"
 #include "sample.h"
+#include "samplestream.h"
 
 #include "framework/global/xmlreader.h"
 
@@ -38,15 +40,66 @@ int ZInstrument::idx;
 
 Sample::~Sample()
 {
+    delete _stream;
     delete[] _data;
 }
 
+//---------------------------------------------------------
+//   readStreamedSample
+//    read the first SampleStream::preloadTime() ms of the
+//    sample, the rest is streamed while it plays. Samples
+//    not much longer than that are read completely.
+//---------------------------------------------------------
+
+static Sample* readStreamedSample(const QString& path)
+{
+    std::unique_ptr<SampleStream> stream(new SampleStream(path));
+    if (!stream->open()) {
+        return 0;
+    }
+    AudioFile& a = stream->audio();
+    int channel      = a.channels();
+    long long frames = a.frames();
+    int sr           = a.samplerate();
+
+    long long preload = (long long)(SampleStream::preloadTime()) * sr / 1000;
+    bool streamed     = frames > preload + SampleStream::BLOCK_FRAMES;
+    long long resident = streamed ? preload : frames;
+
+    short* data = new short[(resident + 3) * channel];
+    Sample* sa  = new Sample(channel, data, frames, sr);
+    sa->setLoopStart(a.loopStart());
+    sa->setLoopEnd(a.loopEnd());
+    sa->setLoopMode(a.loopMode());
+
+    if (resident != a.readData(data + channel, resident)) {
+        qDebug("Sample read failed: %s\n", a.error());
+        delete sa;
+        return 0;
+    }
+    for (int i = 0; i < channel; ++i) {
+        data[i] = data[channel + i];
+        if (!streamed) {
+            data[(frames - 1) * channel + i] = data[(frames - 3) * channel + i];
+            data[(frames - 2) * channel + i] = data[(frames - 3) * channel + i];
+        }
+    }
+    if (streamed) {
+        stream->start(resident);
+        sa->setStream(stream.release(), resident);
+    }
+    return sa;
+}
+
 //---------------------------------------------------------
 //   readSample
 //---------------------------------------------------------
 
 Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
 {
+    if (!uz && SampleStream::preloadTime() > 0) {
+        return readStreamedSample(s);
+    }
     if (uz) {
         QVector<MQZipReader::FileInfo> fi = uz->fileInfoList();
 
@@ -118,6 +171,47 @@ ZInstrument::~ZInstrument()
     }
 }
 
+//---------------------------------------------------------
+//   addZone
+//    also enter the zone into the index used by zones()
+//---------------------------------------------------------
+
+void ZInstrument::addZone(Zone* z)
+{
+    _zones.push_back(z);
+    if (z->trigger == Trigger::CC) {
+        _ccZones.push_back(z);
+        return;
+    }
+    const int bandWidth = 128 / VELOCITY_BANDS;
+    const int firstBand = qBound(0, z->veloLo / bandWidth, VELOCITY_BANDS - 1);
+    const int lastBand  = qBound(0, z->veloHi / bandWidth, VELOCITY_BANDS - 1);
+    for (int key = qMax(0, int(z->keyLo)); key <= qMin(127, int(z->keyHi)); ++key) {
+        for (int band = firstBand; band <= lastBand; ++band) {
+            _keyZones[int(z->trigger)][key][band].push_back(z);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   zones
+//    the zones that can match a key and velocity for the
+//    trigger, in the order they were added; Zone::match()
+//    still has to be checked
+//---------------------------------------------------------
+
+const std::vector<Zone*>& ZInstrument::zones(Trigger trigger, int key, int velo) const
+{
+    static const std::vector<Zone*> noZones;
+    if (trigger == Trigger::CC) {
+        return _ccZones;
+    }
+    if (key < 0 || key > 127 || velo < 0 || velo > 127) {
+        return noZones;
+    }
+    return _keyZones[int(trigger)][key][velo / (128 / VELOCITY_BANDS)];
+}
+
 //---------------------------------------------------------
 //   load
 //    return true on success
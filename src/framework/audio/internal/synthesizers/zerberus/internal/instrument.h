@@ -14,13 +14,15 @@
 #define MU_ZERBERUS_MINSTRUMENT_H
 
 #include <list>
+#include <vector>
 #include <QString>
 
+#include "zone.h"
+
 class MQZipReader;
 
 namespace mu::zerberus {
 class Zerberus;
-struct Zone;
 struct SfzRegion;
 class Sample;
 
@@ -30,12 +32,17 @@ class Sample;
 
 class ZInstrument
 {
+    static const int KEY_TRIGGERS   = int(Trigger::CC);      // triggers that depend on key and velocity
+    static const int VELOCITY_BANDS = 8;
+
     Zerberus* zerberus;
     int _refCount;
     QString _name;
     int _program;
     QString instrumentPath;
     std::list<Zone*> _zones;
+    std::vector<Zone*> _keyZones[KEY_TRIGGERS][128][VELOCITY_BANDS];   // zones whose key and velocity range include the band
+    std::vector<Zone*> _ccZones;
     int _setcc[128];
 
     bool loadFromFile(const QString&);
@@ -55,8 +62,9 @@ public:
     QString path() const { return instrumentPath; }
     const std::list<Zone*>& zones() const { return _zones; }
     std::list<Zone*>& zones() { return _zones; }
+    const std::vector<Zone*>& zones(Trigger, int key, int velo) const;
     Sample* readSample(const QString& s, MQZipReader* uz);
-    void addZone(Zone* z) { _zones.push_back(z); }
+    void addZone(Zone* z);
     void addRegion(SfzRegion&);
     int getSetCC(int v) { return _setcc[v]; }
 
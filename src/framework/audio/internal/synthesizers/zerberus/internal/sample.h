@@ -16,8 +16,13 @@
 #include <QString>
 
 namespace mu::zerberus {
+class SampleStream;
+
 //---------------------------------------------------------
 //   Sample
+//    data() holds the first residentFrames() frames; with
+//    a stream, the frames after that are read from disk
+//    while the sample plays
 //---------------------------------------------------------
 
 class Sample
@@ -29,13 +34,18 @@ class Sample
     long long _loopStart { 0 };
     long long _loopEnd   { 0 };
     int _loopMode     { 0 };
+    long long _residentFrames { 0 };
+    SampleStream* _stream { nullptr };
 
 public:
-    Sample(int ch, short* val, int f, int sr)
-        : _channel(ch), _data(val), _frames(f), _sampleRate(sr) {}
+    Sample(int ch, short* val, long long f, int sr)
+        : _channel(ch), _data(val), _frames(f), _sampleRate(sr), _residentFrames(f) {}
     ~Sample();
     bool read(const QString&);
     long long frames() const { return _frames; }
+    long long residentFrames() const { return _residentFrames; }
+    SampleStream* stream() const { return _stream; }
+    void setStream(SampleStream* s, long long residentFrames) { _stream = s; _residentFrames = residentFrames; }
     short* data() const { return _data + _channel; }
     int channel() const { return _channel; }
     int sampleRate() const { return _sampleRate; }
@@ -0,0 +1,431 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2013 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "samplestream.h"
+
+using namespace mu::zerberus;
+
+std::atomic<int> SampleStream::_preloadTime { 0 };
+std::atomic<int> SampleStream::_idleTime { 2000 };
+std::atomic<unsigned long long> SampleStream::_underruns { 0 };
+
+//---------------------------------------------------------
+//   msecs
+//---------------------------------------------------------
+
+static long long msecs()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+namespace mu::zerberus {
+//---------------------------------------------------------
+//   SampleReader
+//    background thread decoding the blocks voices asked
+//    for. It sleeps until a voice requests a block and,
+//    while decoded blocks are held, wakes up every
+//    EVICT_INTERVAL_MS to free the unused ones.
+//
+//    The audio thread must not block on _mutex, so wake()
+//    only notifies if it gets the mutex with try_lock().
+//    If it does not, the reader is awake and sees _work
+//    before it waits again, or add()/remove() hold the
+//    mutex and notify for it when they are done.
+//---------------------------------------------------------
+
+class SampleReader
+{
+public:
+    static constexpr int EVICT_INTERVAL_MS = 250;
+
+private:
+    struct OpenFile {
+        SampleStream* stream;
+        std::unique_ptr<SampleFile> file;
+    };
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<SampleStream*> _streams;
+    std::list<OpenFile> _files;                 // most recently read first
+    std::atomic<int> _openFiles { 0 };
+    std::atomic<bool> _work { false };
+    std::thread _thread;
+    bool _quit { false };
+
+    void run();
+    bool holdsBlocks() const;
+    SampleFile* file(SampleStream*);
+    void keep(SampleStream*, std::unique_ptr<SampleFile>);
+
+public:
+    ~SampleReader();
+
+    static SampleReader* instance();
+    void add(SampleStream*, std::unique_ptr<SampleFile>);
+    void remove(SampleStream*);
+    void wake();
+    int openFiles() const { return _openFiles; }
+};
+
+//---------------------------------------------------------
+//   instance
+//---------------------------------------------------------
+
+SampleReader* SampleReader::instance()
+{
+    static SampleReader reader;
+    return &reader;
+}
+
+//---------------------------------------------------------
+//   ~SampleReader
+//---------------------------------------------------------
+
+SampleReader::~SampleReader()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _condition.notify_one();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+//---------------------------------------------------------
+//   add
+//    file is the opened sample file of the stream
+//---------------------------------------------------------
+
+void SampleReader::add(SampleStream* s, std::unique_ptr<SampleFile> file)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _streams.push_back(s);
+        keep(s, std::move(file));
+        if (!_thread.joinable()) {
+            _thread = std::thread(&SampleReader::run, this);
+        }
+    }
+    if (_work) {
+        _condition.notify_one();
+    }
+}
+
+//---------------------------------------------------------
+//   remove
+//    the stream is not in use by the reader thread
+//    anymore on return
+//---------------------------------------------------------
+
+void SampleReader::remove(SampleStream* s)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _streams.erase(std::remove(_streams.begin(), _streams.end(), s), _streams.end());
+        _files.remove_if([s](const OpenFile& f) { return f.stream == s; });
+        _openFiles = int(_files.size());
+    }
+    if (_work) {
+        _condition.notify_one();
+    }
+}
+
+//---------------------------------------------------------
+//   wake
+//    audio thread
+//---------------------------------------------------------
+
+void SampleReader::wake()
+{
+    if (_work.exchange(true)) {
+        return;
+    }
+    if (_mutex.try_lock()) {
+        _mutex.unlock();
+        _condition.notify_one();
+    }
+}
+
+//---------------------------------------------------------
+//   keep
+//    make file the most recently read one and close the
+//    least recently read file if too many are open
+//---------------------------------------------------------
+
+void SampleReader::keep(SampleStream* s, std::unique_ptr<SampleFile> file)
+{
+    _files.push_front({ s, std::move(file) });
+    if (int(_files.size()) > SampleStream::MAX_OPEN_FILES) {
+        _files.pop_back();
+    }
+    _openFiles = int(_files.size());
+}
+
+//---------------------------------------------------------
+//   file
+//    the opened sample file of s, reopened if it was
+//    closed in the meantime; nullptr if that fails
+//---------------------------------------------------------
+
+SampleFile* SampleReader::file(SampleStream* s)
+{
+    auto i = std::find_if(_files.begin(), _files.end(), [s](const OpenFile& f) { return f.stream == s; });
+    if (i != _files.end()) {
+        _files.splice(_files.begin(), _files, i);
+        return _files.front().file.get();
+    }
+    std::unique_ptr<SampleFile> f(new SampleFile(s->_path));
+    if (!f->open()) {
+        return nullptr;
+    }
+    SampleFile* p = f.get();
+    keep(s, std::move(f));
+    return p;
+}
+
+//---------------------------------------------------------
+//   holdsBlocks
+//---------------------------------------------------------
+
+bool SampleReader::holdsBlocks() const
+{
+    return std::any_of(_streams.begin(), _streams.end(), [](const SampleStream* s) { return s->_decodedBlocks > 0; });
+}
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+void SampleReader::run()
+{
+    long long nextEviction = msecs() + EVICT_INTERVAL_MS;
+    auto hasWork = [this]() { return _quit || _work; };
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_quit) {
+        if (holdsBlocks()) {
+            _condition.wait_for(lock, std::chrono::milliseconds(std::max(nextEviction - msecs(), 0LL)), hasWork);
+        } else {
+            _condition.wait(lock, hasWork);
+        }
+        if (_work.exchange(false)) {
+            for (SampleStream* s : _streams) {
+                if (s->_pending.exchange(false)) {
+                    s->decodeRequested(file(s));
+                }
+            }
+        }
+        const long long now = msecs();
+        if (now >= nextEviction) {
+            for (SampleStream* s : _streams) {
+                s->evictIdle(now);
+            }
+            nextEviction = now + EVICT_INTERVAL_MS;
+        }
+    }
+}
+}
+
+//---------------------------------------------------------
+//   SampleFile::open
+//    map the file and read its header
+//---------------------------------------------------------
+
+bool SampleFile::open()
+{
+    if (!file.open(QIODevice::ReadOnly)) {
+        printf("SampleFile::open: open <%s> failed\n", qPrintable(file.fileName()));
+        return false;
+    }
+    uchar* p = file.map(0, file.size());
+    if (!p) {
+        printf("SampleFile::open: cannot map <%s>\n", qPrintable(file.fileName()));
+        return false;
+    }
+    bytes = QByteArray::fromRawData(reinterpret_cast<const char*>(p), int(file.size()));
+    if (!audio.open(bytes)) {
+        printf("open <%s> failed: %s\n", qPrintable(file.fileName()), audio.error());
+        return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   SampleStream
+//---------------------------------------------------------
+
+SampleStream::SampleStream(const QString& path)
+    : _path(path)
+{
+}
+
+SampleStream::~SampleStream()
+{
+    if (_blocks) {
+        SampleReader::instance()->remove(this);
+        for (int i = 0; i < _blockCount; ++i) {
+            delete[] _blocks[i].data.load();
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   open
+//    open the sample file and read its header; the head
+//    is then read from audio() by the caller
+//---------------------------------------------------------
+
+bool SampleStream::open()
+{
+    _file.reset(new SampleFile(_path));
+    if (!_file->open()) {
+        return false;
+    }
+    _frames   = _file->audio.frames();
+    _channels = _file->audio.channels();
+    return true;
+}
+
+//---------------------------------------------------------
+//   start
+//    frames before firstFrame are preloaded by the sample;
+//    hand the rest over to the reader thread
+//---------------------------------------------------------
+
+void SampleStream::start(long long firstFrame)
+{
+    _firstFrame = firstFrame;
+    _blockCount = int((_frames - _firstFrame + BLOCK_FRAMES - 1) >> BLOCK_SHIFT);
+    _blocks.reset(new Block[_blockCount]);
+    SampleReader::instance()->add(this, std::move(_file));
+}
+
+//---------------------------------------------------------
+//   request
+//    audio thread
+//---------------------------------------------------------
+
+void SampleStream::request(int block)
+{
+    BlockState expected = BlockState::EMPTY;
+    if (_blocks[block].state.compare_exchange_strong(expected, BlockState::REQUESTED)) {
+        _pending = true;
+        SampleReader::instance()->wake();
+    }
+}
+
+//---------------------------------------------------------
+//   prefetch
+//    request the blocks a voice playing at frame will
+//    need next; audio thread
+//---------------------------------------------------------
+
+void SampleStream::prefetch(long long frame)
+{
+    const long long last = std::min(frame + PREFETCH_FRAMES, _frames - 1);
+    if (last < _firstFrame) {
+        return;
+    }
+    const int first = int((std::max(frame, _firstFrame) - _firstFrame) >> BLOCK_SHIFT);
+    for (int b = first; b <= int((last - _firstFrame) >> BLOCK_SHIFT); ++b) {
+        if (_blocks[b].state.load(std::memory_order_relaxed) == BlockState::EMPTY) {
+            request(b);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   decodeRequested
+//    the requested blocks are silent if file could not
+//    be opened
+//    reader thread
+//---------------------------------------------------------
+
+void SampleStream::decodeRequested(SampleFile* file)
+{
+    for (int b = 0; b < _blockCount; ++b) {
+        Block& block = _blocks[b];
+        if (block.state.load() != BlockState::REQUESTED) {
+            continue;
+        }
+        const long long start = _firstFrame + (long long)(b) * BLOCK_FRAMES;
+        const long long n = std::min(BLOCK_FRAMES, _frames - start);
+        short* d = new short[n * _channels];
+        if (!file || file->audio.seekFrame(start) != start || file->audio.readData(d, n) != n) {
+            printf("SampleStream: read of <%s> failed\n", qPrintable(_path));
+            std::fill(d, d + n * _channels, short(0));
+        }
+        block.data.store(d, std::memory_order_release);
+        block.state = BlockState::READY;
+        ++_decodedBlocks;
+    }
+    _lastUse = msecs();
+}
+
+//---------------------------------------------------------
+//   evictIdle
+//    free the decoded blocks of a stream no voice used
+//    for idleTime() ms. A voice acquires the stream before
+//    it reads a block, so a block is only deleted if
+//    there is still no user after it was taken out of the
+//    table.
+//    reader thread
+//---------------------------------------------------------
+
+void SampleStream::evictIdle(long long now)
+{
+    if (_users != 0) {
+        _lastUse = now;
+        return;
+    }
+    if (_decodedBlocks == 0 || now - _lastUse < _idleTime) {
+        return;
+    }
+    for (int b = 0; b < _blockCount; ++b) {
+        Block& block = _blocks[b];
+        short* d = block.data.exchange(nullptr);
+        if (!d) {
+            continue;
+        }
+        if (_users != 0) {
+            block.data.store(d);
+            _lastUse = now;
+            return;
+        }
+        block.state = BlockState::EMPTY;
+        --_decodedBlocks;
+        delete[] d;
+    }
+}
+
+//---------------------------------------------------------
+//   openFiles
+//    number of sample files the reader keeps open
+//---------------------------------------------------------
+
+int SampleStream::openFiles()
+{
+    return SampleReader::instance()->openFiles();
+}
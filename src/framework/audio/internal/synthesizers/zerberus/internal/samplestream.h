@@ -0,0 +1,160 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2013 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef MU_ZERBERUS_SAMPLESTREAM_H
+#define MU_ZERBERUS_SAMPLESTREAM_H
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include "audiofile/audiofile.h"
+
+namespace mu::zerberus {
+//---------------------------------------------------------
+//   SampleFile
+//    a memory mapped sample file and its decoder
+//---------------------------------------------------------
+
+struct SampleFile {
+    QFile file;
+    QByteArray bytes;                   // the mapped file, not a copy
+    AudioFile audio;
+
+    SampleFile(const QString& path)
+        : file(path) {}
+    bool open();
+};
+
+//---------------------------------------------------------
+//   SampleStream
+//    the part of a sample behind its preloaded head
+//
+//    The sample is decoded block by block by a background
+//    reader thread when a voice asks for it. The reader
+//    keeps only the most recently read sample files open.
+//    Decoded blocks are shared by all voices playing the
+//    sample and are freed again once no voice used the
+//    sample for idleTime() ms.
+//
+//    value(), prefetch(), acquire() and release() are
+//    called from the audio thread and never block.
+//---------------------------------------------------------
+
+class SampleStream
+{
+public:
+    static constexpr int BLOCK_SHIFT = 14;
+    static constexpr long long BLOCK_FRAMES = 1LL << BLOCK_SHIFT;
+    static constexpr long long PREFETCH_FRAMES = 2 * BLOCK_FRAMES;   // read ahead of the playing position
+    static constexpr int MAX_OPEN_FILES = 32;                        // sample files the reader keeps open
+
+private:
+    enum class BlockState : char {
+        EMPTY,
+        REQUESTED,
+        READY
+    };
+
+    struct Block {
+        std::atomic<short*> data { nullptr };
+        std::atomic<BlockState> state { BlockState::EMPTY };
+    };
+
+    QString _path;
+    std::unique_ptr<SampleFile> _file;  // from open() to start(), then owned by the reader
+
+    long long _frames { 0 };
+    int _channels { 0 };
+    long long _firstFrame { 0 };        // first frame that is not preloaded
+    std::unique_ptr<Block[]> _blocks;
+    int _blockCount { 0 };
+
+    std::atomic<int> _users { 0 };
+    std::atomic<bool> _pending { false };
+    int _decodedBlocks { 0 };           // used by the reader thread only
+    long long _lastUse { 0 };           // ms, reader thread only
+
+    static std::atomic<int> _preloadTime;
+    static std::atomic<int> _idleTime;
+    static std::atomic<unsigned long long> _underruns;
+
+    void request(int block);
+
+    friend class SampleReader;
+    void decodeRequested(SampleFile* file);
+    void evictIdle(long long now);
+
+public:
+    SampleStream(const QString& path);
+    ~SampleStream();
+
+    bool open();
+    AudioFile& audio() { return _file->audio; }     // valid until start()
+    void start(long long firstFrame);
+
+    long long firstFrame() const { return _firstFrame; }
+
+    void acquire() { ++_users; }
+    void release() { --_users; }
+    void prefetch(long long frame);
+
+    //---------------------------------------------------------
+    //   value
+    //    returns false if the block holding frame is not
+    //    decoded yet; it is requested and v is left alone
+    //---------------------------------------------------------
+
+    bool value(long long frame, int channel, short& v)
+    {
+        if (frame >= _frames) {
+            frame = _frames - 1;
+        }
+        const long long i = frame - _firstFrame;
+        const int block = int(i >> BLOCK_SHIFT);
+        const short* d = _blocks[block].data.load(std::memory_order_acquire);
+        if (!d) {
+            request(block);
+            return false;
+        }
+        v = d[(i & (BLOCK_FRAMES - 1)) * _channels + channel];
+        return true;
+    }
+
+    //---------------------------------------------------------
+    //   decoded
+    //    whether frame can be read without an underrun
+    //---------------------------------------------------------
+
+    bool decoded(long long frame) const
+    {
+        if (frame < _firstFrame) {
+            return true;
+        }
+        return _blocks[int((std::min(frame, _frames - 1) - _firstFrame) >> BLOCK_SHIFT)].data.load() != nullptr;
+    }
+
+    static void setPreloadTime(int ms) { _preloadTime = ms; }
+    static int preloadTime() { return _preloadTime; }
+    static void setIdleTime(int ms) { _idleTime = ms; }
+    static int idleTime() { return _idleTime; }
+    static int openFiles();
+    static void countUnderrun() { ++_underruns; }
+    static unsigned long long underruns() { return _underruns; }
+    static void resetUnderruns() { _underruns = 0; }
+};
+}
+
+#endif //MU_ZERBERUS_SAMPLESTREAM_H
@@ -11,6 +11,15 @@
 //=============================================================================
 
 #include <stdio.h>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ZERBERUS_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ZERBERUS_NEON
+#endif
 
 #include "voice.h"
 #include "instrument.h"
@@ -18,6 +27,7 @@
 #include "zerberus.h"
 #include "zone.h"
 #include "sample.h"
+#include "samplestream.h"
 
 //#include "midi/msynthesizer.h"
 
@@ -25,6 +35,7 @@ using namespace mu::zerberus;
 
 float Envelope::egPow[EG_SIZE];
 float Envelope::egLin[EG_SIZE];
+bool Voice::_simdKernels = true;
 
 static const char* voiceStateNames[] = {
     "OFF", "ATTACK", "PLAYING", "SUSTAINED", "STOP"
@@ -66,6 +77,19 @@ void Voice::stop(float time)
     currentEnvelope = V1Envelopes::RELEASE;
 }
 
+//---------------------------------------------------------
+//   off
+//---------------------------------------------------------
+
+void Voice::off()
+{
+    _state = VoiceState::OFF;
+    if (_stream) {
+        _stream->release();
+        _stream = nullptr;
+    }
+}
+
 //---------------------------------------------------------
 //   init
 //---------------------------------------------------------
@@ -103,6 +127,13 @@ void Voice::start(Channel* c, int key, int v, const Zone* zone, double durSinceN
     data      = s->data() + z->offset * audioChan;
     //avoid processing sample if offset is bigger than sample length
     eidx      = std::max((s->frames() - z->offset - 1) * audioChan, 0ll);
+    _stream   = s->stream();
+    if (_stream) {
+        _stream->acquire();
+        residentEnd = (s->residentFrames() - z->offset) * audioChan;
+    } else {
+        residentEnd = std::numeric_limits<long long>::max();
+    }
     _loopMode = z->loopMode;
     _loopStart = z->loopStart;
     _loopEnd   = z->loopEnd;
@@ -193,6 +224,7 @@ void Voice::start(Channel* c, int key, int v, const Zone* zone, double durSinceN
     envelopes[V1Envelopes::RELEASE].max = envelopes[V1Envelopes::SUSTAIN].val;
 
     _looping = false;
+    prefetch();
 }
 
 //---------------------------------------------------------
@@ -227,83 +259,207 @@ void Voice::updateEnvelopes()
 }
 
 //---------------------------------------------------------
-//   process
+//   VoiceBlock
+//    the work of Voice::process() for up to FRAMES output
+//    frames: the source samples around the playing position
+//    of every frame, their interpolation weights, the
+//    envelope value and the result per channel
 //---------------------------------------------------------
 
-void Voice::process(int frames, float* p)
+namespace mu::zerberus {
+struct VoiceBlock {
+    static constexpr int FRAMES = 64;
+
+    alignas(16) float coeff[4][FRAMES];
+    alignas(16) float src[2][4][FRAMES];      // [channel][tap][frame]
+    alignas(16) float value[2][FRAMES];
+    alignas(16) float env[FRAMES];
+};
+}
+
+//---------------------------------------------------------
+//   interpolateBlock
+//    value = coeff[0] * src[0] + ... + coeff[3] * src[3],
+//    four frames at a time where SSE or NEON is available.
+//    The sums are formed in the same order as in
+//    ZFilter::interpolate(), so all paths give the same
+//    result.
+//---------------------------------------------------------
+
+static void interpolateBlock(const VoiceBlock& b, int channel, int frames, float* value, bool simd)
 {
-    filter.update();
+    const float* c0 = b.coeff[0];
+    const float* c1 = b.coeff[1];
+    const float* c2 = b.coeff[2];
+    const float* c3 = b.coeff[3];
+    const float* s0 = b.src[channel][0];
+    const float* s1 = b.src[channel][1];
+    const float* s2 = b.src[channel][2];
+    const float* s3 = b.src[channel][3];
+    int i = 0;
+#if defined(ZERBERUS_SSE)
+    for (; simd && i + 4 <= frames; i += 4) {
+        __m128 v = _mm_add_ps(_mm_mul_ps(_mm_load_ps(c0 + i), _mm_load_ps(s0 + i)),
+                              _mm_mul_ps(_mm_load_ps(c1 + i), _mm_load_ps(s1 + i)));
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_load_ps(c2 + i), _mm_load_ps(s2 + i)));
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_load_ps(c3 + i), _mm_load_ps(s3 + i)));
+        _mm_store_ps(value + i, v);
+    }
+#elif defined(ZERBERUS_NEON)
+    for (; simd && i + 4 <= frames; i += 4) {
+        float32x4_t v = vaddq_f32(vmulq_f32(vld1q_f32(c0 + i), vld1q_f32(s0 + i)),
+                                  vmulq_f32(vld1q_f32(c1 + i), vld1q_f32(s1 + i)));
+        v = vaddq_f32(v, vmulq_f32(vld1q_f32(c2 + i), vld1q_f32(s2 + i)));
+        v = vaddq_f32(v, vmulq_f32(vld1q_f32(c3 + i), vld1q_f32(s3 + i)));
+        vst1q_f32(value + i, v);
+    }
+#else
+    Q_UNUSED(simd);
+#endif
+    for (; i < frames; ++i) {
+        value[i] = c0[i] * s0[i] + c1[i] * s1[i] + c2[i] * s2[i] + c3[i] * s3[i];
+    }
+}
 
-    const float opcodePanLeftGain = 1.f - fmax(0.0f, z->pan / 100.0);   //[0, 1]
-    const float opcodePanRightGain = 1.f + fmin(0.0f, z->pan / 100.0);   //[0, 1]
-    const float leftChannelVol = gain * z->ccGain * _channel->panLeftGain() * opcodePanLeftGain;
-    const float rightChannelVol = gain * z->ccGain * _channel->panRightGain() * opcodePanRightGain;
-    if (audioChan == 1) {
-        while (frames--) {
-            updateLoop();
+//---------------------------------------------------------
+//   writeBlock
+//    p[2 * i] = left[i] * env[i] * leftVol and the same for
+//    the right channel
+//---------------------------------------------------------
 
-            long long idx = phase.index();
+static void writeBlock(const float* left, const float* right, const float* env, int frames,
+                       float leftVol, float rightVol, float* p, bool simd)
+{
+    int i = 0;
+#if defined(ZERBERUS_SSE)
+    const __m128 lv = _mm_set1_ps(leftVol);
+    const __m128 rv = _mm_set1_ps(rightVol);
+    for (; simd && i + 4 <= frames; i += 4) {
+        const __m128 e = _mm_load_ps(env + i);
+        const __m128 l = _mm_mul_ps(_mm_mul_ps(_mm_load_ps(left + i), e), lv);
+        const __m128 r = _mm_mul_ps(_mm_mul_ps(_mm_load_ps(right + i), e), rv);
+        _mm_storeu_ps(p + 2 * i, _mm_unpacklo_ps(l, r));
+        _mm_storeu_ps(p + 2 * i + 4, _mm_unpackhi_ps(l, r));
+    }
+#elif defined(ZERBERUS_NEON)
+    const float32x4_t lv = vdupq_n_f32(leftVol);
+    const float32x4_t rv = vdupq_n_f32(rightVol);
+    for (; simd && i + 4 <= frames; i += 4) {
+        const float32x4_t e = vld1q_f32(env + i);
+        float32x4x2_t lr;
+        lr.val[0] = vmulq_f32(vmulq_f32(vld1q_f32(left + i), e), lv);
+        lr.val[1] = vmulq_f32(vmulq_f32(vld1q_f32(right + i), e), rv);
+        vst2q_f32(p + 2 * i, lr);
+    }
+#else
+    Q_UNUSED(simd);
+#endif
+    for (; i < frames; ++i) {
+        p[2 * i]     = left[i] * env[i] * leftVol;
+        p[2 * i + 1] = right[i] * env[i] * rightVol;
+    }
+}
 
-            if (idx >= eidx) {
-                off();
-                break;
-            }
+//---------------------------------------------------------
+//   fillBlock
+//    advance the voice by up to frames output frames and
+//    collect what they need. Returns the number of frames
+//    to write; filtered is the number of frames that go
+//    through the filter, one more than that if the voice
+//    ended in the envelope.
+//
+//    Outside of attack and release the envelope does not
+//    move and the voice state cannot change, so these
+//    blocks are a single envelope segment.
+//---------------------------------------------------------
+
+int Voice::fillBlock(VoiceBlock& b, int frames, int& filtered)
+{
+    const bool steady = _state == VoiceState::PLAYING || _state == VoiceState::SUSTAINED;
+    const bool advance = currentEnvelope != V1Envelopes::DELAY;
+
+    for (int i = 0; i < frames; ++i) {
+        updateLoop();
 
-            float interpVal = filter.interpolate(phase.fract(),
-                                                 getData(idx - 1), getData(idx), getData(idx + 1), getData(idx + 2));
-            float v = filter.apply(interpVal, true);
+        const long long idx = phase.index() * audioChan;
+        if (idx >= eidx) {
+            off();
+            filtered = i;
+            return i;
+        }
+
+        const float* c = ZFilter::interpolationCoefficients(phase.fract());
+        for (int k = 0; k < 4; ++k) {
+            b.coeff[k][i] = c[k];
+        }
+        for (int ch = 0; ch < audioChan; ++ch) {
+            for (int k = 0; k < 4; ++k) {
+                b.src[ch][k][i] = getData(idx + (k - 1) * audioChan + ch);
+            }
+        }
 
+        if (steady) {
+            b.env[i] = envelopes[currentEnvelope].val;
+            if (advance) {
+                phase += phaseIncr;
+            }
+        } else {
             updateEnvelopes();
             if (_state == VoiceState::OFF) {
-                break;
+                filtered = i + 1;
+                return i;
             }
-
-            *p++ = v * envelopes[currentEnvelope].val * leftChannelVol;
-            *p++ = v * envelopes[currentEnvelope].val * rightChannelVol;
-
+            b.env[i] = envelopes[currentEnvelope].val;
             if (V1Envelopes::DELAY != currentEnvelope) {
                 phase += phaseIncr;
             }
-
-            _samplesSinceStart++;
         }
-    } else {
-        //
-        // handle interleaved stereo samples
-        //
-        while (frames--) {
-            updateLoop();
 
-            long long idx = phase.index() * 2;
-            if (idx >= eidx) {
-                off();
+        _samplesSinceStart++;
+    }
+    filtered = frames;
+    return frames;
+}
 
-                break;
-            }
+//---------------------------------------------------------
+//   process
+//    render the voice in blocks: collect the source samples
+//    and envelope of a block, then interpolate, filter and
+//    apply the gains to the whole block
+//---------------------------------------------------------
 
-            float interpValL = filter.interpolate(phase.fract(),
-                                                  getData(idx - 2), getData(idx), getData(idx + 2), getData(idx + 4));
-            float interpValR = filter.interpolate(phase.fract(),
-                                                  getData(idx - 1), getData(idx + 1), getData(idx + 3),
-                                                  getData(idx + 5));
-            float valueL = filter.apply(interpValL, true);
-            float valueR = filter.apply(interpValR, false);
+void Voice::process(int frames, float* p)
+{
+    filter.update();
+    prefetch();
 
-            //apply volume
-            updateEnvelopes();
-            if (_state == VoiceState::OFF) {
-                break;
-            }
+    const float opcodePanLeftGain = 1.f - fmax(0.0f, z->pan / 100.0);   //[0, 1]
+    const float opcodePanRightGain = 1.f + fmin(0.0f, z->pan / 100.0);   //[0, 1]
+    const float leftChannelVol = gain * z->ccGain * _channel->panLeftGain() * opcodePanLeftGain;
+    const float rightChannelVol = gain * z->ccGain * _channel->panRightGain() * opcodePanRightGain;
 
-            *p++ = valueL * envelopes[currentEnvelope].val * leftChannelVol;
-            *p++ = valueR * envelopes[currentEnvelope].val * rightChannelVol;
+    VoiceBlock b;
+    while (frames > 0) {
+        const int n = std::min(frames, VoiceBlock::FRAMES);
+        int filtered = 0;
+        const int written = fillBlock(b, n, filtered);
 
-            if (V1Envelopes::DELAY != currentEnvelope) {
-                phase += phaseIncr;
-            }
+        interpolateBlock(b, 0, filtered, b.value[0], _simdKernels);
+        if (audioChan == 2) {
+            interpolateBlock(b, 1, filtered, b.value[1], _simdKernels);
+        }
+        filter.applyBlock(b.value[0], audioChan == 2 ? b.value[1] : nullptr, filtered);
+        writeBlock(b.value[0], b.value[audioChan == 2 ? 1 : 0], b.env, written, leftChannelVol, rightChannelVol, p, _simdKernels);
 
-            _samplesSinceStart++;
+        if (written < n) {
+            break;
         }
+        p += 2 * n;
+        frames -= n;
+    }
+    if (_underrun) {
+        SampleStream::countUnderrun();
+        _underrun = false;
     }
 }
 
@@ -332,6 +488,40 @@ void Voice::updateLoop()
     }
 }
 
+//---------------------------------------------------------
+//   prefetch
+//    ask the stream for the frames this voice plays next
+//    and, if it loops, for the start of the loop
+//---------------------------------------------------------
+
+void Voice::prefetch()
+{
+    if (!_stream) {
+        return;
+    }
+    _stream->prefetch(z->offset + phase.index());
+    if (_loopMode == LoopMode::CONTINUOUS || _loopMode == LoopMode::SUSTAIN) {
+        _stream->prefetch(z->offset + _loopStart);
+    }
+}
+
+//---------------------------------------------------------
+//   sampleAt
+//    silence if the streamed part is not read yet
+//---------------------------------------------------------
+
+short Voice::sampleAt(long long pos)
+{
+    if (pos < residentEnd) {
+        return data[pos];
+    }
+    short v = 0;
+    if (!_stream->value(z->offset + pos / audioChan, int(pos % audioChan), v)) {
+        _underrun = true;
+    }
+    return v;
+}
+
 short Voice::getData(long long pos)
 {
     if (pos < 0 && !_looping) {
@@ -339,18 +529,18 @@ short Voice::getData(long long pos)
     }
 
     if (!_looping) {
-        return data[pos];
+        return sampleAt(pos);
     }
 
     long long loopEnd = _loopEnd * audioChan;
     long long loopStart = _loopStart * audioChan;
 
     if (pos < loopStart) {
-        return data[loopEnd + (pos - loopStart) + audioChan];
+        return sampleAt(loopEnd + (pos - loopStart) + audioChan);
     } else if (pos > (loopEnd + audioChan - 1)) {
-        return data[loopStart + (pos - loopEnd) - audioChan];
+        return sampleAt(loopStart + (pos - loopEnd) - audioChan);
     } else {
-        return data[pos];
+        return sampleAt(pos);
     }
 }
 
@@ -26,7 +26,9 @@ namespace mu::zerberus {
 class Channel;
 struct Zone;
 class Sample;
+class SampleStream;
 class Zerberus;
+struct VoiceBlock;
 
 enum class LoopMode : char;
 enum class OffMode : char;
@@ -124,8 +126,14 @@ enum V1Envelopes : int {
 class Voice
 {
     Voice* _next;
+    Voice* _keyPrev   { nullptr };     // voices started for the same channel and key
+    Voice* _keyNext   { nullptr };
+    Voice* _groupPrev { nullptr };     // voices with an offBy group
+    Voice* _groupNext { nullptr };
     Zerberus* _zerberus;
 
+    friend class Zerberus;
+
     VoiceState _state = VoiceState::OFF;
     Channel* _channel;
     int _key;
@@ -134,6 +142,9 @@ class Voice
 
     short* data;
     long long eidx;
+    long long residentEnd;        // data[pos] is valid below, the rest comes from _stream
+    SampleStream* _stream { nullptr };
+    bool _underrun { false };
     LoopMode _loopMode;
     OffMode _offMode;
     int _offBy;
@@ -155,16 +166,24 @@ class Voice
 
     const Zone* z;
 
+    static bool _simdKernels;
+
+    int fillBlock(VoiceBlock& b, int frames, int& filtered);
+
 public:
     Voice(Zerberus*);
     Voice* next() const { return _next; }
     void setNext(Voice* v) { _next = v; }
+    Voice* keyNext() const { return _keyNext; }
+    Voice* groupNext() const { return _groupNext; }
 
     void start(Channel* channel, int key, int velo, const Zone*, double durSinceNoteOn);
     void updateEnvelopes();
     void process(int frames, float*);
     void updateLoop();
     short getData(long long pos);
+    short sampleAt(long long pos);
+    void prefetch();
 
     Channel* channel() const { return _channel; }
     int key() const { return _key; }
@@ -184,7 +203,7 @@ public:
 
     void stop(float time);
     void sustained() { _state = VoiceState::SUSTAINED; }
-    void off() { _state = VoiceState::OFF; }
+    void off();
     const char* state() const;
     LoopMode loopMode() const { return _loopMode; }
     int getSamplesSinceStart() { return _samplesSinceStart; }
@@ -193,6 +212,11 @@ public:
     OffMode offMode() const { return _offMode; }
     int offBy() const { return _offBy; }
     static void init();
+
+    //! process() uses SSE or NEON kernels where available; switched off,
+    //! it renders with the scalar ones, which give the same result
+    static void setSimdKernels(bool on) { _simdKernels = on; }
+    static bool simdKernels() { return _simdKernels; }
 };
 }
 
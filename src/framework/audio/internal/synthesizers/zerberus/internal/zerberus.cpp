@@ -20,12 +20,14 @@
 #include "channel.h"
 #include "instrument.h"
 #include "zone.h"
+#include "samplestream.h"
 
 using namespace mu::zerberus;
 
 bool Zerberus::initialized = false;
 // instruments can be shared between several zerberus instances
 std::list<ZInstrument*> Zerberus::globalInstruments;
+std::mutex Zerberus::globalInstrumentsMutex;
 
 //---------------------------------------------------------
 //   Zerberus
@@ -33,9 +35,12 @@ std::list<ZInstrument*> Zerberus::globalInstruments;
 
 Zerberus::Zerberus()
 {
-    if (!initialized) {
-        initialized = true;
-        Voice::init();
+    {
+        std::lock_guard<std::mutex> lock(globalInstrumentsMutex);
+        if (!initialized) {
+            initialized = true;
+            Voice::init();
+        }
     }
 
     freeVoices.init(this);
@@ -52,6 +57,7 @@ Zerberus::Zerberus()
 Zerberus::~Zerberus()
 {
     busy = true;
+    std::lock_guard<std::mutex> lock(globalInstrumentsMutex);
     while (!instruments.empty()) {
         auto i  = instruments.front();
         auto it = instruments.begin();
@@ -82,13 +88,13 @@ void Zerberus::trigger(Channel* channel, int key, int velo, Trigger trigger, int
 {
     ZInstrument* i = channel->instrument();
     double random = (double)rand() / (double)RAND_MAX;
-    for (Zone* z : i->zones()) {
+    for (Zone* z : i->zones(trigger, key, velo)) {
         if (z->match(channel, key, velo, trigger, random, cc, ccVal)) {
             //
             // handle offBy voices
             //
             if (z->group) {
-                for (Voice* v = activeVoices; v; v = v->next()) {
+                for (Voice* v = offByVoices; v; v = v->groupNext()) {
                     if (v->offBy() == z->group) {
                         if (v->offMode() == OffMode::FAST) {
                             v->stop(1);
@@ -107,8 +113,72 @@ void Zerberus::trigger(Channel* channel, int key, int velo, Trigger trigger, int
             Voice* voice = freeVoices.pop();
             Q_ASSERT(voice->isOff());
             voice->start(channel, key, velo, z, durSinceNoteOn);
-            voice->setNext(activeVoices);
-            activeVoices = voice;
+            linkVoice(voice);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   linkVoice
+//    add a started voice to the active voices, the voices
+//    of its channel and key and the offBy voices. New
+//    voices go to the front, so lists walked while voices
+//    are triggered do not see them.
+//---------------------------------------------------------
+
+void Zerberus::linkVoice(Voice* v)
+{
+    v->setNext(activeVoices);
+    activeVoices = v;
+
+    v->_keyPrev = 0;
+    v->_keyNext = 0;
+    if (v->key() >= 0 && v->key() < 128) {
+        Voice*& head = v->channel()->keyVoices(v->key());
+        v->_keyNext = head;
+        if (head) {
+            head->_keyPrev = v;
+        }
+        head = v;
+    }
+
+    v->_groupPrev = 0;
+    v->_groupNext = 0;
+    if (v->offBy()) {
+        v->_groupNext = offByVoices;
+        if (offByVoices) {
+            offByVoices->_groupPrev = v;
+        }
+        offByVoices = v;
+    }
+}
+
+//---------------------------------------------------------
+//   unlinkVoice
+//    remove a voice from the key and offBy lists before it
+//    is reused; process() takes care of activeVoices
+//---------------------------------------------------------
+
+void Zerberus::unlinkVoice(Voice* v)
+{
+    if (v->key() >= 0 && v->key() < 128) {
+        if (v->_keyPrev) {
+            v->_keyPrev->_keyNext = v->_keyNext;
+        } else {
+            v->channel()->keyVoices(v->key()) = v->_keyNext;
+        }
+        if (v->_keyNext) {
+            v->_keyNext->_keyPrev = v->_keyPrev;
+        }
+    }
+    if (v->offBy()) {
+        if (v->_groupPrev) {
+            v->_groupPrev->_groupNext = v->_groupNext;
+        } else {
+            offByVoices = v->_groupNext;
+        }
+        if (v->_groupNext) {
+            v->_groupNext->_groupPrev = v->_groupPrev;
         }
     }
 }
@@ -119,11 +189,8 @@ void Zerberus::trigger(Channel* channel, int key, int velo, Trigger trigger, int
 
 void Zerberus::processNoteOff(Channel* cp, int key)
 {
-    for (Voice* v = activeVoices; v; v = v->next()) {
-        if ((v->channel() == cp)
-            && (v->key() == key)
-            && (v->loopMode() != LoopMode::ONE_SHOT)
-            ) {
+    for (Voice* v = cp->keyVoices(key); v; v = v->keyNext()) {
+        if (v->loopMode() != LoopMode::ONE_SHOT) {
             if (cp->sustain() < 0x40 && !v->isStopped()) {
                 v->stop();
                 double durSinceNoteOn = v->getSamplesSinceStart() / sampleRate();
@@ -143,13 +210,11 @@ void Zerberus::processNoteOff(Channel* cp, int key)
 
 void Zerberus::processNoteOn(Channel* cp, int key, int velo)
 {
-    for (Voice* v = activeVoices; v; v = v->next()) {
-        if (v->channel() == cp && v->key() == key) {
-            if (v->isSustained()) {
+    for (Voice* v = cp->keyVoices(key); v; v = v->keyNext()) {
+        if (v->isSustained()) {
 //if (v->isPlaying())
 //printf("retrigger (stop) %p\n", v);
-                v->stop(100);             // fast stop
-            }
+            v->stop(100);             // fast stop
         }
     }
     trigger(cp, key, velo, Trigger::ATTACK, -1, -1, 0);
@@ -166,6 +231,9 @@ bool Zerberus::noteOn(int channel, int key, int velo)
         // no instrument
         return false;
     }
+    if (key < 0 || key > 127) {
+        return false;
+    }
 
     if (velo) {
         processNoteOn(cp, key, velo);
@@ -183,6 +251,9 @@ bool Zerberus::noteOff(int channel, int key)
         // no instrument
         return false;
     }
+    if (key < 0 || key > 127) {
+        return false;
+    }
 
     processNoteOff(cp, key);
 
@@ -223,6 +294,7 @@ void Zerberus::process(unsigned frames, float* p, float*, float*)
             } else {
                 activeVoices = v->next();
             }
+            unlinkVoice(v);
             freeVoices.push(v);
         } else {
             pv = v;
@@ -255,6 +327,33 @@ void Zerberus::allNotesOff(int channel)
     busy = false;
 }
 
+//---------------------------------------------------------
+//   setStreamingPreloadTime
+//    samples loaded afterwards keep only their first ms
+//    milliseconds in memory
+//---------------------------------------------------------
+
+void Zerberus::setStreamingPreloadTime(int ms)
+{
+    SampleStream::setPreloadTime(ms);
+}
+
+int Zerberus::streamingPreloadTime()
+{
+    return SampleStream::preloadTime();
+}
+
+//---------------------------------------------------------
+//   streamingUnderruns
+//    number of voice buffers rendered with silence because
+//    the reader thread had not decoded the frames in time
+//---------------------------------------------------------
+
+unsigned long long Zerberus::streamingUnderruns()
+{
+    return SampleStream::underruns();
+}
+
 //---------------------------------------------------------
 //   soundFonts
 //---------------------------------------------------------
@@ -284,6 +383,7 @@ bool Zerberus::addSoundFont(const QString& path)
 
 bool Zerberus::removeSoundFont(const QString& path)
 {
+    std::lock_guard<std::mutex> lock(globalInstrumentsMutex);
     for (ZInstrument* i : instruments) {
         if (i->path() == path) {
             auto it = find(instruments.begin(), instruments.end(), i);
@@ -353,6 +453,7 @@ bool Zerberus::loadInstrument(const QString& path)
             return true;
         }
     }
+    std::lock_guard<std::mutex> lock(globalInstrumentsMutex);
     for (ZInstrument* instr : globalInstruments) {
         if (QFileInfo(instr->path()).fileName() == fileName) {
             instruments.push_back(instr);
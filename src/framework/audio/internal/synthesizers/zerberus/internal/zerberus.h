@@ -17,6 +17,7 @@
 #include <atomic>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <QString>
 
@@ -78,6 +79,7 @@ class Zerberus //: public Ms::Synthesizer
 {
     static bool initialized;
     static std::list<ZInstrument*> globalInstruments;
+    static std::mutex globalInstrumentsMutex;      // instruments are shared by all Zerberus instances
 
     double _masterTuning = 440.0;
     std::atomic<bool> busy;
@@ -87,6 +89,7 @@ class Zerberus //: public Ms::Synthesizer
 
     VoiceFifo freeVoices;
     Voice* activeVoices = 0;
+    Voice* offByVoices = 0;       // active voices with an offBy group, linked by Voice::groupNext()
     int _loadProgress = 0;
     bool _loadWasCanceled = false;
 
@@ -94,6 +97,8 @@ class Zerberus //: public Ms::Synthesizer
 
     bool loadInstrument(const QString& path);
 
+    void linkVoice(Voice*);
+    void unlinkVoice(Voice*);
     void trigger(Channel*, int key, int velo, Trigger, int cc, int ccVal, double durSinceNoteOn);
     void processNoteOff(Channel*, int pitch);
     void processNoteOn(Channel* cp, int key, int velo);
@@ -130,6 +135,11 @@ public:
 
     void allSoundsOff(int channel);
     void allNotesOff(int channel);
+
+    // streaming of sample files, see SampleStream; 0 reads samples completely
+    static void setStreamingPreloadTime(int ms);
+    static int streamingPreloadTime();
+    static unsigned long long streamingUnderruns();
 };
 }
 
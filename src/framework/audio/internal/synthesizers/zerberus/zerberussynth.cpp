@@ -181,12 +181,18 @@ bool ZerberusSynth::handleEvent(const Event& e)
     return ret;
 }
 
+void ZerberusSynth::scheduleEvent(const Event& e, unsigned int sampleOffset)
+{
+    m_events.push(e, sampleOffset);
+}
+
 void ZerberusSynth::allSoundsOff()
 {
     IF_ASSERT_FAILED(m_zerb) {
         return;
     }
 
+    m_events.clear();
     m_zerb->allSoundsOff(-1);
 }
 
@@ -196,6 +202,7 @@ void ZerberusSynth::flushSound()
         return;
     }
 
+    m_events.clear();
     m_zerb->allSoundsOff(-1);
 
     int samples = int(m_zerb->sampleRate());
@@ -257,11 +264,14 @@ void ZerberusSynth::writeBuf(float* stream, unsigned int samples)
         return;
     }
 
-    if (!isActive()) {
-        return;
-    }
-
-    m_zerb->process(samples, stream, nullptr, nullptr);
+    //! NOTE events are handled even while inactive, the player activates the synth when it sends them
+    m_events.process(samples, [this, stream](unsigned int from, unsigned int count) {
+        if (isActive()) {
+            m_zerb->process(count, stream + from * AUDIO_CHANNELS, nullptr, nullptr);
+        }
+    }, [this](const Event& e) {
+        handleEvent(e);
+    });
 }
 
 unsigned int ZerberusSynth::streamCount() const
@@ -20,6 +20,7 @@
 #define MU_AUDIO_ZERBERUSSYNTH_H
 
 #include "isynthesizer.h"
+#include "internal/synthesizers/timedeventqueue.h"
 
 namespace mu::zerberus {
 class Zerberus;
@@ -48,6 +49,7 @@ public:
 
     Ret setupChannels(const std::vector<midi::Event>& events) override;
     bool handleEvent(const midi::Event& e) override;
+    void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) override;
     void writeBuf(float* stream, unsigned int samples) override;
 
     void allSoundsOff() override; // all channels
@@ -67,6 +69,7 @@ public:
 private:
 
     zerberus::Zerberus* m_zerb = nullptr;
+    TimedEventQueue m_events;
     std::vector<float> m_preallocated;
     bool m_isLoggingSynthEvents = false;
     bool m_isActive = false;
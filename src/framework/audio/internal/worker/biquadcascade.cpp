@@ -0,0 +1,189 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "biquadcascade.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MU_AUDIO_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MU_AUDIO_NEON
+#endif
+
+#include "log.h"
+
+using namespace mu::audio;
+
+//! state below this is flushed to zero, so a decaying filter doesn't run into denormals
+static constexpr float DENORMAL_LIMIT = 1e-25f;
+
+unsigned int BiquadCascade::sectionCount() const
+{
+    return m_count;
+}
+
+void BiquadCascade::setSectionCount(unsigned int count)
+{
+    IF_ASSERT_FAILED(count <= MAX_SECTIONS) {
+        count = MAX_SECTIONS;
+    }
+    for (unsigned int i = m_count; i < count; ++i) {
+        m_sections[i] = Section();
+    }
+    m_count = count;
+}
+
+//---------------------------------------------------------
+//   setCoefficients
+//    the gains of the state space form are the outputs of
+//    four steps of the section for a unit input at each
+//    step and for a unit state
+//---------------------------------------------------------
+
+void BiquadCascade::setCoefficients(unsigned int section, const Coefficients& c)
+{
+    IF_ASSERT_FAILED(section < m_count) {
+        return;
+    }
+    Section& s = m_sections[section];
+    s.c = c;
+
+    auto response = [&c](const float x[4], float s1, float s2, float y[4]) {
+        for (int k = 0; k < 4; ++k) {
+            y[k] = c.b0 * x[k] + s1;
+            s1 = c.b1 * x[k] - c.a1 * y[k] + s2;
+            s2 = c.b2 * x[k] - c.a2 * y[k];
+        }
+    };
+
+    const float zero[4] = { 0.f, 0.f, 0.f, 0.f };
+    for (int j = 0; j < 4; ++j) {
+        float x[4] = { 0.f, 0.f, 0.f, 0.f };
+        x[j] = 1.f;
+        response(x, 0.f, 0.f, s.xGain[j]);
+    }
+    response(zero, 1.f, 0.f, s.s1Gain);
+    response(zero, 0.f, 1.f, s.s2Gain);
+}
+
+void BiquadCascade::reset()
+{
+    for (unsigned int i = 0; i < m_count; ++i) {
+        m_sections[i].s1 = 0.f;
+        m_sections[i].s2 = 0.f;
+    }
+}
+
+void BiquadCascade::process(float* buffer, unsigned int sampleCount)
+{
+    for (unsigned int i = 0; i < m_count; ++i) {
+        if (!m_sections[i].c.isIdentity()) {
+            processSection(m_sections[i], buffer, sampleCount);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   processSection
+//    the sums are formed in the same order on all paths,
+//    so SSE, NEON and the plain loop give the same result
+//---------------------------------------------------------
+
+void BiquadCascade::processSection(Section& s, float* buffer, unsigned int sampleCount)
+{
+    const Coefficients& c = s.c;
+    float s1 = s.s1;
+    float s2 = s.s2;
+    unsigned int i = 0;
+
+#if defined(MU_AUDIO_SSE)
+    const __m128 g0 = _mm_load_ps(s.xGain[0]);
+    const __m128 g1 = _mm_load_ps(s.xGain[1]);
+    const __m128 g2 = _mm_load_ps(s.xGain[2]);
+    const __m128 g3 = _mm_load_ps(s.xGain[3]);
+    const __m128 gs1 = _mm_load_ps(s.s1Gain);
+    const __m128 gs2 = _mm_load_ps(s.s2Gain);
+    alignas(16) float y[4];
+    for (; i + 4 <= sampleCount; i += 4) {
+        const float* x = buffer + i;
+        __m128 v = _mm_add_ps(_mm_mul_ps(g0, _mm_set1_ps(x[0])), _mm_mul_ps(g1, _mm_set1_ps(x[1])));
+        v = _mm_add_ps(v, _mm_mul_ps(g2, _mm_set1_ps(x[2])));
+        v = _mm_add_ps(v, _mm_mul_ps(g3, _mm_set1_ps(x[3])));
+        v = _mm_add_ps(v, _mm_mul_ps(gs1, _mm_set1_ps(s1)));
+        v = _mm_add_ps(v, _mm_mul_ps(gs2, _mm_set1_ps(s2)));
+        _mm_store_ps(y, v);
+
+        s1 = c.b1 * x[3] - c.a1 * y[3] + (c.b2 * x[2] - c.a2 * y[2]);
+        s2 = c.b2 * x[3] - c.a2 * y[3];
+        _mm_storeu_ps(buffer + i, v);
+    }
+#elif defined(MU_AUDIO_NEON)
+    const float32x4_t g0 = vld1q_f32(s.xGain[0]);
+    const float32x4_t g1 = vld1q_f32(s.xGain[1]);
+    const float32x4_t g2 = vld1q_f32(s.xGain[2]);
+    const float32x4_t g3 = vld1q_f32(s.xGain[3]);
+    const float32x4_t gs1 = vld1q_f32(s.s1Gain);
+    const float32x4_t gs2 = vld1q_f32(s.s2Gain);
+    alignas(16) float y[4];
+    for (; i + 4 <= sampleCount; i += 4) {
+        const float* x = buffer + i;
+        float32x4_t v = vaddq_f32(vmulq_n_f32(g0, x[0]), vmulq_n_f32(g1, x[1]));
+        v = vaddq_f32(v, vmulq_n_f32(g2, x[2]));
+        v = vaddq_f32(v, vmulq_n_f32(g3, x[3]));
+        v = vaddq_f32(v, vmulq_n_f32(gs1, s1));
+        v = vaddq_f32(v, vmulq_n_f32(gs2, s2));
+        vst1q_f32(y, v);
+
+        s1 = c.b1 * x[3] - c.a1 * y[3] + (c.b2 * x[2] - c.a2 * y[2]);
+        s2 = c.b2 * x[3] - c.a2 * y[3];
+        vst1q_f32(buffer + i, v);
+    }
+#else
+    float y[4];
+    for (; i + 4 <= sampleCount; i += 4) {
+        const float* x = buffer + i;
+        for (int k = 0; k < 4; ++k) {
+            float v = s.xGain[0][k] * x[0] + s.xGain[1][k] * x[1];
+            v = v + s.xGain[2][k] * x[2];
+            v = v + s.xGain[3][k] * x[3];
+            v = v + s.s1Gain[k] * s1;
+            y[k] = v + s.s2Gain[k] * s2;
+        }
+
+        s1 = c.b1 * x[3] - c.a1 * y[3] + (c.b2 * x[2] - c.a2 * y[2]);
+        s2 = c.b2 * x[3] - c.a2 * y[3];
+        for (int k = 0; k < 4; ++k) {
+            buffer[i + k] = y[k];
+        }
+    }
+#endif
+
+    for (; i < sampleCount; ++i) {
+        const float x = buffer[i];
+        const float y = c.b0 * x + s1;
+        s1 = c.b1 * x - c.a1 * y + s2;
+        s2 = c.b2 * x - c.a2 * y;
+        buffer[i] = y;
+    }
+
+    s.s1 = std::abs(s1) < DENORMAL_LIMIT ? 0.f : s1;
+    s.s2 = std::abs(s2) < DENORMAL_LIMIT ? 0.f : s2;
+}
@@ -0,0 +1,69 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_BIQUADCASCADE_H
+#define MU_AUDIO_BIQUADCASCADE_H
+
+namespace mu::audio {
+//! second order sections in series, run over a block of one stream
+//! in transposed direct form II. Four samples at a time are computed
+//! from the state space form of a section (see setCoefficients), so
+//! the work maps to SSE or NEON instead of a recursion per sample.
+class BiquadCascade
+{
+public:
+    static constexpr unsigned int MAX_SECTIONS = 8;
+
+    //! normalized to a0 = 1
+    struct Coefficients {
+        float b0 = 1.f, b1 = 0.f, b2 = 0.f;
+        float a1 = 0.f, a2 = 0.f;
+
+        bool isIdentity() const { return b0 == 1.f && b1 == 0.f && b2 == 0.f && a1 == 0.f && a2 == 0.f; }
+    };
+
+    unsigned int sectionCount() const;
+    void setSectionCount(unsigned int count);
+
+    void setCoefficients(unsigned int section, const Coefficients& c);
+
+    //! clear the filter state
+    void reset();
+
+    void process(float* buffer, unsigned int sampleCount);
+
+private:
+    struct Section {
+        Coefficients c;
+
+        //! y[n + k] = sum over j of x[n + j] * xGain[j][k] + s1 * s1Gain[k] + s2 * s2Gain[k]
+        alignas(16) float xGain[4][4] = {};
+        alignas(16) float s1Gain[4] = {};
+        alignas(16) float s2Gain[4] = {};
+
+        float s1 = 0.f, s2 = 0.f;
+    };
+
+    static void processSection(Section& s, float* buffer, unsigned int sampleCount);
+
+    Section m_sections[MAX_SECTIONS];
+    unsigned int m_count = 0;
+};
+}
+
+#endif // MU_AUDIO_BIQUADCASCADE_H
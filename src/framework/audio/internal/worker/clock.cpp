@@ -39,6 +39,11 @@ Clock::time_t Clock::timeInMiliSeconds() const
     return m_time * 1000 / m_sampleRate;
 }
 
+unsigned int Clock::sampleRate() const
+{
+    return m_sampleRate;
+}
+
 void Clock::setSampleRate(unsigned int sampleRate)
 {
     m_sampleRate = sampleRate;
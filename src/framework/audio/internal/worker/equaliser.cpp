@@ -21,19 +21,25 @@
 #include <cmath>
 using namespace mu::audio;
 
-Equaliser::Equaliser()
+Equaliser::Equaliser(unsigned int streamCount)
+    : m_bands(1), m_streams(streamCount)
 {
+    for (BiquadCascade& stream : m_streams) {
+        stream.setSectionCount(1);
+    }
 }
 
 unsigned int Equaliser::streamCount() const
 {
-    return 1;
+    return m_streams.size();
 }
 
 void Equaliser::setSampleRate(unsigned int sampleRate)
 {
     m_sampleRate = sampleRate;
-    calculate();
+    for (unsigned int i = 0; i < m_bands.size(); ++i) {
+        calculate(i);
+    }
 }
 
 bool Equaliser::active() const
@@ -43,56 +49,96 @@ bool Equaliser::active() const
 
 void Equaliser::setActive(bool active)
 {
+    if (active && !m_active) {
+        //! NOTE don't resume with the state the filters had when they were switched off
+        for (BiquadCascade& stream : m_streams) {
+            stream.reset();
+        }
+    }
     m_active = active;
 }
 
-void Equaliser::process(float* input, float* output, unsigned int sampleCount)
+unsigned int Equaliser::bandCount() const
 {
-    for (unsigned int i = 0; i < sampleCount; ++i) {
-        m_x[2] = m_x[1];
-        m_x[1] = m_x[0];
-        m_x[0] = input[i];
+    return m_bands.size();
+}
 
-        m_y[2] = m_y[1];
-        m_y[1] = m_y[0];
-        m_y[0] = (m_b[2] * m_x[2] + m_b[1] * m_x[1] + m_b[0] * m_x[0] - m_a[1] * m_y[1] - m_a[2] * m_y[2]) / m_a[0];
+void Equaliser::setBandCount(unsigned int count)
+{
+    IF_ASSERT_FAILED(count <= MAX_BANDS) {
+        count = MAX_BANDS;
+    }
+    unsigned int oldCount = m_bands.size();
+    m_bands.resize(count);
+    for (BiquadCascade& stream : m_streams) {
+        stream.setSectionCount(count);
+    }
+    for (unsigned int i = oldCount; i < count; ++i) {
+        calculate(i);
+    }
+}
 
-        output[i] = m_y[0];
+void Equaliser::setBand(unsigned int band, float frequency, float gain, float q)
+{
+    IF_ASSERT_FAILED(band < m_bands.size()) {
+        return;
     }
+    m_bands[band] = { frequency, gain, q };
+    calculate(band);
 }
 
-void Equaliser::calculate()
+void Equaliser::process(float** buffers, unsigned int sampleCount)
+{
+    for (unsigned int i = 0; i < m_streams.size(); ++i) {
+        m_streams[i].process(buffers[i], sampleCount);
+    }
+}
+
+//---------------------------------------------------------
+//   calculate
+//    peaking filter of the Audio EQ Cookbook (R. Bristow-Johnson)
+//---------------------------------------------------------
+
+void Equaliser::calculate(unsigned int band)
 {
     if (!m_sampleRate) {
         return;
     }
-    float a = std::pow(10.f, m_gain / 40.f);
-    float w0 = 2 * M_PI * m_frequency / m_sampleRate;
-    float alpha = std::sin(w0) * a / (2 * m_q);
 
-    m_b[0] = 1 + alpha * a;
-    m_b[1] = -2 * std::cos(w0);
-    m_b[2] = 1 - alpha * a;
+    const Band& b = m_bands[band];
+    BiquadCascade::Coefficients c;
+    if (b.gain != 0.f) {
+        float a = std::pow(10.f, b.gain / 40.f);
+        float w0 = 2 * M_PI * b.frequency / m_sampleRate;
+        float alpha = std::sin(w0) / (2 * b.q);
+        float a0 = 1 + alpha / a;
+
+        c.b0 = (1 + alpha * a) / a0;
+        c.b1 = -2 * std::cos(w0) / a0;
+        c.b2 = (1 - alpha * a) / a0;
+        c.a1 = c.b1;
+        c.a2 = (1 - alpha / a) / a0;
+    }
 
-    m_a[0] = 1 + alpha / a;
-    m_a[1] = -2 * std::cos(w0);
-    m_a[2] = 1 - alpha / a;
+    for (BiquadCascade& stream : m_streams) {
+        stream.setCoefficients(band, c);
+    }
 }
 
 void mu::audio::Equaliser::setFrequency(float value)
 {
-    m_frequency = value;
-    calculate();
+    m_bands[0].frequency = value;
+    calculate(0);
 }
 
 void mu::audio::Equaliser::setGain(float value)
 {
-    m_gain = value;
-    calculate();
+    m_bands[0].gain = value;
+    calculate(0);
 }
 
 void mu::audio::Equaliser::setQ(float value)
 {
-    m_q = value;
-    calculate();
+    m_bands[0].q = value;
+    calculate(0);
 }
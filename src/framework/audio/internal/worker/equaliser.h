@@ -19,13 +19,20 @@
 #ifndef MU_AUDIO_EQUALISER_H
 #define MU_AUDIO_EQUALISER_H
 
+#include <vector>
+
 #include "iaudioprocessor.h"
+#include "biquadcascade.h"
 
 namespace mu::audio {
+//! parametric equaliser: peaking bands in series, the same bands on every stream.
+//! A band with no gain is flat and is skipped.
 class Equaliser : public IAudioProcessor
 {
 public:
-    Equaliser();
+    static constexpr unsigned int MAX_BANDS = BiquadCascade::MAX_SECTIONS;
+
+    Equaliser(unsigned int streamCount = 1);
 
     unsigned int streamCount() const override;
     void setSampleRate(unsigned int sampleRate) override;
@@ -33,23 +40,33 @@ public:
     bool active() const override;
     void setActive(bool active) override;
 
+    unsigned int bandCount() const;
+    void setBandCount(unsigned int count);
+
+    //! gain in dB
+    void setBand(unsigned int band, float frequency, float gain, float q);
+
+    //! parameters of the first band
     void setFrequency(float value);
     void setGain(float value);
     void setQ(float value);
 
-    void process(float* input, float* output, unsigned int sampleCount) override;
+    void process(float** buffers, unsigned int sampleCount) override;
 
 private:
-    void calculate();
+    struct Band {
+        float frequency = 1'000.f;
+        float gain = 0.f;
+        float q = 1.f;
+    };
+
+    void calculate(unsigned int band);
 
     unsigned int m_sampleRate = 0;
     bool m_active = true;
 
-    float m_gain = 0, m_frequency = 1'000.f, m_q = 1.f;
-    float m_a[3] = { 0, 0, 0 };
-    float m_b[3] = { 0, 0, 0 };
-    float m_x[3] = { 0, 0, 0 };
-    float m_y[3] = { 0, 0, 0 };
+    std::vector<Band> m_bands;
+    std::vector<BiquadCascade> m_streams;
 };
 }
 
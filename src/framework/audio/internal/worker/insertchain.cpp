@@ -0,0 +1,101 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "insertchain.h"
+
+#include "log.h"
+
+using namespace mu::audio;
+
+IAudioProcessorPtr InsertChain::processor(unsigned int number) const
+{
+    IF_ASSERT_FAILED(m_processors.find(number) != m_processors.end()) {
+        return nullptr;
+    }
+    return m_processors.at(number);
+}
+
+void InsertChain::setProcessor(unsigned int number, IAudioProcessorPtr proc)
+{
+    m_processors[number] = proc;
+
+    m_chain.clear();
+    for (auto& p : m_processors) {
+        m_chain.push_back(p.second.get());
+    }
+}
+
+void InsertChain::setSampleRate(unsigned int sampleRate)
+{
+    for (auto& p : m_processors) {
+        p.second->setSampleRate(sampleRate);
+    }
+}
+
+void InsertChain::setBufferSize(unsigned int samples, unsigned int streamCount)
+{
+    if (m_planar.size() < samples * streamCount) {
+        m_planar.resize(samples * streamCount);
+    }
+    m_streams.reserve(streamCount);
+}
+
+bool InsertChain::active() const
+{
+    for (const IAudioProcessor* proc : m_chain) {
+        if (proc->active()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void InsertChain::process(float* buffer, unsigned int streamCount, unsigned int sampleCount)
+{
+    //! NOTE a mono block is planar already
+    const bool split = streamCount > 1;
+    if (split) {
+        if (m_planar.size() < sampleCount * streamCount) {
+            LOGW() << "insert buffer is too small, the block is left unprocessed";
+            return;
+        }
+        m_streams.resize(streamCount);
+        for (unsigned int s = 0; s < streamCount; ++s) {
+            m_streams[s] = m_planar.data() + s * sampleCount;
+            for (unsigned int i = 0; i < sampleCount; ++i) {
+                m_streams[s][i] = buffer[i * streamCount + s];
+            }
+        }
+    } else {
+        m_streams.assign(1, buffer);
+    }
+
+    for (IAudioProcessor* proc : m_chain) {
+        if (proc->active()) {
+            proc->process(m_streams.data(), sampleCount);
+        }
+    }
+
+    if (split) {
+        for (unsigned int s = 0; s < streamCount; ++s) {
+            for (unsigned int i = 0; i < sampleCount; ++i) {
+                buffer[i * streamCount + s] = m_streams[s][i];
+            }
+        }
+    }
+}
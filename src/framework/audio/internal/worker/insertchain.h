@@ -0,0 +1,54 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_INSERTCHAIN_H
+#define MU_AUDIO_INSERTCHAIN_H
+
+#include <map>
+#include <vector>
+
+#include "iaudioprocessor.h"
+
+namespace mu::audio {
+//! the insert slots of a mixer channel or of the master, run in the order of their numbers.
+//! The interleaved block is split into planar streams once for all active inserts and
+//! merged back after the last one; a chain with no active insert doesn't touch the block.
+class InsertChain
+{
+public:
+    IAudioProcessorPtr processor(unsigned int number) const;
+    void setProcessor(unsigned int number, IAudioProcessorPtr proc);
+
+    void setSampleRate(unsigned int sampleRate);
+    void setBufferSize(unsigned int samples, unsigned int streamCount);
+
+    //! true if any insert is active, false if the whole chain is bypassed
+    bool active() const;
+
+    void process(float* buffer, unsigned int streamCount, unsigned int sampleCount);
+
+private:
+    std::map<unsigned int, IAudioProcessorPtr> m_processors;
+    std::vector<IAudioProcessor*> m_chain;      // m_processors in slot order, walked by the audio thread
+
+    std::vector<float> m_planar;
+    std::vector<float*> m_streams;
+};
+}
+
+#endif // MU_AUDIO_INSERTCHAIN_H
@@ -34,12 +34,12 @@ static tick_t REQUEST_BUFFER_SIZE = 480 * 4 * 10; // about 10 measures of 4/4 ti
 
 MIDIPlayer::MIDIPlayer()
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
 }
 
 MIDIPlayer::~MIDIPlayer()
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     if (isRunning()) {
         stop();
     }
@@ -47,13 +47,13 @@ MIDIPlayer::~MIDIPlayer()
 
 IPlayer::Status MIDIPlayer::status() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     return m_status;
 }
 
 void MIDIPlayer::setStatus(const Status& status)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     if (m_status == status) {
         return;
     }
@@ -63,19 +63,25 @@ void MIDIPlayer::setStatus(const Status& status)
 
 mu::async::Channel<IPlayer::Status> MIDIPlayer::statusChanged() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     return m_statusChanged;
 }
 
+void MIDIPlayer::setClock(std::shared_ptr<Clock> clock)
+{
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
+    m_clock = clock;
+}
+
 bool MIDIPlayer::isRunning() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     return m_status == Status::Running;
 }
 
 void MIDIPlayer::loadMIDI(const std::shared_ptr<MidiStream>& stream)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     m_midiStream = stream;
     m_streamState.reset();
 
@@ -147,7 +153,7 @@ void MIDIPlayer::onChunkReceived(const Chunk& chunk)
 
 void MIDIPlayer::forwardTime(unsigned long milliseconds)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     if (!isRunning()) {
         return;
     }
@@ -303,7 +309,7 @@ bool MIDIPlayer::sendEvents(tick_t fromTick, tick_t toTick)
         ChanState& chState = m_chanStates[event.channel()];
         if (event && !chState.muted) {
             auto s = synth(event.channel());
-            s->handleEvent(event);
+            s->scheduleEvent(event, sampleOffset(pos->first));
             s->setIsActive(true);
 
             if (event.isChannelVoice() && event.opcode() == midi::Event::Opcode::NoteOn) {
@@ -337,7 +343,7 @@ void MIDIPlayer::sendClear()
 
 void MIDIPlayer::run()
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     if (m_midiStream && status() != Status::Error) {
         setStatus(Status::Running);
     }
@@ -345,7 +351,7 @@ void MIDIPlayer::run()
 
 void MIDIPlayer::stop()
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     if (status() != Status::Error) {
         setStatus(Status::Stoped);
     }
@@ -354,7 +360,7 @@ void MIDIPlayer::stop()
 
 void MIDIPlayer::pause()
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     if (status() != Status::Error) {
         setStatus(Status::Paused);
     }
@@ -363,19 +369,19 @@ void MIDIPlayer::pause()
 
 unsigned long MIDIPlayer::milliseconds() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     return m_curMSec;
 }
 
 mu::async::Channel<tick_t> MIDIPlayer::tickPlayed() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     return m_onTickPlayed;
 }
 
 void MIDIPlayer::seek(unsigned long milliseconds)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     m_curMSec = milliseconds;
     m_prevMSec = milliseconds;
 
@@ -462,15 +468,45 @@ tick_t MIDIPlayer::tick(uint64_t msec) const
     return t.startTicks + ticks;
 }
 
+double MIDIPlayer::msec(tick_t tick) const
+{
+    const TempoItem* t = nullptr;
+    for (const auto& it : m_tempoMap) {
+        if (t && it.second.startTicks > tick) {
+            break;
+        }
+        t = &it.second;
+    }
+
+    if (!t) {
+        return 0.0;
+    }
+    return t->startMsec + (tick - t->startTicks) * t->onetickMsec;
+}
+
+//! NOTE the block being rendered starts at m_prevMSec, sendEvents() is called before it moves on
+unsigned int MIDIPlayer::sampleOffset(tick_t tick) const
+{
+    if (!m_clock) {
+        return 0;
+    }
+
+    double offsetMsec = (msec(tick) - m_prevMSec) / m_playSpeed;
+    if (offsetMsec <= 0.0) {
+        return 0;
+    }
+    return static_cast<unsigned int>(offsetMsec * m_clock->sampleRate() / 1000.0);
+}
+
 float MIDIPlayer::playbackSpeed() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     return m_playSpeed;
 }
 
 void MIDIPlayer::setPlaybackSpeed(float speed)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     m_playSpeed = speed;
 }
 
@@ -489,7 +525,7 @@ bool MIDIPlayer::hasTrack(track_t ti) const
 
 void MIDIPlayer::setIsTrackMuted(track_t trackIndex, bool mute)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     IF_ASSERT_FAILED(hasTrack(trackIndex)) {
         return;
     }
@@ -508,7 +544,7 @@ void MIDIPlayer::setIsTrackMuted(track_t trackIndex, bool mute)
 
 void MIDIPlayer::setTrackVolume(track_t trackIndex, float volume)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     IF_ASSERT_FAILED(hasTrack(trackIndex)) {
         return;
     }
@@ -521,7 +557,7 @@ void MIDIPlayer::setTrackVolume(track_t trackIndex, float volume)
 
 void MIDIPlayer::setTrackBalance(track_t trackIndex, float balance)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     IF_ASSERT_FAILED(hasTrack(trackIndex)) {
         return;
     }
@@ -32,6 +32,7 @@
 #include "async/asyncable.h"
 #include "isynthesizersregister.h"
 #include "midi/imidiportdatasender.h"
+#include "clock.h"
 
 namespace mu::audio {
 class MIDIPlayer : public IMIDIPlayer, public async::Asyncable
@@ -68,6 +69,11 @@ public:
     void setTrackVolume(midi::track_t trackIndex, float volume) override;
     void setTrackBalance(midi::track_t trackIndex, float balance) override;
 
+    // Self
+
+    //! events are stamped with their sample offset into the block being rendered at the clock's sample rate
+    void setClock(std::shared_ptr<Clock> clock);
+
 private:
 
     void setStatus(const Status& status);
@@ -86,6 +92,8 @@ private:
 
     void setCurrentMSec(uint64_t msec);
     midi::tick_t tick(uint64_t msec) const;
+    double msec(midi::tick_t tick) const;
+    unsigned int sampleOffset(midi::tick_t tick) const;
 
     bool hasTrack(midi::track_t num) const;
 
@@ -101,6 +109,7 @@ private:
     std::map<uint8_t, midi::Event> m_noteCache = {};
 
     float m_playSpeed = 1.f;
+    std::shared_ptr<Clock> m_clock;
 
     midi::msec_t m_prevMSec = 0;
     midi::msec_t m_curMSec = 0;
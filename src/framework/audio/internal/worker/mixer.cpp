@@ -17,6 +17,10 @@
 //  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 //=============================================================================
 #include "mixer.h"
+
+#include <algorithm>
+#include <chrono>
+
 #include "log.h"
 #include "internal/audiosanitizer.h"
 
@@ -24,41 +28,41 @@ using namespace mu::audio;
 
 Mixer::Mixer()
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
 }
 
 Mixer::~Mixer()
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
 }
 
 IAudioSourcePtr Mixer::mixedSource()
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     return shared_from_this();
 }
 
 Mixer::Mode Mixer::mode() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     return m_mode;
 }
 
 void Mixer::setMode(const Mixer::Mode& mode)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     m_mode = mode;
 }
 
 void Mixer::setClock(std::shared_ptr<Clock> clock)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     m_clock = clock;
 }
 
 void Mixer::setSampleRate(unsigned int sampleRate)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     AbstractAudioSource::setSampleRate(sampleRate);
     for (auto& input : m_inputList) {
         input.second->setSampleRate(sampleRate);
@@ -66,11 +70,30 @@ void Mixer::setSampleRate(unsigned int sampleRate)
     if (m_clock) {
         m_clock->setSampleRate(sampleRate);
     }
+    m_inserts.setSampleRate(sampleRate);
+}
+
+unsigned int Mixer::renderThreadCount() const
+{
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
+    return std::min(m_renderThreadCount, RenderPool::instance()->threadCount());
+}
+
+void Mixer::setRenderThreadCount(unsigned int count)
+{
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
+    m_renderThreadCount = std::max(1u, count);
+}
+
+float Mixer::cpuHeadroom() const
+{
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
+    return m_cpuHeadroom;
 }
 
 unsigned int Mixer::streamCount() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     switch (m_mode) {
     case MONO: return 1;
     case STEREO: return 2;
@@ -82,32 +105,30 @@ unsigned int Mixer::streamCount() const
 
 void Mixer::setLevel(float level)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     m_masterLevel = level;
 }
 
 std::shared_ptr<IAudioProcessor> Mixer::processor(unsigned int number) const
 {
-    ONLY_AUDIO_WORKER_THREAD;
-    IF_ASSERT_FAILED(m_insertList.find(number) != m_insertList.end()) {
-        return nullptr;
-    }
-    return m_insertList.at(number);
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
+    return m_inserts.processor(number);
 }
 
 void Mixer::setProcessor(unsigned int number, std::shared_ptr<IAudioProcessor> insert)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     IF_ASSERT_FAILED(insert->streamCount() == streamCount()) {
         LOGE() << "Insert's stream count not equal to the channel";
         return;
     }
-    m_insertList[number] = insert;
+    insert->setSampleRate(m_sampleRate);
+    m_inserts.setProcessor(number, insert);
 }
 
 IMixer::ChannelID Mixer::addChannel(std::shared_ptr<IAudioSource> source)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     auto lastId = (m_inputList.size() > 0 ? m_inputList.rbegin()->first : -1);
     auto newId = lastId + 1;
 
@@ -122,31 +143,31 @@ IMixer::ChannelID Mixer::addChannel(std::shared_ptr<IAudioSource> source)
 
 void Mixer::removeChannel(ChannelID channelId)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     m_inputList.erase(channelId);
 }
 
 void Mixer::setActive(ChannelID channelId, bool active)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     m_inputList[channelId]->setActive(active);
 }
 
 void Mixer::setLevel(ChannelID channelId, unsigned int streamId, float level)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     m_inputList[channelId]->setLevel(streamId, level);
 }
 
 void Mixer::setBalance(ChannelID channelId, unsigned int streamId, std::complex<float> balance)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     m_inputList[channelId]->setBalance(streamId, balance);
 }
 
 std::shared_ptr<IMixerChannel> Mixer::channel(unsigned int number) const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     IF_ASSERT_FAILED(m_inputList.find(number) != m_inputList.end()) {
         return nullptr;
     }
@@ -155,34 +176,48 @@ std::shared_ptr<IMixerChannel> Mixer::channel(unsigned int number) const
 
 void Mixer::setBufferSize(unsigned int samples)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
     AbstractAudioSource::setBufferSize(samples);
     for (auto& input : m_inputList) {
         input.second->setBufferSize(samples);
     }
+    m_inserts.setBufferSize(samples, streamCount());
 }
 
 void Mixer::forward(unsigned int sampleCount)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
+    auto renderStart = std::chrono::steady_clock::now();
     std::fill(m_buffer.begin(), m_buffer.end(), 0.f);
 
     if (m_clock) {
         m_clock->forward(sampleCount);
     }
 
+    //! NOTE the channels don't share state, so they are rendered in parallel;
+    //! they are mixed afterwards in channel order, so the result doesn't depend on the thread count
+    m_renderList.clear();
+    for (auto& input : m_inputList) {
+        m_renderList.push_back(input.second.get());
+    }
+    RenderPool::instance()->run(m_renderList.size(), [this, sampleCount](size_t i) {
+        m_renderList[i]->forward(sampleCount);
+    }, m_renderThreadCount);
+
     for (auto& input : m_inputList) {
-        input.second->forward(sampleCount);
         mixinChannel(input.second, sampleCount);
     }
 
-    for (auto& insert : m_insertList) {
-        if (insert.second->active()) {
-            insert.second->process(m_buffer.data(), m_buffer.data(), sampleCount);
-        }
+    if (m_inserts.active()) {
+        m_inserts.process(m_buffer.data(), streamCount(), sampleCount);
     }
     std::transform(m_buffer.begin(), m_buffer.end(), m_buffer.begin(),
                    [this](float sample) -> float { return sample * m_masterLevel; });
+
+    if (m_sampleRate > 0 && sampleCount > 0) {
+        std::chrono::duration<float> renderTime = std::chrono::steady_clock::now() - renderStart;
+        m_cpuHeadroom = 1.f - renderTime.count() * m_sampleRate / sampleCount;
+    }
 }
 
 void Mixer::mixinChannel(std::shared_ptr<MixerChannel> channel, unsigned int samplesCount)
@@ -203,23 +238,34 @@ void Mixer::mixinChannel(std::shared_ptr<MixerChannel> channel, unsigned int sam
 
 void Mixer::mixinChannelStream(std::shared_ptr<MixerChannel> channel, unsigned int streamId, unsigned int samplesCount)
 {
+    auto channelBuffer = channel->data();
+    if (!channelBuffer) {
+        return;
+    }
+
     auto balance = channel->balance(streamId).real();
     auto level = channel->level(streamId);
+    const unsigned int outStreams = streamCount();
+    const unsigned int inStreams = channel->streamCount();
+
+    //! NOTE the gains don't change within a block
+    float gains[2] = { 0.f, 0.f };
+    for (unsigned int j = 0; j < outStreams; ++j) {
+        //linear cross
+        float gain = 0.5f * balance * ((j * 2.f) - 1) + 0.5f;
+        if (gain < 0) {
+            gain = 0;
+        }
+        if (gain > 1) {
+            gain = 1;
+        }
+        gains[j] = gain * level;
+    }
+
     for (unsigned int i = 0; i < samplesCount; ++i) {
-        for (unsigned int j = 0; j < streamCount(); ++j) {
-            //linear cross
-            float gain = 0.5f * balance * ((j * 2.f) - 1) + 0.5f;
-            if (gain < 0) {
-                gain = 0;
-            }
-            if (gain > 1) {
-                gain = 1;
-            }
-
-            auto channelBuffer = channel->data();
-            if (channelBuffer) {
-                m_buffer[i * streamCount() + j] += gain * level * channelBuffer[i * channel->streamCount() + streamId];
-            }
+        const float sample = channelBuffer[i * inStreams + streamId];
+        for (unsigned int j = 0; j < outStreams; ++j) {
+            m_buffer[i * outStreams + j] += gains[j] * sample;
         }
     }
 }
@@ -21,10 +21,13 @@
 
 #include <memory>
 #include <map>
+#include <vector>
 #include "imixer.h"
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
+#include "insertchain.h"
 #include "clock.h"
+#include "renderpool.h"
 
 namespace mu::audio {
 class Mixer : public IMixer, public AbstractAudioSource, public std::enable_shared_from_this<Mixer>
@@ -65,6 +68,14 @@ public:
 
     void setClock(std::shared_ptr<Clock> clock);
 
+    //! channels are rendered in parallel on up to this many threads of the render pool,
+    //! then mixed in channel order
+    unsigned int renderThreadCount() const;
+    void setRenderThreadCount(unsigned int count);
+
+    //! share of the last block's duration that was left after rendering it, 1 - load
+    float cpuHeadroom() const;
+
 private:
     //! mix the channel in to the buffer
     void mixinChannel(std::shared_ptr<MixerChannel> channel, unsigned int samplesCount);
@@ -73,8 +84,12 @@ private:
     Mode m_mode = STEREO;
     float m_masterLevel = 1.f;
     std::map<ChannelID, std::shared_ptr<MixerChannel> > m_inputList = {};
-    std::map<unsigned int, std::shared_ptr<IAudioProcessor> > m_insertList = {};
+    InsertChain m_inserts;
     std::shared_ptr<Clock> m_clock;
+
+    unsigned int m_renderThreadCount = RenderPool::defaultThreadCount();
+    std::vector<MixerChannel*> m_renderList;
+    float m_cpuHeadroom = 1.f;
 };
 }
 
@@ -39,6 +39,7 @@ void MixerChannel::checkStreams()
 {
     if (streamCount() != m_level.size()) {
         updateBalanceLevelMaps();
+        updateBuffers();
     }
 }
 
@@ -49,23 +50,46 @@ void MixerChannel::forward(unsigned int sampleCount)
     }
     m_source->forward(sampleCount);
 
-    //you can use source's buffer as pre proccesing KEY, current buffer as post processing KEY
-    std::memcpy(m_buffer.data(), m_source->data(), m_buffer.size() * sizeof(float));
+    //! NOTE the source may have changed its stream count, with this block at the latest
+    checkStreams();
 
-    for (std::pair<const unsigned int, IAudioProcessorPtr>& p : m_processorList) {
-        if (p.second->active()) {
-            p.second->process(m_buffer.data(), m_buffer.data(), sampleCount);
-        }
+    //! NOTE with all inserts bypassed the source's buffer is mixed as it is
+    if (!m_inserts.active()) {
+        m_output = m_source->data();
+        return;
+    }
+
+    const size_t samples = size_t(sampleCount) * streamCount();
+    IF_ASSERT_FAILED(m_buffer.size() >= samples) {
+        m_output = m_source->data();
+        return;
     }
+
+    //you can use source's buffer as pre proccesing KEY, current buffer as post processing KEY
+    std::memcpy(m_buffer.data(), m_source->data(), samples * sizeof(float));
+    m_inserts.process(m_buffer.data(), streamCount(), sampleCount);
+    m_output = m_buffer.data();
+}
+
+const float* MixerChannel::data() const
+{
+    return m_output ? m_output : m_buffer.data();
 }
 
 void MixerChannel::setBufferSize(unsigned int samples)
 {
-    AbstractAudioSource::setBufferSize(samples);
+    m_bufferSamples = samples;
     IF_ASSERT_FAILED(m_source) {
         return;
     }
     m_source->setBufferSize(samples);
+    updateBuffers();
+}
+
+void MixerChannel::updateBuffers()
+{
+    AbstractAudioSource::setBufferSize(m_bufferSamples);
+    m_inserts.setBufferSize(m_bufferSamples, streamCount());
 }
 
 void MixerChannel::setSampleRate(unsigned int sampleRate)
@@ -75,17 +99,18 @@ void MixerChannel::setSampleRate(unsigned int sampleRate)
         return;
     }
     m_source->setSampleRate(sampleRate);
-    for (std::pair<const unsigned int, IAudioProcessorPtr>& p : m_processorList) {
-        p.second->setSampleRate(sampleRate);
-    }
+    m_inserts.setSampleRate(sampleRate);
 }
 
 void MixerChannel::setSource(std::shared_ptr<IAudioSource> source)
 {
     m_source = source;
+    m_output = nullptr;
     updateBalanceLevelMaps();
+    updateBuffers();
     m_source->streamsCountChanged().onReceive(this, [this](unsigned int) {
         updateBalanceLevelMaps();
+        updateBuffers();
     });
     setActive(true);
 }
@@ -142,10 +167,7 @@ void MixerChannel::setBalance(unsigned int streamId, std::complex<float> value)
 
 IAudioProcessorPtr MixerChannel::processor(unsigned int number) const
 {
-    IF_ASSERT_FAILED(m_processorList.find(number) != m_processorList.end()) {
-        return nullptr;
-    }
-    return m_processorList.at(number);
+    return m_inserts.processor(number);
 }
 
 void MixerChannel::setProcessor(unsigned int number, IAudioProcessorPtr proc)
@@ -155,7 +177,7 @@ void MixerChannel::setProcessor(unsigned int number, IAudioProcessorPtr proc)
         return;
     }
     proc->setSampleRate(m_sampleRate);
-    m_processorList[number] = proc;
+    m_inserts.setProcessor(number, proc);
 }
 
 void MixerChannel::updateBalanceLevelMaps()
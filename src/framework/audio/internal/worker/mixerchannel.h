@@ -27,6 +27,7 @@
 #include "iaudioprocessor.h"
 #include "imixerchannel.h"
 #include "abstractaudiosource.h"
+#include "insertchain.h"
 
 namespace mu::audio {
 class MixerChannel : public IMixerChannel, public AbstractAudioSource, public async::Asyncable
@@ -37,6 +38,7 @@ public:
     unsigned int streamCount() const override;
     void checkStreams();
     void forward(unsigned int sampleCount) override;
+    const float* data() const override;
     void setBufferSize(unsigned int samples) override;
     void setSampleRate(unsigned int sampleRate) override;
 
@@ -59,11 +61,18 @@ public:
 protected:
     void updateBalanceLevelMaps();
 
+    //! sizes m_buffer and the insert buffers for the source's current stream count
+    void updateBuffers();
+
     bool m_active = false;
     std::shared_ptr<IAudioSource> m_source = nullptr;
     std::map<unsigned int, std::complex<float> > m_balance = {};
     std::map<unsigned int, float> m_level = {};
-    std::map<unsigned int, IAudioProcessorPtr > m_processorList = {};
+    InsertChain m_inserts;
+    unsigned int m_bufferSamples = 0;
+
+    //! the source's buffer if no insert ran over the last block, m_buffer otherwise
+    const float* m_output = nullptr;
 };
 }
 
@@ -0,0 +1,148 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "renderpool.h"
+
+#include <algorithm>
+
+#include "internal/audiosanitizer.h"
+
+using namespace mu::audio;
+
+RenderPool* RenderPool::instance()
+{
+    static RenderPool pool;
+    return &pool;
+}
+
+RenderPool::RenderPool(unsigned int threadCount)
+{
+    for (unsigned int i = 1; i < threadCount; ++i) {
+        m_threads.emplace_back(&RenderPool::threadMain, this);
+    }
+}
+
+RenderPool::~RenderPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_startCondition.notify_all();
+    for (std::thread& t : m_threads) {
+        t.join();
+    }
+}
+
+unsigned int RenderPool::defaultThreadCount()
+{
+#ifdef __EMSCRIPTEN__
+    return 1;
+#else
+    return std::max(1u, std::thread::hardware_concurrency());
+#endif
+}
+
+unsigned int RenderPool::threadCount() const
+{
+    return static_cast<unsigned int>(m_threads.size()) + 1;
+}
+
+void RenderPool::run(size_t taskCount, const std::function<void(size_t)>& task, unsigned int maxThreads)
+{
+    std::unique_lock<std::mutex> runLock(m_runMutex, std::defer_lock);
+    if (m_threads.empty() || maxThreads < 2 || taskCount < 2 || !runLock.try_lock()) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    //! NOTE a thread that woke up late for the previous block may still be looking for tasks,
+    //! the new ones are set under the lock it takes to start looking
+    waitIdle();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [this]() { return m_busyThreads == 0; });
+        m_task = &task;
+        m_taskCount = taskCount;
+        m_nextTask = 0;
+        m_maxHelpers = maxThreads - 1;
+        ++m_generation;
+    }
+    m_startCondition.notify_all();
+
+    work();
+
+    waitIdle();
+}
+
+//! NOTE the calling thread took its share of the tasks, the others are short of finishing theirs:
+//! it spins a little before it sleeps, a wake up could take longer than the tasks left
+void RenderPool::waitIdle()
+{
+    for (int i = 0; i < SPIN_COUNT; ++i) {
+        if (m_busyThreads.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this]() { return m_busyThreads == 0; });
+}
+
+void RenderPool::work()
+{
+    for (size_t i = m_nextTask++; i < m_taskCount; i = m_nextTask++) {
+        (*m_task)(i);
+    }
+}
+
+void RenderPool::threadMain()
+{
+    //! NOTE the tasks are run on behalf of the audio worker thread, which waits for them
+    AudioSanitizer::setupRenderThread();
+
+    unsigned long seenGeneration = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        seenGeneration = m_generation;
+    }
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCondition.wait(lock, [this, seenGeneration]() { return m_quit || m_generation != seenGeneration; });
+            if (m_quit) {
+                return;
+            }
+            seenGeneration = m_generation;
+            if (m_busyThreads >= m_maxHelpers) {
+                continue;
+            }
+            ++m_busyThreads;
+        }
+
+        work();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busyThreads == 0) {
+            m_doneCondition.notify_all();
+        }
+    }
+}
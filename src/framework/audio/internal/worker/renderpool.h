@@ -0,0 +1,81 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_RENDERPOOL_H
+#define MU_AUDIO_RENDERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mu::audio {
+//! Renders the independent parts of one audio block in parallel.
+//! run() hands out the tasks one by one to whichever thread is free,
+//! so a long task (a busy synthesizer) does not hold back the others;
+//! the calling thread works on them too and returns when all are done.
+//! One pool serves the process: a caller that finds it busy with another
+//! block (an offline render next to playback) runs its tasks by itself.
+class RenderPool
+{
+public:
+    static RenderPool* instance();
+
+    explicit RenderPool(unsigned int threadCount = defaultThreadCount());
+    ~RenderPool();
+
+    RenderPool(const RenderPool&) = delete;
+    RenderPool& operator=(const RenderPool&) = delete;
+
+    static unsigned int defaultThreadCount();
+
+    //! number of threads working on a block, the calling thread included
+    unsigned int threadCount() const;
+
+    //! maxThreads limits the threads working on this block, the calling thread included
+    void run(size_t taskCount, const std::function<void(size_t)>& task, unsigned int maxThreads);
+
+private:
+    //! the caller spins this many times for the threads to finish their tasks, then waits
+    static constexpr int SPIN_COUNT = 2000;
+
+    void threadMain();
+    void work();
+    void waitIdle();
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_runMutex;
+    std::mutex m_mutex;
+    std::condition_variable m_startCondition;
+    std::condition_variable m_doneCondition;
+    bool m_quit = false;
+    unsigned long m_generation = 0;
+    unsigned int m_maxHelpers = 0;
+    std::atomic<unsigned int> m_busyThreads { 0 };
+
+    const std::function<void(size_t)>* m_task = nullptr;
+    size_t m_taskCount = 0;
+    std::atomic<size_t> m_nextTask { 0 };
+};
+}
+
+#endif // MU_AUDIO_RENDERPOOL_H
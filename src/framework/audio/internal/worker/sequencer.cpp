@@ -259,6 +259,7 @@ Sequencer::MidiTrack Sequencer::midiTrack(TrackID id) const
 Sequencer::MidiTrack Sequencer::createMIDITrack(TrackID id)
 {
     auto player = std::make_shared<MIDIPlayer>();
+    player->setClock(m_clock);
     m_tracks[id] = player;
     return player;
 }
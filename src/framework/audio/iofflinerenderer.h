@@ -0,0 +1,64 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_IOFFLINERENDERER_H
+#define MU_AUDIO_IOFFLINERENDERER_H
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "modularity/imoduleexport.h"
+#include "ret.h"
+#include "midi/miditypes.h"
+
+namespace mu::audio {
+//! Renders a midi stream to audio without the audio driver, as fast as the CPU allows.
+//! Each render has its own synthesizers, player and mixer, so it doesn't disturb playback
+//! and several renders (stems) can run at the same time.
+class IOfflineRenderer : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IOfflineRenderer)
+public:
+    virtual ~IOfflineRenderer() = default;
+
+    //! receives the rendered audio block by block as interleaved stereo;
+    //! returning false stops the render
+    using BlockWriter = std::function<bool (const float* data, unsigned int frames)>;
+
+    struct Options {
+        unsigned int sampleRate = 44100;
+        unsigned int blockSize = 1024;
+    };
+
+    struct Job {
+        std::set<midi::track_t> tracks;     //! tracks to render, all if empty
+        BlockWriter writer;
+    };
+
+    //! renders the jobs in parallel and returns when all are done.
+    //! It blocks the calling thread for the whole render, the writers are called on the render threads;
+    //! a writer returning false is the way to cancel from another thread
+    virtual Ret render(const std::shared_ptr<midi::MidiStream>& stream, const Options& options, const std::vector<Job>& jobs) = 0;
+};
+
+using IOfflineRendererPtr = std::shared_ptr<IOfflineRenderer>;
+}
+
+#endif // MU_AUDIO_IOFFLINERENDERER_H
@@ -46,6 +46,9 @@ public:
 
     virtual Ret setupChannels(const std::vector<midi::Event>& events) = 0;
     virtual bool handleEvent(const midi::Event& e) = 0;
+    //! handle e sampleOffset samples into the next block rendered by writeBuf() or forward().
+    //! A synthesizer may round the offset up to its own rendering granularity
+    virtual void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) = 0;
     virtual void writeBuf(float* stream, unsigned int samples) = 0;
 
     virtual void allSoundsOff() = 0; // all channels
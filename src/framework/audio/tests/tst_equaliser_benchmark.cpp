@@ -0,0 +1,295 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "audio/internal/audiosanitizer.h"
+#include "audio/internal/worker/abstractaudiosource.h"
+#include "audio/internal/worker/equaliser.h"
+#include "audio/internal/worker/mixer.h"
+
+using namespace mu::audio;
+
+static const unsigned int SAMPLE_RATE = 44100;
+static const unsigned int FRAMES = 512;
+static const int CHANNELS = 64;
+
+struct BandSetting {
+    float frequency;
+    float gain;
+    float q;
+};
+
+static const BandSetting BANDS[] = {
+    { 100.f, 6.f, 0.7f },
+    { 500.f, -3.f, 1.f },
+    { 2'000.f, 4.f, 2.f },
+    { 8'000.f, -6.f, 0.7f }
+};
+
+//---------------------------------------------------------
+//   BlockSource
+//    stereo source that only copies a prepared block, so
+//    the mixer and its inserts are what is measured
+//---------------------------------------------------------
+
+class BlockSource : public AbstractAudioSource
+{
+    std::vector<float> m_block;
+
+public:
+    BlockSource(unsigned int seed)
+        : m_block(2 * FRAMES)
+    {
+        for (unsigned int i = 0; i < FRAMES; ++i) {
+            m_block[2 * i] = 0.1f * std::sin(0.01f * (seed + 1) * i);
+            m_block[2 * i + 1] = 0.1f * std::cos(0.013f * (seed + 1) * i);
+        }
+    }
+
+    unsigned int streamCount() const override { return 2; }
+
+    void forward(unsigned int sampleCount) override
+    {
+        std::memcpy(m_buffer.data(), m_block.data(), 2 * sampleCount * sizeof(float));
+    }
+};
+
+//---------------------------------------------------------
+//   RampSource
+//    a source whose stream count changes between blocks,
+//    without telling anybody
+//---------------------------------------------------------
+
+class RampSource : public AbstractAudioSource
+{
+    unsigned int m_streams = 1;
+
+public:
+    unsigned int streamCount() const override { return m_streams; }
+
+    void setStreamCount(unsigned int streams)
+    {
+        m_streams = streams;
+        m_buffer.resize(FRAMES * streams);
+    }
+
+    void forward(unsigned int sampleCount) override
+    {
+        for (unsigned int i = 0; i < sampleCount * m_streams; ++i) {
+            m_buffer[i] = 0.5f * std::sin(0.05f * i);
+        }
+    }
+};
+
+//---------------------------------------------------------
+//   TestEqualiserBenchmark
+//---------------------------------------------------------
+
+class TestEqualiserBenchmark : public QObject
+{
+    Q_OBJECT
+
+    static std::shared_ptr<Equaliser> createEqualiser(unsigned int streams);
+
+private slots:
+    void initTestCase();
+    void testResponse();                // 4 bands against the per sample filter in double precision
+    void testBypass();                  // an inactive insert leaves the source's block alone
+    void testStreamCountChange();       // the channel's buffers follow the source's stream count
+    void benchmarkChannelInserts_data();
+    void benchmarkChannelInserts();     // 64 stereo channels with a 4 band eq each, 512 frames per block
+};
+
+void TestEqualiserBenchmark::initTestCase()
+{
+    AudioSanitizer::setupWorkerThread();
+}
+
+std::shared_ptr<Equaliser> TestEqualiserBenchmark::createEqualiser(unsigned int streams)
+{
+    auto eq = std::make_shared<Equaliser>(streams);
+    eq->setSampleRate(SAMPLE_RATE);
+    eq->setBandCount(4);
+    for (unsigned int b = 0; b < 4; ++b) {
+        eq->setBand(b, BANDS[b].frequency, BANDS[b].gain, BANDS[b].q);
+    }
+    return eq;
+}
+
+//---------------------------------------------------------
+//   testResponse
+//    blocks of odd sizes, so the four sample steps and
+//    the tail are both covered
+//---------------------------------------------------------
+
+void TestEqualiserBenchmark::testResponse()
+{
+    const unsigned int frames = 4'099;
+    std::vector<float> input(frames);
+    for (unsigned int i = 0; i < frames; ++i) {
+        input[i] = 0.5f * std::sin(0.05f * i) + 0.25f * std::sin(1.3f * i);
+    }
+
+    std::vector<double> expected(input.begin(), input.end());
+    for (const BandSetting& band : BANDS) {
+        double a = std::pow(10.0, band.gain / 40.0);
+        double w0 = 2 * M_PI * band.frequency / SAMPLE_RATE;
+        double alpha = std::sin(w0) / (2 * band.q);
+        double b0 = 1 + alpha * a, b1 = -2 * std::cos(w0), b2 = 1 - alpha * a;
+        double a0 = 1 + alpha / a, a1 = -2 * std::cos(w0), a2 = 1 - alpha / a;
+
+        double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        for (double& v : expected) {
+            double y = (b0 * v + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2) / a0;
+            x2 = x1;
+            x1 = v;
+            y2 = y1;
+            y1 = y;
+            v = y;
+        }
+    }
+
+    std::shared_ptr<Equaliser> eq = createEqualiser(1);
+    std::vector<float> output = input;
+    unsigned int done = 0;
+    for (unsigned int block : { 1u, 7u, 512u, 3'000u, 579u }) {
+        float* buffers[] = { output.data() + done };
+        eq->process(buffers, block);
+        done += block;
+    }
+    QCOMPARE(done, frames);
+
+    double maxError = 0.0;
+    for (unsigned int i = 0; i < frames; ++i) {
+        maxError = std::max(maxError, std::abs(output[i] - expected[i]));
+    }
+    QVERIFY(maxError < 1e-3);
+}
+
+//---------------------------------------------------------
+//   testBypass
+//---------------------------------------------------------
+
+void TestEqualiserBenchmark::testBypass()
+{
+    auto mixer = std::make_shared<Mixer>();
+    mixer->setSampleRate(SAMPLE_RATE);
+    mixer->setBufferSize(FRAMES);
+    auto source = std::make_shared<BlockSource>(0);
+    auto id = mixer->addChannel(source);
+    std::shared_ptr<IMixerChannel> channel = mixer->channel(id);
+    std::shared_ptr<Equaliser> eq = createEqualiser(2);
+    channel->setProcessor(0, eq);
+
+    auto mixerChannel = std::dynamic_pointer_cast<MixerChannel>(channel);
+    QVERIFY(mixerChannel);
+
+    eq->setActive(false);
+    mixer->forward(FRAMES);
+    QVERIFY(mixerChannel->data() == source->data());
+
+    eq->setActive(true);
+    mixer->forward(FRAMES);
+    QVERIFY(mixerChannel->data() != source->data());
+}
+
+//---------------------------------------------------------
+//   testStreamCountChange
+//    the source grows from mono to stereo after the buffer
+//    size was set; the block must still be processed whole
+//---------------------------------------------------------
+
+void TestEqualiserBenchmark::testStreamCountChange()
+{
+    auto mixer = std::make_shared<Mixer>();
+    mixer->setSampleRate(SAMPLE_RATE);
+    auto source = std::make_shared<RampSource>();
+    source->setStreamCount(1);
+    auto id = mixer->addChannel(source);
+    mixer->setBufferSize(FRAMES);
+    std::shared_ptr<IMixerChannel> channel = mixer->channel(id);
+    channel->setProcessor(0, createEqualiser(1));
+
+    auto mixerChannel = std::dynamic_pointer_cast<MixerChannel>(channel);
+    QVERIFY(mixerChannel);
+
+    mixer->forward(FRAMES);
+    QVERIFY(mixerChannel->data() != source->data());
+
+    source->setStreamCount(2);
+    mixer->forward(FRAMES);
+    QCOMPARE(mixerChannel->streamCount(), 2u);
+    QVERIFY(mixerChannel->data() != source->data());
+
+    // the eq filters the first stream only, the second one is copied through
+    const float* out = mixerChannel->data();
+    const float* in = source->data();
+    bool filtered = false;
+    for (unsigned int i = 0; i < FRAMES; ++i) {
+        filtered |= out[2 * i] != in[2 * i];
+        QCOMPARE(out[2 * i + 1], in[2 * i + 1]);
+    }
+    QVERIFY(filtered);
+}
+
+//---------------------------------------------------------
+//   benchmarkChannelInserts
+//    one render thread, so the cost of the inserts is
+//    not hidden by the pool
+//---------------------------------------------------------
+
+void TestEqualiserBenchmark::benchmarkChannelInserts_data()
+{
+    QTest::addColumn<bool>("active");
+
+    QTest::newRow("eq") << true;
+    QTest::newRow("bypassed") << false;
+}
+
+void TestEqualiserBenchmark::benchmarkChannelInserts()
+{
+    QFETCH(bool, active);
+
+    auto mixer = std::make_shared<Mixer>();
+    mixer->setSampleRate(SAMPLE_RATE);
+    mixer->setBufferSize(FRAMES);
+    mixer->setRenderThreadCount(1);
+
+    std::vector<std::shared_ptr<Equaliser> > eqs;
+    for (int i = 0; i < CHANNELS; ++i) {
+        auto id = mixer->addChannel(std::make_shared<BlockSource>(i));
+        eqs.push_back(createEqualiser(2));
+        eqs.back()->setActive(active);
+        mixer->channel(id)->setProcessor(0, eqs.back());
+    }
+
+    QBENCHMARK {
+        mixer->forward(FRAMES);
+    }
+}
+
+QTEST_MAIN(TestEqualiserBenchmark)
+#include "tst_equaliser_benchmark.moc"
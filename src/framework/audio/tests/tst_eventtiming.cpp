@@ -0,0 +1,187 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "audio/internal/synthesizers/fluidsynth/fluidsynth.h"
+#include "audio/internal/synthesizers/zerberus/zerberussynth.h"
+#include "midi/midievent.h"
+
+using namespace mu;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+
+static const QString DATA_DIR(QString(audio_tests_DATA_ROOT) + "/data/");
+static const unsigned int SAMPLE_RATE = 44100;
+static const unsigned int RENDER_FRAMES = 4096;
+static const unsigned int FLUID_BLOCK = 64;     // FLUID_BUFSIZE
+static const float FLUID_SILENCE = 1e-4f;       // the reverb keeps a tiny offset against denormals
+
+//---------------------------------------------------------
+//   TestEventTiming
+//    offline check that an event scheduled with a sample
+//    offset is heard on that sample, whatever the block
+//    size it is rendered with
+//---------------------------------------------------------
+
+class TestEventTiming : public QObject
+{
+    Q_OBJECT
+
+    enum class SynthType {
+        Zerberus,
+        Fluid
+    };
+
+    std::unique_ptr<ISynthesizer> createSynth(SynthType type) const;
+    int onset(SynthType type, unsigned int eventFrame, unsigned int blockSize);
+
+private slots:
+    void noteOnTiming_data();
+    void noteOnTiming();
+    void fluidNoteOnTiming_data();
+    void fluidNoteOnTiming();       // FluidSynth rounds the offset up to its 64 frame blocks
+};
+
+//---------------------------------------------------------
+//   createSynth
+//---------------------------------------------------------
+
+std::unique_ptr<ISynthesizer> TestEventTiming::createSynth(SynthType type) const
+{
+    if (type == SynthType::Fluid) {
+        auto synth = std::make_unique<FluidSynth>();
+        synth->init();
+        synth->setSampleRate(SAMPLE_RATE);
+        if (!synth->addSoundFonts({ io::path(DATA_DIR + "sine.sf2") })) {
+            return nullptr;
+        }
+        synth->setupChannels({});
+        return synth;
+    }
+
+    auto synth = std::make_unique<ZerberusSynth>();
+    synth->setSampleRate(SAMPLE_RATE);
+    if (!synth->addSoundFonts({ io::path(DATA_DIR + "polyphony.sfz") })) {
+        return nullptr;
+    }
+    synth->setIsActive(true);
+    return synth;
+}
+
+//---------------------------------------------------------
+//   onset
+//    render a note starting at eventFrame in blocks of
+//    blockSize frames and return the first frame that
+//    is not silent, -1 if there is none
+//---------------------------------------------------------
+
+int TestEventTiming::onset(SynthType type, unsigned int eventFrame, unsigned int blockSize)
+{
+    std::unique_ptr<ISynthesizer> synth = createSynth(type);
+    if (!synth) {
+        return -1;
+    }
+
+    Event noteOn(Event::Opcode::NoteOn, Event::MessageType::ChannelVoice10);
+    noteOn.setChannel(0);
+    noteOn.setNote(69);
+    noteOn.setVelocity(100);
+
+    std::vector<float> buffer(RENDER_FRAMES * AUDIO_CHANNELS, 0.f);
+    for (unsigned int from = 0; from < RENDER_FRAMES; from += blockSize) {
+        const unsigned int frames = std::min(blockSize, RENDER_FRAMES - from);
+        if (eventFrame >= from && eventFrame < from + frames) {
+            synth->scheduleEvent(noteOn, eventFrame - from);
+        }
+        synth->writeBuf(buffer.data() + from * AUDIO_CHANNELS, frames);
+    }
+
+    const float silence = type == SynthType::Fluid ? FLUID_SILENCE : 0.f;
+    for (unsigned int i = 0; i < RENDER_FRAMES; ++i) {
+        if (std::fabs(buffer[i * AUDIO_CHANNELS]) > silence || std::fabs(buffer[i * AUDIO_CHANNELS + 1]) > silence) {
+            return int(i);
+        }
+    }
+    return -1;
+}
+
+void TestEventTiming::noteOnTiming_data()
+{
+    QTest::addColumn<unsigned int>("eventFrame");
+
+    QTest::newRow("block start") << 0u;
+    QTest::newRow("inside first block") << 37u;
+    QTest::newRow("inside later block") << 1500u;
+    QTest::newRow("odd frame") << 2051u;
+}
+
+//---------------------------------------------------------
+//   noteOnTiming
+//    the delay from the event to the first sound must be
+//    the same for all block sizes
+//---------------------------------------------------------
+
+void TestEventTiming::noteOnTiming()
+{
+    QFETCH(unsigned int, eventFrame);
+
+    const int reference = onset(SynthType::Zerberus, eventFrame, RENDER_FRAMES);
+    QVERIFY(reference >= int(eventFrame));
+    QVERIFY(reference < int(eventFrame) + 8);
+
+    for (unsigned int blockSize : { 1u, 64u, 100u, 256u, 512u, 1024u }) {
+        QCOMPARE(onset(SynthType::Zerberus, eventFrame, blockSize), reference);
+    }
+}
+
+void TestEventTiming::fluidNoteOnTiming_data()
+{
+    noteOnTiming_data();
+    QTest::newRow("fluid block start") << 1536u;
+}
+
+//---------------------------------------------------------
+//   fluidNoteOnTiming
+//    the note starts on the first 64 frame boundary of
+//    FluidSynth's timeline from the event, whatever the
+//    block sizes
+//---------------------------------------------------------
+
+void TestEventTiming::fluidNoteOnTiming()
+{
+    QFETCH(unsigned int, eventFrame);
+
+    const int reference = onset(SynthType::Fluid, eventFrame, RENDER_FRAMES);
+    const unsigned int boundary = (eventFrame + FLUID_BLOCK - 1) / FLUID_BLOCK * FLUID_BLOCK;
+    QVERIFY(reference >= int(boundary));
+    QVERIFY(reference < int(boundary) + 8);
+
+    for (unsigned int blockSize : { 1u, 7u, 64u, 100u, 256u, 512u, 1024u }) {
+        QCOMPARE(onset(SynthType::Fluid, eventFrame, blockSize), reference);
+    }
+}
+
+QTEST_MAIN(TestEventTiming)
+#include "tst_eventtiming.moc"
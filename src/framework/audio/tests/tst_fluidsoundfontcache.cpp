@@ -0,0 +1,198 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "audio/internal/synthesizers/fluidsynth/fluidsynth.h"
+#include "audio/internal/synthesizers/fluidsynth/fluidsoundfontcache.h"
+#include "midi/midievent.h"
+
+using namespace mu;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+
+static const QString DATA_DIR(QString(audio_tests_DATA_ROOT) + "/data/");
+static const unsigned int SAMPLE_RATE = 44100;
+static const unsigned int BLOCK_FRAMES = 256;
+
+//---------------------------------------------------------
+//   TestFluidSoundFontCache
+//    FluidSynth instances share the soundfonts they load
+//    through FluidSoundFontCache
+//---------------------------------------------------------
+
+class TestFluidSoundFontCache : public QObject
+{
+    Q_OBJECT
+
+    io::path fontPath() const { return io::path(DATA_DIR + "sine.sf2"); }
+    std::unique_ptr<FluidSynth> createSynth();
+
+private slots:
+    void cache();
+    void concurrentNoteOns();   // instances sharing a font play notes on different threads
+    void unload();              // an instance unloads the font while another one plays it
+};
+
+//---------------------------------------------------------
+//   noteOn
+//---------------------------------------------------------
+
+static Event noteOn(channel_t channel, int note)
+{
+    Event e(Event::Opcode::NoteOn, Event::MessageType::ChannelVoice10);
+    e.setChannel(channel);
+    e.setNote(note);
+    e.setVelocity(100);
+    return e;
+}
+
+static Event noteOff(channel_t channel, int note)
+{
+    Event e(Event::Opcode::NoteOff, Event::MessageType::ChannelVoice10);
+    e.setChannel(channel);
+    e.setNote(note);
+    return e;
+}
+
+//---------------------------------------------------------
+//   peak
+//    render a block and return its highest amplitude
+//---------------------------------------------------------
+
+static float peak(FluidSynth* synth)
+{
+    std::vector<float> buffer(BLOCK_FRAMES * AUDIO_CHANNELS, 0.f);
+    synth->writeBuf(buffer.data(), BLOCK_FRAMES);
+    float p = 0.f;
+    for (float f : buffer) {
+        p = std::max(p, std::fabs(f));
+    }
+    return p;
+}
+
+//---------------------------------------------------------
+//   createSynth
+//---------------------------------------------------------
+
+std::unique_ptr<FluidSynth> TestFluidSoundFontCache::createSynth()
+{
+    auto synth = std::make_unique<FluidSynth>();
+    synth->init();
+    synth->setSampleRate(SAMPLE_RATE);
+    if (!synth->addSoundFonts({ fontPath() })) {
+        return nullptr;
+    }
+    synth->setupChannels({});
+    return synth;
+}
+
+//---------------------------------------------------------
+//   cache
+//    a font is loaded once and freed with its last user
+//---------------------------------------------------------
+
+void TestFluidSoundFontCache::cache()
+{
+    FluidSoundFontCache* cache = FluidSoundFontCache::instance();
+
+    FluidSoundFontCache::FontPtr font = cache->font(fontPath());
+    QVERIFY(font);
+    QVERIFY(font->sfont());
+    QVERIFY(cache->font(fontPath()) == font);
+
+    QVERIFY(!cache->font(io::path(DATA_DIR + "missing.sf2")));
+
+    std::weak_ptr<const FluidSoundFontCache::Font> weak = font;
+    font.reset();
+    QVERIFY(weak.expired());
+
+    font = cache->font(fontPath());
+    QVERIFY(font);
+}
+
+//---------------------------------------------------------
+//   concurrentNoteOns
+//---------------------------------------------------------
+
+void TestFluidSoundFontCache::concurrentNoteOns()
+{
+    std::unique_ptr<FluidSynth> a = createSynth();
+    std::unique_ptr<FluidSynth> b = createSynth();
+    QVERIFY(a && b);
+
+    FluidSoundFontCache::FontPtr font = FluidSoundFontCache::instance()->font(fontPath());
+    QCOMPARE(font.use_count(), 3L);
+
+    auto play = [](FluidSynth* synth, float* loudest) {
+        for (int i = 0; i < 500; ++i) {
+            const int note = 60 + i % 12;
+            synth->handleEvent(noteOn(0, note));
+            *loudest = std::max(*loudest, peak(synth));
+            synth->handleEvent(noteOff(0, note));
+        }
+    };
+
+    float loudestA = 0.f;
+    float loudestB = 0.f;
+    std::thread threadA(play, a.get(), &loudestA);
+    std::thread threadB(play, b.get(), &loudestB);
+    threadA.join();
+    threadB.join();
+
+    QVERIFY(loudestA > 0.f);
+    QCOMPARE(loudestB, loudestA);
+}
+
+//---------------------------------------------------------
+//   unload
+//---------------------------------------------------------
+
+void TestFluidSoundFontCache::unload()
+{
+    std::unique_ptr<FluidSynth> a = createSynth();
+    std::unique_ptr<FluidSynth> b = createSynth();
+    QVERIFY(a && b);
+
+    std::weak_ptr<const FluidSoundFontCache::Font> font = FluidSoundFontCache::instance()->font(fontPath());
+    QCOMPARE(font.use_count(), 2L);
+
+    a->handleEvent(noteOn(0, 69));
+    b->handleEvent(noteOn(0, 69));
+    QVERIFY(peak(a.get()) > 0.f);
+    QVERIFY(peak(b.get()) > 0.f);
+
+    // the voices of a are stopped before the unload, b plays on
+    QVERIFY(a->removeSoundFonts());
+    QCOMPARE(font.use_count(), 1L);
+    peak(a.get());
+    QVERIFY(peak(b.get()) > 0.f);
+
+    QVERIFY(b->removeSoundFonts());
+    QVERIFY(font.expired());
+}
+
+QTEST_MAIN(TestFluidSoundFontCache)
+#include "tst_fluidsoundfontcache.moc"
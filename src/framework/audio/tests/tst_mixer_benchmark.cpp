@@ -0,0 +1,185 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "audio/internal/audiosanitizer.h"
+#include "audio/internal/worker/abstractaudiosource.h"
+#include "audio/internal/worker/mixer.h"
+
+using namespace mu::audio;
+
+static const unsigned int SAMPLE_RATE = 44100;
+static const unsigned int FRAMES = 512;
+static const int CHANNELS = 16;
+
+//---------------------------------------------------------
+//   LoadSource
+//    stereo source standing in for a synthesizer: costs
+//    some CPU per frame and renders the same output on
+//    every thread
+//---------------------------------------------------------
+
+class LoadSource : public AbstractAudioSource
+{
+    double m_phase = 0.0;
+    double m_step = 0.0;
+
+public:
+    LoadSource(double frequency)
+        : m_step(frequency / SAMPLE_RATE) {}
+
+    unsigned int streamCount() const override { return 2; }
+
+    void forward(unsigned int sampleCount) override
+    {
+        for (unsigned int i = 0; i < sampleCount; ++i) {
+            double v = 0.0;
+            for (int h = 1; h <= 32; ++h) {
+                v += std::sin(2.0 * M_PI * m_phase * h) / h;
+            }
+            m_phase += m_step;
+            m_phase -= std::floor(m_phase);
+            m_buffer[2 * i]     = float(0.05 * v);
+            m_buffer[2 * i + 1] = float(-0.05 * v);
+        }
+    }
+};
+
+//---------------------------------------------------------
+//   TestMixerBenchmark
+//---------------------------------------------------------
+
+class TestMixerBenchmark : public QObject
+{
+    Q_OBJECT
+
+    std::shared_ptr<Mixer> createMixer(unsigned int threads);
+
+private slots:
+    void initTestCase();
+    void benchmarkRenderThreads();      // 16 stereo channels, 512 frames per block, 1 vs all threads
+    void concurrentMixers();            // playback and an offline render share the render pool
+};
+
+void TestMixerBenchmark::initTestCase()
+{
+    AudioSanitizer::setupWorkerThread();
+}
+
+//---------------------------------------------------------
+//   createMixer
+//---------------------------------------------------------
+
+std::shared_ptr<Mixer> TestMixerBenchmark::createMixer(unsigned int threads)
+{
+    auto mixer = std::make_shared<Mixer>();
+    mixer->setSampleRate(SAMPLE_RATE);
+    mixer->setBufferSize(FRAMES);
+    mixer->setRenderThreadCount(threads);
+    for (int i = 0; i < CHANNELS; ++i) {
+        mixer->addChannel(std::make_shared<LoadSource>(110.0 * (i + 1)));
+    }
+    return mixer;
+}
+
+//---------------------------------------------------------
+//   benchmarkRenderThreads
+//    the output must not depend on the number of threads
+//---------------------------------------------------------
+
+void TestMixerBenchmark::benchmarkRenderThreads()
+{
+    std::shared_ptr<Mixer> single = createMixer(1);
+    std::shared_ptr<Mixer> parallel = createMixer(RenderPool::defaultThreadCount());
+    QCOMPARE(single->renderThreadCount(), 1u);
+
+    const int blocks = 200;
+    float singleHeadroom = 0.f;
+    float parallelHeadroom = 0.f;
+    for (int b = 0; b < blocks; ++b) {
+        single->forward(FRAMES);
+        parallel->forward(FRAMES);
+        singleHeadroom += single->cpuHeadroom();
+        parallelHeadroom += parallel->cpuHeadroom();
+
+        const float* s = single->data();
+        const float* p = parallel->data();
+        for (unsigned int i = 0; i < 2 * FRAMES; ++i) {
+            QCOMPARE(p[i], s[i]);
+        }
+    }
+
+    QBENCHMARK {
+        parallel->forward(FRAMES);
+    }
+
+    qDebug("Mixer: %d channels x %u frames, cpu headroom %.0f%% on 1 thread, %.0f%% on %u threads",
+           CHANNELS, FRAMES, 100.0 * singleHeadroom / blocks, 100.0 * parallelHeadroom / blocks,
+           parallel->renderThreadCount());
+}
+
+//---------------------------------------------------------
+//   concurrentMixers
+//    a mixer that finds the pool busy renders its channels
+//    by itself, the output is the same
+//---------------------------------------------------------
+
+void TestMixerBenchmark::concurrentMixers()
+{
+    std::shared_ptr<Mixer> single = createMixer(1);
+    std::shared_ptr<Mixer> live = createMixer(RenderPool::defaultThreadCount());
+    std::shared_ptr<Mixer> offline = createMixer(RenderPool::defaultThreadCount());
+
+    const int blocks = 200;
+    std::vector<float> offlineOutput;
+    offlineOutput.reserve(blocks * 2 * FRAMES);
+
+    std::thread offlineThread([&offline, &offlineOutput]() {
+        AudioSanitizer::setupRenderThread();
+        for (int b = 0; b < blocks; ++b) {
+            offline->forward(FRAMES);
+            offlineOutput.insert(offlineOutput.end(), offline->data(), offline->data() + 2 * FRAMES);
+        }
+    });
+
+    std::vector<float> liveOutput;
+    for (int b = 0; b < blocks; ++b) {
+        live->forward(FRAMES);
+        liveOutput.insert(liveOutput.end(), live->data(), live->data() + 2 * FRAMES);
+    }
+    offlineThread.join();
+
+    for (int b = 0; b < blocks; ++b) {
+        single->forward(FRAMES);
+        const float* s = single->data();
+        for (unsigned int i = 0; i < 2 * FRAMES; ++i) {
+            QCOMPARE(liveOutput[b * 2 * FRAMES + i], s[i]);
+            QCOMPARE(offlineOutput[b * 2 * FRAMES + i], s[i]);
+        }
+    }
+}
+
+QTEST_MAIN(TestMixerBenchmark)
+#include "tst_mixer_benchmark.moc"
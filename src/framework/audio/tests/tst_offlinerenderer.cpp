@@ -0,0 +1,347 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "modularity/ioc.h"
+#include "audio/internal/offlinerenderer.h"
+#include "audio/internal/audiosanitizer.h"
+#include "audio/internal/worker/mixer.h"
+#include "audio/internal/worker/sequencer.h"
+#include "audio/internal/synthesizers/synthesizersregister.h"
+#include "audio/internal/synthesizers/fluidsynth/fluidsynth.h"
+#include "midi/imidiportdatasender.h"
+#include "midi/midievent.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+
+static const QString DATA_DIR(QString(audio_tests_DATA_ROOT) + "/data/");
+static const unsigned int SAMPLE_RATE = 44100;
+static const unsigned int OFFLINE_BLOCK = 1024;
+static const unsigned int PLAYBACK_BLOCK = 512;
+static const float TOLERANCE = 1e-5f;
+
+namespace {
+class TestSoundFontsProvider : public ISoundFontsProvider
+{
+public:
+    std::vector<io::path> soundFontPathsForSynth(const SynthName& synth) const override
+    {
+        if (synth == "Fluid") {
+            return { io::path(DATA_DIR + "sine.sf2") };
+        }
+        return {};
+    }
+
+    async::Notification soundFontPathsForSynthChanged(const SynthName&) const override { return async::Notification(); }
+    std::vector<io::path> soundFontPaths(SoundFontFormats) const override { return {}; }
+};
+
+class NoMidiPortDataSender : public IMidiPortDataSender
+{
+public:
+    void setMidiStream(std::shared_ptr<MidiStream>) override {}
+    bool sendEvents(tick_t, tick_t) override { return true; }
+    bool sendSingleEvent(const Event&) override { return true; }
+};
+}
+
+//---------------------------------------------------------
+//   TestOfflineRenderer
+//    the playback synthesizers are registered like the
+//    audio module does, the offline renderer builds its
+//    own from them
+//---------------------------------------------------------
+
+class TestOfflineRenderer : public QObject
+{
+    Q_OBJECT
+
+    std::shared_ptr<SynthesizersRegister> m_synths;
+    std::shared_ptr<TestSoundFontsProvider> m_soundFonts;
+
+    std::shared_ptr<MidiStream> createStream(track_t tracks) const;
+    std::vector<float> renderOffline(const std::shared_ptr<MidiStream>& stream, const std::vector<std::set<track_t> >& stems,
+                                     std::vector<std::vector<float> >& out) const;
+    std::vector<float> renderPlayback(const std::shared_ptr<MidiStream>& stream, size_t samples) const;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void matchesPlayback();     // an offline render is what playback plays, at another block size
+    void stems();               // the stems of a score add up to its full render
+    void cancel();              // a writer returning false stops its render
+};
+
+//---------------------------------------------------------
+//   note
+//---------------------------------------------------------
+
+static Event note(Event::Opcode opcode, channel_t channel, int pitch)
+{
+    Event e(opcode, Event::MessageType::ChannelVoice10);
+    e.setChannel(channel);
+    e.setNote(pitch);
+    e.setVelocity(opcode == Event::Opcode::NoteOn ? 100 : 0);
+    return e;
+}
+
+//---------------------------------------------------------
+//   maxDifference
+//    over the length of the shorter one, the rest of the
+//    longer one must be silent
+//---------------------------------------------------------
+
+static float maxDifference(const std::vector<float>& a, const std::vector<float>& b)
+{
+    const size_t n = std::min(a.size(), b.size());
+    float d = 0.f;
+    for (size_t i = 0; i < n; ++i) {
+        d = std::max(d, std::fabs(a[i] - b[i]));
+    }
+    const std::vector<float>& longer = a.size() > b.size() ? a : b;
+    for (size_t i = n; i < longer.size(); ++i) {
+        d = std::max(d, std::fabs(longer[i]));
+    }
+    return d;
+}
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestOfflineRenderer::initTestCase()
+{
+    m_soundFonts = std::make_shared<TestSoundFontsProvider>();
+
+    auto fluid = std::make_shared<FluidSynth>();
+    fluid->setSampleRate(SAMPLE_RATE);
+    fluid->init();
+    QVERIFY(fluid->addSoundFonts(m_soundFonts->soundFontPathsForSynth("Fluid")));
+
+    m_synths = std::make_shared<SynthesizersRegister>();
+    m_synths->registerSynthesizer("Fluid", fluid);
+    m_synths->setDefaultSynthesizer("Fluid");
+
+    framework::ioc()->registerExport<ISynthesizersRegister>("audio", m_synths);
+    framework::ioc()->registerExport<ISoundFontsProvider>("audio", m_soundFonts);
+    framework::ioc()->registerExport<IMidiPortDataSender>("audio", std::make_shared<NoMidiPortDataSender>());
+}
+
+void TestOfflineRenderer::cleanupTestCase()
+{
+    framework::ioc()->unregisterExport<ISynthesizersRegister>();
+    framework::ioc()->unregisterExport<ISoundFontsProvider>();
+    framework::ioc()->unregisterExport<IMidiPortDataSender>();
+    m_synths = nullptr;
+}
+
+//---------------------------------------------------------
+//   createStream
+//    a bar of quarter notes per track, track t plays on
+//    channel t
+//---------------------------------------------------------
+
+std::shared_ptr<MidiStream> TestOfflineRenderer::createStream(track_t tracks) const
+{
+    auto stream = std::make_shared<MidiStream>();
+    MidiData& data = stream->initData;
+    data.division = 480;
+    data.tempoMap.insert({ 0, 500000 });
+
+    Chunk chunk;
+    chunk.beginTick = 0;
+    chunk.endTick = 4 * 480;
+    for (track_t t = 0; t < tracks; ++t) {
+        const channel_t channel = static_cast<channel_t>(t);
+        data.tracks.push_back(Track { t, { channel } });
+        data.synthMap.insert({ channel, "Fluid" });
+
+        Event program(Event::Opcode::ProgramChange, Event::MessageType::ChannelVoice10);
+        program.setChannel(channel);
+        program.setProgram(0);
+        data.initEvents.push_back(program);
+
+        for (int beat = 0; beat < 4; ++beat) {
+            const int pitch = 60 + 7 * int(t) + 2 * beat;
+            chunk.events.insert({ beat * 480, note(Event::Opcode::NoteOn, channel, pitch) });
+            chunk.events.insert({ beat * 480 + 240, note(Event::Opcode::NoteOff, channel, pitch) });
+        }
+    }
+    data.chunks.insert({ chunk.beginTick, chunk });
+
+    stream->isStreamingAllowed = false;
+    stream->lastTick = chunk.endTick;
+    return stream;
+}
+
+//---------------------------------------------------------
+//   renderOffline
+//    one job per stem, into out
+//---------------------------------------------------------
+
+std::vector<float> TestOfflineRenderer::renderOffline(const std::shared_ptr<MidiStream>& stream,
+                                                      const std::vector<std::set<track_t> >& stems,
+                                                      std::vector<std::vector<float> >& out) const
+{
+    OfflineRenderer renderer;
+    renderer.setsynthesizersRegister(m_synths);
+    renderer.setsoundFontsProvider(m_soundFonts);
+
+    IOfflineRenderer::Options options;
+    options.sampleRate = SAMPLE_RATE;
+    options.blockSize = OFFLINE_BLOCK;
+
+    out.assign(stems.size(), {});
+    std::vector<IOfflineRenderer::Job> jobs;
+    for (size_t i = 0; i < stems.size(); ++i) {
+        std::vector<float>* o = &out[i];
+        jobs.push_back({ stems[i], [o](const float* data, unsigned int frames) {
+                             o->insert(o->end(), data, data + frames * AUDIO_CHANNELS);
+                             return true;
+                         } });
+    }
+
+    Ret ret = renderer.render(stream, options, jobs);
+    return ret ? out.front() : std::vector<float>();
+}
+
+//---------------------------------------------------------
+//   renderPlayback
+//    the playback path of the audio engine: the sequencer
+//    plays the stream on the playback synthesizers, the
+//    mixer pulls blocks the size of the driver's
+//---------------------------------------------------------
+
+std::vector<float> TestOfflineRenderer::renderPlayback(const std::shared_ptr<MidiStream>& stream, size_t samples) const
+{
+    std::vector<float> out;
+    std::thread worker([&]() {
+        AudioSanitizer::setupWorkerThread();
+
+        auto sequencer = std::make_shared<Sequencer>();
+        auto mixer = std::make_shared<Mixer>();
+        mixer->setClock(sequencer->clock());
+        mixer->setBufferSize(PLAYBACK_BLOCK);
+        for (const ISynthesizerPtr& synth : m_synths->synthesizers()) {
+            mixer->addChannel(synth);
+        }
+        mixer->setSampleRate(SAMPLE_RATE);
+
+        sequencer->setMIDITrack(0, stream);
+        sequencer->play();
+        while (out.size() < samples) {
+            mixer->forward(PLAYBACK_BLOCK);
+            out.insert(out.end(), mixer->data(), mixer->data() + PLAYBACK_BLOCK * mixer->streamCount());
+        }
+
+        for (const ISynthesizerPtr& synth : m_synths->synthesizers()) {
+            synth->flushSound();
+        }
+        mixer = nullptr;
+        sequencer = nullptr;
+    });
+    worker.join();
+
+    out.resize(samples);
+    return out;
+}
+
+//---------------------------------------------------------
+//   matchesPlayback
+//---------------------------------------------------------
+
+void TestOfflineRenderer::matchesPlayback()
+{
+    std::shared_ptr<MidiStream> stream = createStream(1);
+
+    std::vector<std::vector<float> > out;
+    const std::vector<float> offline = renderOffline(stream, { {} }, out);
+    QVERIFY(!offline.empty());
+    QVERIFY(*std::max_element(offline.begin(), offline.end()) > 0.01f);
+
+    const std::vector<float> playback = renderPlayback(stream, offline.size());
+    QVERIFY(maxDifference(offline, playback) < TOLERANCE);
+}
+
+//---------------------------------------------------------
+//   stems
+//    more jobs than render threads on small machines,
+//    so jobs also reuse the synthesizers of a thread
+//---------------------------------------------------------
+
+void TestOfflineRenderer::stems()
+{
+    std::shared_ptr<MidiStream> stream = createStream(2);
+
+    std::vector<std::vector<float> > out;
+    renderOffline(stream, { {}, { 0 }, { 1 }, { 0 }, { 1 } }, out);
+    QCOMPARE(out.size(), size_t(5));
+
+    const std::vector<float>& full = out[0];
+    QVERIFY(!full.empty());
+
+    for (size_t first : { 1, 3 }) {
+        std::vector<float> sum = out[first];
+        const std::vector<float>& second = out[first + 1];
+        sum.resize(std::max(sum.size(), second.size()), 0.f);
+        for (size_t i = 0; i < second.size(); ++i) {
+            sum[i] += second[i];
+        }
+        QVERIFY(maxDifference(sum, full) < 1e-4f);
+    }
+
+    // a reused synthesizer sounds like a fresh one
+    QVERIFY(maxDifference(out[1], out[3]) < TOLERANCE);
+    QVERIFY(maxDifference(out[2], out[4]) < TOLERANCE);
+}
+
+//---------------------------------------------------------
+//   cancel
+//---------------------------------------------------------
+
+void TestOfflineRenderer::cancel()
+{
+    OfflineRenderer renderer;
+    renderer.setsynthesizersRegister(m_synths);
+    renderer.setsoundFontsProvider(m_soundFonts);
+
+    int blocks = 0;
+    IOfflineRenderer::Job job;
+    job.writer = [&blocks](const float*, unsigned int) {
+        return ++blocks < 3;
+    };
+
+    Ret ret = renderer.render(createStream(1), IOfflineRenderer::Options(), { job });
+    QCOMPARE(ret.code(), static_cast<int>(Ret::Code::Cancel));
+    QCOMPARE(blocks, 3);
+}
+
+QTEST_MAIN(TestOfflineRenderer)
+#include "tst_offlinerenderer.moc"
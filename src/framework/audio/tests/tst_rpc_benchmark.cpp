@@ -0,0 +1,221 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "audio/internal/rpc/queuedrpcchannel.h"
+
+using namespace mu::audio::rpc;
+
+static const uint64_t COUNT = 1000000;
+static const uint64_t ORDERING_COUNT = 100000;
+static const uint64_t BURST = 5000;     // more than the command queue holds
+
+static uint64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//---------------------------------------------------------
+//   TestRpcBenchmark
+//    the main thread sending transport controls to the
+//    worker: typed commands against string messages.
+//    Both are sent from the main thread only.
+//    The worker polls the channel without sleeping, so
+//    the latency is the one of the channel alone.
+//---------------------------------------------------------
+
+class TestRpcBenchmark : public QObject
+{
+    Q_OBJECT
+
+    struct Result {
+        uint64_t received = 0;
+        uint64_t maxLatencyNs = 0;
+        uint64_t last = 0;
+        bool ordered = true;
+
+        void receive(uint64_t id)
+        {
+            ordered = ordered && (received == 0 || id > last);
+            last = id;
+            ++received;
+        }
+    };
+
+private slots:
+    void ordering();                // messages and commands mixed, the command queue overflowing
+    void benchmarkCommands();       // lock free queue
+    void benchmarkMessages();       // Msg with a string method and Args
+};
+
+//---------------------------------------------------------
+//   ordering
+//    the worker stops in bursts, so commands also go
+//    through the message queue when the command queue is full
+//---------------------------------------------------------
+
+void TestRpcBenchmark::ordering()
+{
+    QueuedRpcChannel channel;
+    const Target target(TargetName::Sequencer);
+
+    Result result;
+    std::atomic<bool> workerReady { false };
+    std::atomic<bool> paused { false };
+
+    std::thread worker([&]() {
+        channel.setupWorkerThread();
+        channel.listen([&](const Msg& msg) {
+            if (msg.method == "seek") {
+                result.receive(msg.args.arg<uint64_t>(0));
+            }
+        });
+        channel.listenCommands([&](const Command& cmd) {
+            result.receive(cmd.arg(0));
+        });
+        workerReady = true;
+
+        while (result.received < ORDERING_COUNT) {
+            if (!paused) {
+                channel.process();
+            }
+        }
+    });
+
+    while (!workerReady) {
+        std::this_thread::yield();
+    }
+
+    for (uint64_t i = 0; i < ORDERING_COUNT; ++i) {
+        if (i % BURST == 0) {
+            paused = (i / BURST) % 2 == 1;
+        }
+
+        if (i % 3 == 0) {
+            channel.send(Msg(target, "seek", Args::make_arg1<uint64_t>(i)));
+        } else {
+            channel.sendCommand(Command(target, CommandID::Seek, i));
+        }
+    }
+    paused = false;
+    worker.join();
+
+    QCOMPARE(result.received, ORDERING_COUNT);
+    QVERIFY(result.ordered);
+}
+
+//---------------------------------------------------------
+//   benchmarkCommands
+//---------------------------------------------------------
+
+void TestRpcBenchmark::benchmarkCommands()
+{
+    QueuedRpcChannel channel;
+    const Target target(TargetName::Sequencer);
+
+    Result result;
+    std::atomic<bool> workerReady { false };
+
+    std::thread worker([&]() {
+        channel.setupWorkerThread();
+        channel.listenCommands([&](const Command& cmd) {
+            uint64_t latency = nowNs() - cmd.arg(1);
+            result.maxLatencyNs = std::max(result.maxLatencyNs, latency);
+            result.receive(cmd.arg(0));
+        });
+        workerReady = true;
+
+        while (result.received < COUNT) {
+            channel.process();
+        }
+    });
+
+    while (!workerReady) {
+        std::this_thread::yield();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        channel.sendCommand(Command(target, CommandID::Seek, i, nowNs()));
+    }
+    worker.join();
+
+    QTest::setBenchmarkResult(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                              QTest::WalltimeMilliseconds);
+
+    QCOMPARE(result.received, COUNT);
+    QVERIFY(result.ordered);
+}
+
+//---------------------------------------------------------
+//   benchmarkMessages
+//---------------------------------------------------------
+
+void TestRpcBenchmark::benchmarkMessages()
+{
+    QueuedRpcChannel channel;
+    const Target target(TargetName::Sequencer);
+
+    Result result;
+    std::atomic<bool> workerReady { false };
+
+    std::thread worker([&]() {
+        channel.setupWorkerThread();
+        channel.listen([&](const Msg& msg) {
+            if (msg.method != "seek") {
+                return;
+            }
+            uint64_t latency = nowNs() - msg.args.arg<uint64_t>(1);
+            result.maxLatencyNs = std::max(result.maxLatencyNs, latency);
+            result.receive(msg.args.arg<uint64_t>(0));
+        });
+        workerReady = true;
+
+        while (result.received < COUNT) {
+            channel.process();
+        }
+    });
+
+    while (!workerReady) {
+        std::this_thread::yield();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        channel.send(Msg(target, "seek", Args::make_arg2<uint64_t, uint64_t>(i, nowNs())));
+    }
+    worker.join();
+
+    QTest::setBenchmarkResult(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                              QTest::WalltimeMilliseconds);
+
+    QCOMPARE(result.received, COUNT);
+    QVERIFY(result.ordered);
+}
+
+QTEST_MAIN(TestRpcBenchmark)
+#include "tst_rpc_benchmark.moc"
@@ -0,0 +1,310 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QTemporaryDir>
+#include <memory>
+#include <vector>
+
+#include "settings.h"
+#include "audio/internal/audioconfiguration.h"
+#include "audio/internal/synthesizers/zerberus/internal/samplestream.h"
+#include "audio/internal/synthesizers/zerberus/internal/zerberus.h"
+
+using namespace mu;
+using namespace mu::framework;
+using namespace mu::audio;
+using namespace mu::zerberus;
+
+static const int SAMPLE_RATE = 44100;
+static const long long SAMPLE_FRAMES = 3 * SampleStream::BLOCK_FRAMES + 1000;
+static const long long FIRST_FRAME = 100;       // frames before are preloaded
+
+//---------------------------------------------------------
+//   TestSampleStream
+//    the generated test sample is a mono ramp, frame i
+//    has the value frameValue(i)
+//---------------------------------------------------------
+
+class TestSampleStream : public QObject
+{
+    Q_OBJECT
+
+    QTemporaryDir dir;
+
+    QString samplePath() const { return dir.filePath("stream.wav"); }
+    std::unique_ptr<SampleStream> openStream();
+    std::vector<float> render(int preloadTime);
+
+private slots:
+    void initTestCase();
+    void underrun();            // a block is silent until the reader decoded it
+    void loopPrefetch();        // a looping voice prefetches the loop start with the frames it plays
+    void eviction();            // blocks are freed once the stream was unused for idleTime()
+    void openFiles();           // the reader keeps at most MAX_OPEN_FILES sample files open
+    void streamedPlayback();    // a streamed sample sounds like a completely loaded one
+    void preloadSetting();      // the preload time follows the audio settings
+};
+
+//---------------------------------------------------------
+//   frameValue
+//---------------------------------------------------------
+
+static short frameValue(long long frame)
+{
+    return short(frame % 30000);
+}
+
+//---------------------------------------------------------
+//   initTestCase
+//    write the test sample as 16 bit PCM wav
+//---------------------------------------------------------
+
+void TestSampleStream::initTestCase()
+{
+    QVERIFY(dir.isValid());
+
+    QFile f(samplePath());
+    QVERIFY(f.open(QIODevice::WriteOnly));
+    QDataStream s(&f);
+    s.setByteOrder(QDataStream::LittleEndian);
+
+    const quint32 dataSize = quint32(SAMPLE_FRAMES * 2);
+    s.writeRawData("RIFF", 4);
+    s << quint32(36 + dataSize);
+    s.writeRawData("WAVEfmt ", 8);
+    s << quint32(16) << quint16(1) << quint16(1) << quint32(SAMPLE_RATE) << quint32(SAMPLE_RATE * 2)
+      << quint16(2) << quint16(16);
+    s.writeRawData("data", 4);
+    s << dataSize;
+    for (long long i = 0; i < SAMPLE_FRAMES; ++i) {
+        s << qint16(frameValue(i));
+    }
+    f.close();
+
+    QFile sfz(dir.filePath("stream.sfz"));
+    QVERIFY(sfz.open(QIODevice::WriteOnly));
+    sfz.write("<region>\nsample=stream.wav\nlokey=0\nhikey=127\npitch_keycenter=60\n");
+}
+
+//---------------------------------------------------------
+//   openStream
+//---------------------------------------------------------
+
+std::unique_ptr<SampleStream> TestSampleStream::openStream()
+{
+    std::unique_ptr<SampleStream> stream(new SampleStream(samplePath()));
+    if (!stream->open()) {
+        return nullptr;
+    }
+    stream->start(FIRST_FRAME);
+    return stream;
+}
+
+//---------------------------------------------------------
+//   underrun
+//---------------------------------------------------------
+
+void TestSampleStream::underrun()
+{
+    std::unique_ptr<SampleStream> stream = openStream();
+    QVERIFY(stream);
+    stream->acquire();
+
+    const long long frame = FIRST_FRAME + SampleStream::BLOCK_FRAMES + 5;
+    short v = -1;
+    QVERIFY(!stream->decoded(frame));
+    QVERIFY(!stream->value(frame, 0, v));
+    QCOMPARE(v, short(-1));
+
+    QTRY_VERIFY(stream->value(frame, 0, v));
+    QCOMPARE(v, frameValue(frame));
+
+    stream->release();
+}
+
+//---------------------------------------------------------
+//   loopPrefetch
+//    the voice plays the end of the sample and loops back
+//    to a frame in the first streamed block
+//---------------------------------------------------------
+
+void TestSampleStream::loopPrefetch()
+{
+    std::unique_ptr<SampleStream> stream = openStream();
+    QVERIFY(stream);
+    stream->acquire();
+
+    const long long playing = SAMPLE_FRAMES - 10;
+    const long long loopStart = FIRST_FRAME + 50;
+    stream->prefetch(playing);
+    stream->prefetch(loopStart);
+
+    QTRY_VERIFY(stream->decoded(playing) && stream->decoded(loopStart));
+    QVERIFY(!stream->decoded(FIRST_FRAME + SampleStream::BLOCK_FRAMES));
+
+    short v = 0;
+    QVERIFY(stream->value(loopStart, 0, v));
+    QCOMPARE(v, frameValue(loopStart));
+    QVERIFY(stream->value(SAMPLE_FRAMES - 1, 0, v));
+    QCOMPARE(v, frameValue(SAMPLE_FRAMES - 1));
+
+    stream->release();
+}
+
+//---------------------------------------------------------
+//   eviction
+//---------------------------------------------------------
+
+void TestSampleStream::eviction()
+{
+    const int idleTime = SampleStream::idleTime();
+    SampleStream::setIdleTime(0);
+
+    std::unique_ptr<SampleStream> stream = openStream();
+    QVERIFY(stream);
+    stream->acquire();
+    stream->prefetch(FIRST_FRAME);
+    QTRY_VERIFY(stream->decoded(FIRST_FRAME));
+
+    // nothing is freed while a voice uses the stream
+    QTest::qWait(1000);
+    QVERIFY(stream->decoded(FIRST_FRAME));
+
+    stream->release();
+    QTRY_VERIFY(!stream->decoded(FIRST_FRAME));
+
+    // and it is decoded again when asked for
+    stream->acquire();
+    stream->prefetch(FIRST_FRAME);
+    QTRY_VERIFY(stream->decoded(FIRST_FRAME));
+    stream->release();
+
+    SampleStream::setIdleTime(idleTime);
+}
+
+//---------------------------------------------------------
+//   openFiles
+//---------------------------------------------------------
+
+void TestSampleStream::openFiles()
+{
+    std::vector<std::unique_ptr<SampleStream> > streams;
+    for (int i = 0; i < SampleStream::MAX_OPEN_FILES + 8; ++i) {
+        streams.push_back(openStream());
+        QVERIFY(streams.back());
+        QVERIFY(SampleStream::openFiles() <= SampleStream::MAX_OPEN_FILES);
+    }
+
+    // streams whose file was closed reopen it
+    for (auto& s : streams) {
+        s->acquire();
+        s->prefetch(FIRST_FRAME);
+    }
+    for (auto& s : streams) {
+        QTRY_VERIFY(s->decoded(FIRST_FRAME));
+        short v = 0;
+        QVERIFY(s->value(FIRST_FRAME, 0, v));
+        QCOMPARE(v, frameValue(FIRST_FRAME));
+        s->release();
+    }
+    QCOMPARE(SampleStream::openFiles(), SampleStream::MAX_OPEN_FILES);
+
+    streams.clear();
+    QCOMPARE(SampleStream::openFiles(), 0);
+}
+
+//---------------------------------------------------------
+//   render
+//    play the whole sample at its pitch. The voice asks for
+//    each block PREFETCH_FRAMES ahead, the short waits
+//    between the calls leave the reader ample time.
+//---------------------------------------------------------
+
+std::vector<float> TestSampleStream::render(int preloadTime)
+{
+    const int preload = Zerberus::streamingPreloadTime();
+    Zerberus::setStreamingPreloadTime(preloadTime);
+
+    std::vector<float> out;
+    {
+        Zerberus synth;
+        synth.setSampleRate(SAMPLE_RATE);
+        if (!synth.addSoundFont(dir.filePath("stream.sfz"))) {
+            Zerberus::setStreamingPreloadTime(preload);
+            return out;
+        }
+        synth.noteOn(0, 60, 127);
+
+        const int frames = 512;
+        std::vector<float> buffer(2 * frames);
+        for (long long f = 0; f < SAMPLE_FRAMES + frames; f += frames) {
+            std::fill(buffer.begin(), buffer.end(), 0.f);
+            synth.process(frames, buffer.data(), nullptr, nullptr);
+            out.insert(out.end(), buffer.begin(), buffer.end());
+            QTest::qWait(1);
+        }
+    }
+    Zerberus::setStreamingPreloadTime(preload);
+    return out;
+}
+
+//---------------------------------------------------------
+//   streamedPlayback
+//---------------------------------------------------------
+
+void TestSampleStream::streamedPlayback()
+{
+    const std::vector<float> loaded = render(0);
+    QVERIFY(!loaded.empty());
+
+    const unsigned long long underruns = Zerberus::streamingUnderruns();
+    const std::vector<float> streamed = render(50);
+    QCOMPARE(Zerberus::streamingUnderruns(), underruns);
+    QVERIFY(streamed == loaded);
+}
+
+//---------------------------------------------------------
+//   preloadSetting
+//---------------------------------------------------------
+
+void TestSampleStream::preloadSetting()
+{
+    const Settings::Key key("audio", "zerberus_streaming_preload");
+    const Val saved = settings()->value(key);
+
+    AudioConfiguration configuration;
+    configuration.init();
+    QCOMPARE(Zerberus::streamingPreloadTime(), configuration.zerberusStreamingPreloadTime());
+
+    settings()->setValue(key, Val(500));
+    QCOMPARE(configuration.zerberusStreamingPreloadTime(), 500);
+    QCOMPARE(Zerberus::streamingPreloadTime(), 500);
+
+    settings()->setValue(key, Val(0));
+    QCOMPARE(Zerberus::streamingPreloadTime(), 0);
+
+    settings()->setValue(key, saved.isNull() ? Val(0) : saved);
+}
+
+QTEST_MAIN(TestSampleStream)
+#include "tst_samplestream.moc"
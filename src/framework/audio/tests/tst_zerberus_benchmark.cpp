@@ -0,0 +1,205 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "audio/internal/synthesizers/zerberus/internal/zerberus.h"
+
+using namespace mu::zerberus;
+
+static const QString DATA_DIR(QString(audio_tests_DATA_ROOT) + "/data/");
+static const float SAMPLE_RATE = 44100.0f;
+
+//---------------------------------------------------------
+//   TestZerberusBenchmark
+//---------------------------------------------------------
+
+class TestZerberusBenchmark : public QObject
+{
+    Q_OBJECT
+
+    Zerberus* synth { nullptr };
+
+    int activeVoices();
+    void startVoices();
+    static std::vector<float> render(bool simd);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testScalarKernels();       // the SSE/NEON kernels render what the scalar ones do
+    void benchmarkPolyphony();      // 256 looping stereo voices, 512 frames per call
+    void benchmarkVoicesPerCore();  // how many of these voices one core renders in real time
+};
+
+static const int VOICES = 256;
+static const int FRAMES = 512;
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestZerberusBenchmark::initTestCase()
+{
+    synth = new Zerberus();
+    synth->setSampleRate(SAMPLE_RATE);
+    QVERIFY(synth->addSoundFont(DATA_DIR + "polyphony.sfz"));
+}
+
+void TestZerberusBenchmark::cleanupTestCase()
+{
+    delete synth;
+    synth = nullptr;
+}
+
+//---------------------------------------------------------
+//   activeVoices
+//---------------------------------------------------------
+
+int TestZerberusBenchmark::activeVoices()
+{
+    int n = 0;
+    for (Voice* v = synth->getActiveVoices(); v; v = v->next()) {
+        ++n;
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   startVoices
+//---------------------------------------------------------
+
+void TestZerberusBenchmark::startVoices()
+{
+    for (int i = 0; i < VOICES; ++i) {
+        synth->noteOn(i / 128, i % 128, 100);
+    }
+}
+
+//---------------------------------------------------------
+//   render
+//    a second of the voices of polyphony.sfz with a fresh
+//    synthesizer, a quarter of them released half way
+//---------------------------------------------------------
+
+std::vector<float> TestZerberusBenchmark::render(bool simd)
+{
+    const bool saved = Voice::simdKernels();
+    Voice::setSimdKernels(simd);
+
+    std::vector<float> out;
+    Zerberus z;
+    z.setSampleRate(SAMPLE_RATE);
+    if (z.addSoundFont(DATA_DIR + "polyphony.sfz")) {
+        for (int i = 0; i < VOICES; ++i) {
+            z.noteOn(i / 128, i % 128, 40 + i % 80);
+        }
+        std::vector<float> buffer(2 * FRAMES);
+        const int calls = int(SAMPLE_RATE) / FRAMES;
+        for (int c = 0; c < calls; ++c) {
+            if (c == calls / 2) {
+                for (int i = 0; i < VOICES; i += 4) {
+                    z.noteOff(i / 128, i % 128);
+                }
+            }
+            std::fill(buffer.begin(), buffer.end(), 0.f);
+            z.process(FRAMES, buffer.data(), nullptr, nullptr);
+            out.insert(out.end(), buffer.begin(), buffer.end());
+        }
+    }
+
+    Voice::setSimdKernels(saved);
+    return out;
+}
+
+//---------------------------------------------------------
+//   testScalarKernels
+//---------------------------------------------------------
+
+void TestZerberusBenchmark::testScalarKernels()
+{
+    const std::vector<float> simd = render(true);
+    const std::vector<float> scalar = render(false);
+    QVERIFY(!simd.empty());
+    QCOMPARE(simd.size(), scalar.size());
+
+    float peak = 0.f;
+    float d = 0.f;
+    for (size_t i = 0; i < simd.size(); ++i) {
+        peak = std::max(peak, std::fabs(scalar[i]));
+        d = std::max(d, std::fabs(simd[i] - scalar[i]));
+    }
+    QVERIFY(peak > 0.01f);
+    QVERIFY(d <= 1e-6f * peak);
+}
+
+//---------------------------------------------------------
+//   benchmarkPolyphony
+//---------------------------------------------------------
+
+void TestZerberusBenchmark::benchmarkPolyphony()
+{
+    std::vector<float> buffer(2 * FRAMES);
+
+    startVoices();
+    synth->process(FRAMES, buffer.data(), nullptr, nullptr);
+    QCOMPARE(activeVoices(), VOICES);
+
+    QBENCHMARK {
+        synth->process(FRAMES, buffer.data(), nullptr, nullptr);
+    }
+
+    QCOMPARE(activeVoices(), VOICES);
+    synth->allNotesOff(-1);
+}
+
+//---------------------------------------------------------
+//   benchmarkVoicesPerCore
+//    reported as events, the number of voices
+//---------------------------------------------------------
+
+void TestZerberusBenchmark::benchmarkVoicesPerCore()
+{
+    std::vector<float> buffer(2 * FRAMES);
+
+    startVoices();
+    synth->process(FRAMES, buffer.data(), nullptr, nullptr);
+    QCOMPARE(activeVoices(), VOICES);
+
+    const int runs = 200;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < runs; ++i) {
+        synth->process(FRAMES, buffer.data(), nullptr, nullptr);
+    }
+    const double seconds = timer.nsecsElapsed() / 1e9;
+    const double audioSeconds = double(runs) * FRAMES / SAMPLE_RATE;
+    QTest::setBenchmarkResult(VOICES * audioSeconds / seconds, QTest::Events);
+
+    QCOMPARE(activeVoices(), VOICES);
+    synth->allNotesOff(-1);
+}
+
+QTEST_MAIN(TestZerberusBenchmark)
+#include "tst_zerberus_benchmark.moc"
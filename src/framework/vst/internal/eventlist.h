@@ -33,7 +33,7 @@ public:
 
     DECLARE_FUNKNOWN_METHODS
 
-    void addMidiEvent(const midi::Event& e);
+    void addMidiEvent(const midi::Event& e, Steinberg::int32 sampleOffset = 0);
     void clear();
 
     //methods for VST SDK:
@@ -42,7 +42,12 @@ public:
     Steinberg::tresult addEvent(Steinberg::Vst::Event& e) override;
 
 private:
-    std::vector<midi::Event> m_events = {};
+    struct TimedEvent {
+        midi::Event event;
+        Steinberg::int32 sampleOffset = 0;
+    };
+
+    std::vector<TimedEvent> m_events = {};
 };
 } // namespace vst
 } // namespace mu
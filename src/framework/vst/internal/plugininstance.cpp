@@ -108,9 +108,9 @@ bool PluginInstance::isActive() const
     return m_active;
 }
 
-void PluginInstance::addMidiEvent(const mu::midi::Event& e)
+void PluginInstance::addMidiEvent(const mu::midi::Event& e, int sampleOffset)
 {
-    m_events.addMidiEvent(e);
+    m_events.addMidiEvent(e, sampleOffset);
 }
 
 Ret PluginInstance::setSampleRate(int sampleRate)
@@ -66,7 +66,7 @@ public:
     bool isActive() const;
 
     //! add event for future processing
-    void addMidiEvent(const midi::Event& e);
+    void addMidiEvent(const midi::Event& e, int sampleOffset = 0);
 
     Ret setSampleRate(int sampleRate);
 
@@ -114,6 +114,12 @@ bool VSTSynthesizer::handleEvent(const midi::Event& e)
     return true;
 }
 
+void VSTSynthesizer::scheduleEvent(const midi::Event& e, unsigned int sampleOffset)
+{
+    //! NOTE VST events carry their offset into the block, the plugin applies it
+    m_instance->addMidiEvent(e, static_cast<int>(sampleOffset));
+}
+
 void VSTSynthesizer::writeBuf(float* stream, unsigned int samples)
 {
     m_instance->process(/*input stream*/ nullptr, stream, samples);
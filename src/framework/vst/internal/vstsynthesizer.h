@@ -48,6 +48,7 @@ public:
 
     Ret setupChannels(const std::vector<mu::midi::Event>& events) override;
     bool handleEvent(const mu::midi::Event& e) override;
+    void scheduleEvent(const mu::midi::Event& e, unsigned int sampleOffset) override;
     void writeBuf(float* stream, unsigned int samples) override;
 
     void allSoundsOff() override;
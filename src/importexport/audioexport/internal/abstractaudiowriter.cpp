@@ -0,0 +1,243 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "abstractaudiowriter.h"
+
+#include <cstring>
+#include <memory>
+#include <sndfile.h>
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::iex::audioexport;
+using namespace mu::audio;
+using namespace mu::notation;
+
+static const unsigned int SAMPLE_RATE = 44100;
+static const int CHANNELS = 2;
+
+namespace {
+//---------------------------------------------------------
+//   SndFileStream
+//    libsndfile writing to an IODevice through virtual io.
+//    libsndfile seeks back to fill in the header sizes on
+//    close; on a sequential device they stay unset.
+//---------------------------------------------------------
+
+class SndFileStream
+{
+public:
+    SndFileStream(system::IODevice* device)
+        : m_device(device) {}
+
+    ~SndFileStream()
+    {
+        close();
+    }
+
+    static SF_INFO info(int format)
+    {
+        SF_INFO info;
+        memset(&info, 0, sizeof(info));
+        info.samplerate = SAMPLE_RATE;
+        info.channels = CHANNELS;
+        info.format = format;
+        return info;
+    }
+
+    bool open(int format)
+    {
+        SF_INFO info = SndFileStream::info(format);
+        if (!sf_format_check(&info)) {
+            return false;
+        }
+
+        static SF_VIRTUAL_IO io = {
+            &SndFileStream::length,
+            &SndFileStream::seek,
+            &SndFileStream::read,
+            &SndFileStream::write,
+            &SndFileStream::tell
+        };
+
+        m_file = sf_open_virtual(&io, SFM_WRITE, &info, m_device);
+        if (!m_file) {
+            LOGE() << "sf_open_virtual failed: " << sf_strerror(nullptr);
+            return false;
+        }
+
+        sf_command(m_file, SFC_SET_CLIPPING, nullptr, SF_TRUE);
+        return true;
+    }
+
+    bool write(const float* data, unsigned int frames)
+    {
+        return sf_writef_float(m_file, data, frames) == static_cast<sf_count_t>(frames);
+    }
+
+    void close()
+    {
+        if (m_file) {
+            sf_close(m_file);
+            m_file = nullptr;
+        }
+    }
+
+private:
+    static system::IODevice* device(void* userData)
+    {
+        return static_cast<system::IODevice*>(userData);
+    }
+
+    static sf_count_t length(void* userData)
+    {
+        return device(userData)->size();
+    }
+
+    static sf_count_t seek(sf_count_t offset, int whence, void* userData)
+    {
+        system::IODevice* d = device(userData);
+        sf_count_t pos = offset;
+        if (whence == SEEK_CUR) {
+            pos += d->pos();
+        } else if (whence == SEEK_END) {
+            pos += d->size();
+        }
+        return d->seek(pos) ? pos : -1;
+    }
+
+    static sf_count_t read(void* ptr, sf_count_t count, void* userData)
+    {
+        return device(userData)->read(static_cast<char*>(ptr), count);
+    }
+
+    static sf_count_t write(const void* ptr, sf_count_t count, void* userData)
+    {
+        return device(userData)->write(static_cast<const char*>(ptr), count);
+    }
+
+    static sf_count_t tell(void* userData)
+    {
+        return device(userData)->pos();
+    }
+
+    system::IODevice* m_device = nullptr;
+    SNDFILE* m_file = nullptr;
+};
+}
+
+Ret AbstractAudioWriter::write(const INotationPtr notation, system::IODevice& destinationDevice, const Options& options)
+{
+    UNUSED(options)
+
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    return render(notation->playback()->offlineMidiStream(), { Target { {}, &destinationDevice } });
+}
+
+Ret AbstractAudioWriter::writeStream(const std::shared_ptr<midi::MidiStream>& stream, system::IODevice& destinationDevice)
+{
+    return render(stream, { Target { {}, &destinationDevice } });
+}
+
+Ret AbstractAudioWriter::writeParts(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                                    const Options& options)
+{
+    UNUSED(options)
+
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    //! NOTE the midi stream has a track per part, in the order of the parts
+    std::vector<Target> targets;
+    for (size_t i = 0; i < destinationDevices.size(); ++i) {
+        targets.push_back(Target { { static_cast<midi::track_t>(i) }, destinationDevices[i] });
+    }
+
+    return render(notation->playback()->offlineMidiStream(), targets);
+}
+
+void AbstractAudioWriter::abort()
+{
+    m_aborted = true;
+}
+
+Ret AbstractAudioWriter::checkFormat() const
+{
+    if (!isFormatSupported(format())) {
+        std::string text = std::string("the format is not supported by ") + sf_version_string();
+        LOGE() << text;
+        return make_ret(Ret::Code::NotSupported, text);
+    }
+    return make_ret(Ret::Code::Ok);
+}
+
+bool AbstractAudioWriter::isFormatSupported(int format)
+{
+    SF_INFO info = SndFileStream::info(format);
+    return sf_format_check(&info);
+}
+
+Ret AbstractAudioWriter::render(const std::shared_ptr<midi::MidiStream>& midiStream, const std::vector<Target>& targets)
+{
+    Ret ret = checkFormat();
+    if (!ret) {
+        return ret;
+    }
+
+    m_aborted = false;
+
+    std::vector<std::unique_ptr<SndFileStream> > streams;
+    std::vector<IOfflineRenderer::Job> jobs;
+    for (const Target& target : targets) {
+        auto stream = std::make_unique<SndFileStream>(target.device);
+        if (!stream->open(format())) {
+            return make_ret(Ret::Code::UnknownError);
+        }
+
+        SndFileStream* streamPtr = stream.get();
+        jobs.push_back({ target.tracks, [this, streamPtr](const float* data, unsigned int frames) {
+                             return !m_aborted && streamPtr->write(data, frames);
+                         } });
+        streams.push_back(std::move(stream));
+    }
+
+    IOfflineRenderer::Options options;
+    options.sampleRate = SAMPLE_RATE;
+
+    ret = offlineRenderer()->render(midiStream, options, jobs);
+    if (m_aborted) {
+        return make_ret(Ret::Code::Cancel);
+    }
+
+    if (ret.code() == static_cast<int>(Ret::Code::Cancel)) {
+        LOGE() << "failed to write the encoded audio";
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    //! NOTE closing writes the header and flushes the encoder
+    for (auto& stream : streams) {
+        stream->close();
+    }
+    return ret;
+}
@@ -0,0 +1,70 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
+#define MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "notation/abstractnotationwriter.h"
+
+#include "modularity/ioc.h"
+#include "audio/iofflinerenderer.h"
+
+namespace mu::iex::audioexport {
+//! Renders the score offline and encodes it with libsndfile while rendering,
+//! the encoded file is streamed to the device block by block
+class AbstractAudioWriter : public notation::AbstractNotationWriter
+{
+    INJECT(iex_audioexport, audio::IOfflineRenderer, offlineRenderer)
+
+public:
+    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+    //! stem export: the parts render in parallel from one midi stream, each with its own synthesizers
+    Ret writeParts(const notation::INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                   const Options& options = Options()) override;
+    void abort() override;
+
+    //! write() of a midi stream instead of a notation
+    Ret writeStream(const std::shared_ptr<midi::MidiStream>& stream, system::IODevice& destinationDevice);
+
+protected:
+    //! libsndfile format (major format | subtype) of the written file
+    virtual int format() const = 0;
+
+    //! NotSupported, with the reason as text, if the libsndfile in use can't write format()
+    virtual Ret checkFormat() const;
+    static bool isFormatSupported(int format);
+
+private:
+    struct Target {
+        std::set<midi::track_t> tracks;     //! all tracks if empty
+        system::IODevice* device = nullptr;
+    };
+
+    Ret render(const std::shared_ptr<midi::MidiStream>& stream, const std::vector<Target>& targets);
+
+    std::atomic<bool> m_aborted { false };
+};
+}
+
+#endif // MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
@@ -19,18 +19,31 @@
 
 #include "mp3writer.h"
 
+#include <sndfile.h>
+
 #include "log.h"
 
+using namespace mu;
 using namespace mu::iex::audioexport;
-using namespace mu::framework;
 
-mu::Ret Mp3Writer::write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options)
-{
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
+//! NOTE libsndfile encodes mp3 since 1.1.0 if it is built with lame;
+//! the values are spelled out to build against older headers,
+//! where the format check fails and the export reports NotSupported
+static const int SF_MPEG = 0x230000;
+static const int SF_MPEG_LAYER_III = 0x0082;
 
-    NOT_IMPLEMENTED;
+int Mp3Writer::format() const
+{
+    return SF_MPEG | SF_MPEG_LAYER_III;
+}
 
-    return make_ret(Ret::Code::NotImplemented);
+Ret Mp3Writer::checkFormat() const
+{
+    if (!isFormatSupported(format())) {
+        std::string text = std::string("mp3 export needs libsndfile 1.1.0 or later built with lame, found ")
+                           + sf_version_string();
+        LOGE() << text;
+        return make_ret(Ret::Code::NotSupported, text);
+    }
+    return make_ret(Ret::Code::Ok);
 }
@@ -20,13 +20,14 @@
 #ifndef MU_IMPORTEXPORT_MP3WRITER_H
 #define MU_IMPORTEXPORT_MP3WRITER_H
 
-#include "notation/abstractnotationwriter.h"
+#include "abstractaudiowriter.h"
 
 namespace mu::iex::audioexport {
-class Mp3Writer : public notation::AbstractNotationWriter
+class Mp3Writer : public AbstractAudioWriter
 {
-public:
-    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+protected:
+    int format() const override;
+    Ret checkFormat() const override;
 };
 }
 
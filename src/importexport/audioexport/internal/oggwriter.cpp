@@ -19,18 +19,11 @@
 
 #include "oggwriter.h"
 
-#include "log.h"
+#include <sndfile.h>
 
 using namespace mu::iex::audioexport;
-using namespace mu::system;
 
-mu::Ret OggWriter::write(const notation::INotationPtr notation, IODevice& destinationDevice, const Options& options)
+int OggWriter::format() const
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
-
-    NOT_IMPLEMENTED;
-
-    return make_ret(Ret::Code::NotImplemented);
+    return SF_FORMAT_OGG | SF_FORMAT_VORBIS;
 }
@@ -19,18 +19,11 @@
 
 #include "wavewriter.h"
 
-#include "log.h"
+#include <sndfile.h>
 
 using namespace mu::iex::audioexport;
-using namespace mu::framework;
 
-mu::Ret WaveWriter::write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options)
+int WaveWriter::format() const
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
-
-    NOT_IMPLEMENTED;
-
-    return make_ret(Ret::Code::NotImplemented);
+    return SF_FORMAT_WAV | SF_FORMAT_PCM_16;
 }
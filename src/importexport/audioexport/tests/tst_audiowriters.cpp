@@ -0,0 +1,255 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <QBuffer>
+#include <QTemporaryFile>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <sndfile.h>
+
+#include "importexport/audioexport/internal/wavewriter.h"
+#include "importexport/audioexport/internal/flacwriter.h"
+#include "importexport/audioexport/internal/oggwriter.h"
+#include "importexport/audioexport/internal/mp3writer.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::iex::audioexport;
+
+static const unsigned int SAMPLE_RATE = 44100;
+static const unsigned int FRAMES = SAMPLE_RATE;     // one second
+static const unsigned int BLOCK_FRAMES = 1024;
+static const int SF_MPEG = 0x230000;                // see mp3writer.cpp
+static const double PI = 3.14159265358979323846;
+
+namespace {
+//---------------------------------------------------------
+//   SineRenderer
+//    renders a stereo sine instead of the score
+//---------------------------------------------------------
+
+class SineRenderer : public IOfflineRenderer
+{
+public:
+    std::function<void(unsigned int block)> onBlock;
+
+    static float sample(unsigned int frame)
+    {
+        return 0.5f * std::sin(2.0 * PI * 441.0 * frame / SAMPLE_RATE);
+    }
+
+    Ret render(const std::shared_ptr<midi::MidiStream>&, const Options&, const std::vector<Job>& jobs) override
+    {
+        std::vector<float> block(BLOCK_FRAMES * 2);
+        for (const Job& job : jobs) {
+            for (unsigned int start = 0, b = 0; start < FRAMES; start += BLOCK_FRAMES, ++b) {
+                const unsigned int frames = std::min(BLOCK_FRAMES, FRAMES - start);
+                for (unsigned int i = 0; i < frames; ++i) {
+                    block[2 * i] = block[2 * i + 1] = sample(start + i);
+                }
+                if (onBlock) {
+                    onBlock(b);
+                }
+                if (!job.writer(block.data(), frames)) {
+                    return make_ret(Ret::Code::Cancel);
+                }
+            }
+        }
+        return make_ret(Ret::Code::Ok);
+    }
+};
+
+class UnsupportedWriter : public AbstractAudioWriter
+{
+protected:
+    int format() const override { return SF_FORMAT_WAV | SF_FORMAT_VORBIS; }
+};
+}
+
+//---------------------------------------------------------
+//   TestAudioWriters
+//---------------------------------------------------------
+
+class TestAudioWriters : public QObject
+{
+    Q_OBJECT
+
+    std::shared_ptr<AbstractAudioWriter> createWriter(const QString& suffix) const;
+
+private slots:
+    void writers_data();
+    void writers();             // the written file decodes to what was rendered
+    void abortCancels();        // abort() during the render cancels the export
+    void unsupportedFormat();   // a format libsndfile can't write is reported before rendering
+};
+
+//---------------------------------------------------------
+//   createWriter
+//---------------------------------------------------------
+
+std::shared_ptr<AbstractAudioWriter> TestAudioWriters::createWriter(const QString& suffix) const
+{
+    if (suffix == "wav") {
+        return std::make_shared<WaveWriter>();
+    }
+    if (suffix == "flac") {
+        return std::make_shared<FlacWriter>();
+    }
+    if (suffix == "ogg") {
+        return std::make_shared<OggWriter>();
+    }
+    if (suffix == "mp3") {
+        return std::make_shared<Mp3Writer>();
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------
+//   writers
+//---------------------------------------------------------
+
+void TestAudioWriters::writers_data()
+{
+    QTest::addColumn<QString>("suffix");
+    QTest::addColumn<int>("majorFormat");
+    QTest::addColumn<bool>("lossy");
+
+    QTest::newRow("wav") << QString("wav") << int(SF_FORMAT_WAV) << false;
+    QTest::newRow("flac") << QString("flac") << int(SF_FORMAT_FLAC) << false;
+    QTest::newRow("ogg") << QString("ogg") << int(SF_FORMAT_OGG) << true;
+    QTest::newRow("mp3") << QString("mp3") << SF_MPEG << true;
+}
+
+void TestAudioWriters::writers()
+{
+    QFETCH(QString, suffix);
+    QFETCH(int, majorFormat);
+    QFETCH(bool, lossy);
+
+    std::shared_ptr<AbstractAudioWriter> writer = createWriter(suffix);
+    writer->setofflineRenderer(std::make_shared<SineRenderer>());
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::ReadWrite));
+    Ret ret = writer->writeStream(std::make_shared<midi::MidiStream>(), buffer);
+    if (suffix == "mp3" && ret.code() == static_cast<int>(Ret::Code::NotSupported)) {
+        QVERIFY(!ret.text().empty());
+        QSKIP(ret.text().c_str());
+    }
+    QVERIFY(ret);
+    buffer.close();
+
+    // decode it again
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(buffer.data());
+    file.close();
+
+    SF_INFO info;
+    memset(&info, 0, sizeof(info));
+    SNDFILE* sf = sf_open(file.fileName().toLocal8Bit().constData(), SFM_READ, &info);
+    QVERIFY2(sf, sf_strerror(nullptr));
+    QCOMPARE(info.format & SF_FORMAT_TYPEMASK, majorFormat);
+    QCOMPARE(info.channels, 2);
+    QCOMPARE(info.samplerate, int(SAMPLE_RATE));
+
+    std::vector<float> decoded(info.frames * 2);
+    QCOMPARE(sf_readf_float(sf, decoded.data(), info.frames), info.frames);
+    sf_close(sf);
+
+    if (!lossy) {
+        QCOMPARE(info.frames, sf_count_t(FRAMES));
+        float d = 0.f;
+        for (unsigned int i = 0; i < FRAMES; ++i) {
+            d = std::max(d, std::fabs(decoded[2 * i] - SineRenderer::sample(i)));
+            d = std::max(d, std::fabs(decoded[2 * i + 1] - SineRenderer::sample(i)));
+        }
+        QVERIFY(d <= 2.f / 32768.f);     // 16 bit
+    } else {
+        // encoder delay and padding, but the same loudness
+        QVERIFY(std::abs(info.frames - sf_count_t(FRAMES)) <= 4096);
+        double sum = 0.0;
+        for (float v : decoded) {
+            sum += double(v) * v;
+        }
+        const double rms = std::sqrt(sum / decoded.size());
+        const double expected = 0.5 / std::sqrt(2.0);
+        QVERIFY(std::fabs(rms - expected) < 0.1 * expected);
+    }
+}
+
+//---------------------------------------------------------
+//   abortCancels
+//---------------------------------------------------------
+
+void TestAudioWriters::abortCancels()
+{
+    std::shared_ptr<AbstractAudioWriter> writer = createWriter("wav");
+    auto renderer = std::make_shared<SineRenderer>();
+    unsigned int blocks = 0;
+    renderer->onBlock = [&](unsigned int block) {
+        blocks = block + 1;
+        if (block == 3) {
+            writer->abort();
+        }
+    };
+    writer->setofflineRenderer(renderer);
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::ReadWrite));
+    Ret ret = writer->writeStream(std::make_shared<midi::MidiStream>(), buffer);
+    QCOMPARE(ret.code(), static_cast<int>(Ret::Code::Cancel));
+    QCOMPARE(blocks, 4u);
+
+    // a new export after an abort runs to the end
+    renderer->onBlock = nullptr;
+    QBuffer again;
+    QVERIFY(again.open(QIODevice::ReadWrite));
+    QVERIFY(writer->writeStream(std::make_shared<midi::MidiStream>(), again));
+}
+
+//---------------------------------------------------------
+//   unsupportedFormat
+//---------------------------------------------------------
+
+void TestAudioWriters::unsupportedFormat()
+{
+    UnsupportedWriter writer;
+    auto renderer = std::make_shared<SineRenderer>();
+    bool rendered = false;
+    renderer->onBlock = [&rendered](unsigned int) { rendered = true; };
+    writer.setofflineRenderer(renderer);
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::ReadWrite));
+    Ret ret = writer.writeStream(std::make_shared<midi::MidiStream>(), buffer);
+    QCOMPARE(ret.code(), static_cast<int>(Ret::Code::NotSupported));
+    QVERIFY(!ret.text().empty());
+    QVERIFY(!rendered);
+    QCOMPARE(buffer.size(), qint64(0));
+}
+
+QTEST_MAIN(TestAudioWriters)
+#include "tst_audiowriters.moc"
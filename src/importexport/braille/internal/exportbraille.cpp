@@ -17,6 +17,10 @@
 //  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 //=============================================================================
 
+#include "exportbraille.h"
+
+#include <algorithm>
+
 #include <QDebug>
 
 #include "libmscore/score.h"
@@ -71,6 +75,7 @@
 #include "libmscore/types.h"
 #include "libmscore/fingering.h"
 #include "libmscore/mmrest.h"
+#include "libmscore/measurerepeat.h"
 
 // Table 1. Page 2. Music Braille Code 2015.
 #define BRAILLE_EQUALS_METRONOME        QString("7")
@@ -316,140 +321,95 @@
 #define BRAILLE_LEFT_HAND_PIZZICATO     QString("_>")
 
 namespace Ms {
+//---------------------------------------------------------
+//   textToBrailleTable
+//    characters other than ASCII letters and digits which
+//    have a braille ASCII representation, sorted by code
+//---------------------------------------------------------
+
+struct TextToBraille {
+    char16_t c;
+    const char* braille;
+};
+
+static constexpr TextToBraille textToBrailleTable[] = {
+    { u'\n', "\n" },
+    { u' ', " " },
+    { u'!', "6" },
+    { u'(', "7" },
+    { u')', "7" },
+    { u'*', "99" },
+    { u',', "1" },
+    { u'-', "-" },
+    { u'.', "4" },
+    { u':', "3" },
+    { u';', "2" },
+    { u'=', "\"7" },
+    { u'?', "8" },
+
+    // Appendix B: Foreign language signs. Page 31.
+    // https://www.ukaaf.org/wp-content/uploads/B017-Braille-Music-and-Unified-English-Braille.pdf
+    { u'\u00A9', "~c" },      // ©
+    { u'\u00DF', "!" },       // ß
+    { u'\u00E0', "(" },       // à
+    { u'\u00E1', "(" },       // á
+    { u'\u00E2', "*" },       // â
+    { u'\u00E4', ">" },       // ä
+    { u'\u00E7', "&" },       // ç
+    { u'\u00E8', "!" },       // è
+    { u'\u00E9', "=" },       // é
+    { u'\u00EA', "<" },       // ê
+    { u'\u00EB', "$" },       // ë
+    { u'\u00EC', "/" },       // ì
+    { u'\u00ED', "/" },       // í
+    { u'\u00EE', "%" },       // î
+    { u'\u00EF', "]" },       // ï
+    { u'\u00F1', "]" },       // ñ
+    { u'\u00F2', "+" },       // ò
+    { u'\u00F3', "+" },       // ó
+    { u'\u00F4', "?" },       // ô
+    { u'\u00F6', "[" },       // ö
+    { u'\u00F9', ")" },       // ù
+    { u'\u00FA', ")" },       // ú
+    { u'\u00FB', ":" },       // û
+    { u'\u00FC', "\\" },      // ü
+    { u'\u0153', "[" },       // œ
+
+    // dynamics symbols
+    { u'\uE520', "p" },
+    { u'\uE521', "m" },
+    { u'\uE522', "f" },
+    { u'\uE523', "r" },
+    { u'\uE524', "s" },
+    { u'\uE525', "z" },
+    { u'\uE526', "n" },
+};
+
+static constexpr bool isSortedTable()
+{
+    for (size_t i = 1; i < sizeof(textToBrailleTable) / sizeof(textToBrailleTable[0]); ++i) {
+        if (textToBrailleTable[i - 1].c >= textToBrailleTable[i].c) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isSortedTable(), "textToBrailleTable must be sorted by character");
+
 //This class currently supports just a limited coversion from text to braille
 //TODO: enhance it to have full support from text to UEB, including contractions
 //http://www.brailleauthority.org/learn/braillebasic.pdf
 //https://www.teachingvisuallyimpaired.com/uploads/1/4/1/2/14122361/ueb_braille_chart.pdf
 class TextToUEBBraille
 {
-    const int MAX_CHARS_PER_LINE = 40;
     const QString ASCII_PREFIX_CAPITAL_LETTER = QString(",");
     const QString ASCII_PREFIX_CAPITAL_WORD = QString(",,");
     const QString ASCII_PREFIX_NUMBER = QString("#");
     const QString ASCII_END_OF_CAPITALISATION = QString(",");
     const QString ASCII_END_OF_NUMBER = QString(";");
 
-    QMap<QString, QString> textToBrailleASCII;
 public:
-    TextToUEBBraille()
-    {
-        textToBrailleASCII["a"] = 'a';
-        textToBrailleASCII["b"] = 'b';
-        textToBrailleASCII["c"] = 'c';
-        textToBrailleASCII["d"] = 'd';
-        textToBrailleASCII["e"] = 'e';
-        textToBrailleASCII["f"] = 'f';
-        textToBrailleASCII["g"] = 'g';
-        textToBrailleASCII["h"] = 'h';
-        textToBrailleASCII["i"] = 'i';
-        textToBrailleASCII["j"] = 'j';
-        textToBrailleASCII["k"] = 'k';
-        textToBrailleASCII["l"] = 'l';
-        textToBrailleASCII["m"] = 'm';
-        textToBrailleASCII["n"] = 'n';
-        textToBrailleASCII["o"] = 'o';
-        textToBrailleASCII["p"] = 'p';
-        textToBrailleASCII["q"] = 'q';
-        textToBrailleASCII["r"] = 'r';
-        textToBrailleASCII["s"] = 's';
-        textToBrailleASCII["t"] = 't';
-        textToBrailleASCII["u"] = 'u';
-        textToBrailleASCII["v"] = 'v';
-        textToBrailleASCII["w"] = 'w';
-        textToBrailleASCII["x"] = 'x';
-        textToBrailleASCII["y"] = 'y';
-        textToBrailleASCII["z"] = 'z';
-
-        textToBrailleASCII["A"] = 'a';
-        textToBrailleASCII["B"] = 'b';
-        textToBrailleASCII["C"] = 'c';
-        textToBrailleASCII["D"] = 'd';
-        textToBrailleASCII["E"] = 'e';
-        textToBrailleASCII["F"] = 'f';
-        textToBrailleASCII["G"] = 'g';
-        textToBrailleASCII["H"] = 'h';
-        textToBrailleASCII["I"] = 'i';
-        textToBrailleASCII["J"] = 'j';
-        textToBrailleASCII["K"] = 'k';
-        textToBrailleASCII["L"] = 'l';
-        textToBrailleASCII["M"] = 'm';
-        textToBrailleASCII["N"] = 'n';
-        textToBrailleASCII["O"] = 'o';
-        textToBrailleASCII["P"] = 'p';
-        textToBrailleASCII["Q"] = 'q';
-        textToBrailleASCII["R"] = 'r';
-        textToBrailleASCII["S"] = 's';
-        textToBrailleASCII["T"] = 't';
-        textToBrailleASCII["U"] = 'u';
-        textToBrailleASCII["V"] = 'v';
-        textToBrailleASCII["W"] = 'w';
-        textToBrailleASCII["X"] = 'x';
-        textToBrailleASCII["Y"] = 'y';
-        textToBrailleASCII["Z"] = 'z';
-
-        textToBrailleASCII["1"] = 'a';
-        textToBrailleASCII["2"] = 'b';
-        textToBrailleASCII["3"] = 'c';
-        textToBrailleASCII["4"] = 'd';
-        textToBrailleASCII["5"] = 'e';
-        textToBrailleASCII["6"] = 'f';
-        textToBrailleASCII["7"] = 'g';
-        textToBrailleASCII["8"] = 'h';
-        textToBrailleASCII["9"] = 'i';
-        textToBrailleASCII["0"] = 'j';
-
-        textToBrailleASCII[" "] = ' ';
-        textToBrailleASCII[","] = '1';
-        textToBrailleASCII[";"] = '2';
-        textToBrailleASCII[":"] = '3';
-        textToBrailleASCII["."] = '4';
-        textToBrailleASCII["!"] = '6';
-        textToBrailleASCII["("] = '7';
-        textToBrailleASCII[")"] = '7';
-        textToBrailleASCII["?"] = '8';
-        textToBrailleASCII["="] = "\"7";
-        textToBrailleASCII["\n"] = '\n';
-        textToBrailleASCII["©"] = "~c";
-        textToBrailleASCII["-"] = "-";
-        textToBrailleASCII["*"] = "99";
-
-        // Appendix B: Foreign language signs. Page 31.
-        // https://www.ukaaf.org/wp-content/uploads/B017-Braille-Music-and-Unified-English-Braille.pdf
-        textToBrailleASCII["ç"] = "&";
-        textToBrailleASCII["é"] = "=";
-        textToBrailleASCII["à"] = "(";
-        textToBrailleASCII["è"] = "!";
-        textToBrailleASCII["ù"] = ")";
-        textToBrailleASCII["â"] = "*";
-        textToBrailleASCII["ê"] = "<";
-        textToBrailleASCII["î"] = "%";
-        textToBrailleASCII["ô"] = "?";
-        textToBrailleASCII["û"] = ":";
-        textToBrailleASCII["ë"] = "$";
-        textToBrailleASCII["ï"] = "]";
-        textToBrailleASCII["ü"] = "\\";
-        textToBrailleASCII["œ"] = "[";
-        textToBrailleASCII["ß"] = "!";
-        textToBrailleASCII["ö"] = "[";
-        textToBrailleASCII["ä"] = ">";
-        textToBrailleASCII["ì"] = "/";
-        textToBrailleASCII["ò"] = "+";
-        textToBrailleASCII["á"] = "(";
-        textToBrailleASCII["ú"] = ")";
-        textToBrailleASCII["ñ"] = "]";
-        textToBrailleASCII["í"] = "/";
-        textToBrailleASCII["ó"] = "+";
-
-        // dynamics symbols
-        textToBrailleASCII[QChar(0xE520)] = "p";
-        textToBrailleASCII[QChar(0xE521)] = "m";
-        textToBrailleASCII[QChar(0xE522)] = "f";
-        textToBrailleASCII[QChar(0xE523)] = "r";
-        textToBrailleASCII[QChar(0xE524)] = "s";
-        textToBrailleASCII[QChar(0xE525)] = "z";
-        textToBrailleASCII[QChar(0xE526)] = "n";
-    }
-
     QString braille(QChar c);
     QString braille(QString text);
 };
@@ -463,11 +423,10 @@ class ExportBraille
     const int MAX_CHARS_PER_LINE = 40;
 
     Score* score;
+    BrailleExportCache* cache;
 
     /* ---------- Context ---------------- */
-    std::vector<Note*> previousNote;
-    std::vector<ClefType> currentCleffType;
-    std::vector<Key> currentKey;
+    std::vector<BrailleStaffContext> context;
     /* ----------------------------------- */
     void resetOctaves();
     void resetOctave(int stave);
@@ -477,6 +436,7 @@ class ExportBraille
 
     //utils. should we move these in libmscore?
     int computeInterval(Note* rootNote, Note* note, bool ignoreOctaves);
+    int computeInterval(int epitch1, int tpc1, int epitch2, int tpc2, bool ignoreOctaves);
     std::vector<Slur*> slurs(ChordRest* chordRest);
     std::vector<Hairpin*> hairpins(ChordRest* chordRest);
     int notesInSlur(Slur* slur);
@@ -489,6 +449,8 @@ class ExportBraille
     BarLine* lastBarline(Measure* measure, int track);
     BarLine* firstBarline(Measure* measure, int track);
 
+    quint64 measureHash(Measure* measure, int staffIdx);
+    QString cachedBrailleMeasure(Measure* measure, int staffIdx);
     QString brailleMeasure(Measure* measure, int staffCount);
     QString brailleClef(Clef* clef);
     QString brailleTimeSig(TimeSig* timeSig);
@@ -526,14 +488,11 @@ class ExportBraille
     QString brailleHairpinAfter(ChordRest* chordRest, std::vector<Hairpin*>* hairpin);
 
 public:
-    ExportBraille(Score* s)
+    ExportBraille(Score* s, BrailleExportCache* c = nullptr)
     {
         score = s;
-        for (int i = 0; i < score->staves().size(); ++i) {
-            previousNote.push_back(nullptr);
-            currentCleffType.push_back(ClefType::INVALID);
-            currentKey.push_back(Key::INVALID);
-        }
+        cache = c;
+        context.resize(score->staves().size());
     }
 
     void write(QIODevice* dev);
@@ -552,26 +511,73 @@ public:
 
 bool saveBraille(Score* score, QIODevice* device)
 {
-    ExportBraille eb(score);
+    return saveBraille(score, device, nullptr);
+}
+
+bool saveBraille(Score* score, const QString& name)
+{
+    return saveBraille(score, name, nullptr);
+}
+
+/**
+     Save Score as Braille, reusing the braille of the measures
+     which did not change since the last export with \a cache.
+     */
+
+bool saveBraille(Score* score, QIODevice* device, BrailleExportCache* cache)
+{
+    ExportBraille eb(score, cache);
     eb.write(device);
     return true;
 }
 
-bool saveBraille(Score* score, const QString& name)
+bool saveBraille(Score* score, const QString& name, BrailleExportCache* cache)
 {
     QFile f(name);
     if (!f.open(QIODevice::WriteOnly)) {
         return false;
     }
 
-    bool res = saveBraille(score, &f) && (f.error() == QFile::NoError);
+    bool res = saveBraille(score, &f, cache) && (f.error() == QFile::NoError);
     f.close();
     return res;
 }
 
+//---------------------------------------------------------
+//   BrailleExportCache
+//---------------------------------------------------------
+
+const BrailleExportCache::Entry* BrailleExportCache::find(const MeasureKey& key)
+{
+    auto i = _measures.find(key);
+    if (i == _measures.end()) {
+        ++_stats.misses;
+        return nullptr;
+    }
+    ++_stats.hits;
+    i->generation = _generation;
+    return &i.value();
+}
+
+void BrailleExportCache::insert(const MeasureKey& key, const QString& braille, const BrailleStaffContext& context)
+{
+    _measures.insert(key, { braille, context, _generation });
+}
+
+void BrailleExportCache::endExport()
+{
+    for (auto i = _measures.begin(); i != _measures.end();) {
+        if (i->generation != _generation) {
+            i = _measures.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
 void ExportBraille::resetOctave(int stave)
 {
-    previousNote[stave]  = nullptr;
+    context[stave].hasPreviousNote = false;
 }
 
 void ExportBraille::resetOctaves()
@@ -629,6 +635,9 @@ void ExportBraille::instruments(QIODevice* dev)
 
 void ExportBraille::write(QIODevice* dev)
 {
+    if (cache) {
+        cache->beginExport();
+    }
     credits(dev);
     instruments(dev);
     int nrStaves = score->staves().size();
@@ -664,7 +673,7 @@ void ExportBraille::write(QIODevice* dev)
         for (int i = 0; i < nrStaves; ++i) {
             qDebug() << "Measure " << mb->no() + 1 << " Staff " << i;
 
-            measureBraille[i] = brailleMeasure(m, i).toUtf8();
+            measureBraille[i] = cachedBrailleMeasure(m, i).toUtf8();
 
             if (measureBraille[i].size() > currentMeasureMaxLength) {
                 currentMeasureMaxLength = measureBraille[i].size();
@@ -726,6 +735,10 @@ void ExportBraille::write(QIODevice* dev)
         line[i] = QString();
     }
     out.flush();
+
+    if (cache) {
+        cache->endExport();
+    }
 }
 
 bool ExportBraille::ascendingChords(ClefType clefType)
@@ -781,11 +794,11 @@ bool ExportBraille::ascendingChords(ClefType clefType)
 QString ExportBraille::brailleClef(Clef* clef)
 {
     //In Braille, the clef is printed only at it's first appearance.
-    if (currentCleffType[clef->staffIdx()] == clef->clefType()) {
+    if (context[clef->staffIdx()].clef == clef->clefType()) {
         return QString();
     }
 
-    currentCleffType[clef->staffIdx()] = clef->clefType();
+    context[clef->staffIdx()].clef = clef->clefType();
     resetOctave(clef->staffIdx());
 
     switch (clef->clefType()) {
@@ -1042,6 +1055,219 @@ BarLine* ExportBraille::firstBarline(Measure* measure, int track)
     return nullptr;
 }
 
+//---------------------------------------------------------
+//   BrailleHasher
+//    64 bit FNV-1a over the values the braille of a
+//    measure is computed from
+//---------------------------------------------------------
+
+class BrailleHasher
+{
+    quint64 h { 14695981039346656037ULL };
+
+public:
+    void add(qint64 v)
+    {
+        for (int i = 0; i < 8; ++i) {
+            h ^= quint64(v >> (8 * i)) & 0xff;
+            h *= 1099511628211ULL;
+        }
+    }
+
+    void add(const QString& s)
+    {
+        add(s.size());
+        for (QChar c : s) {
+            h ^= c.unicode();
+            h *= 1099511628211ULL;
+        }
+    }
+
+    void add(const Fraction& f) { add((qint64(f.numerator()) << 32) ^ f.denominator()); }
+    quint64 result() const { return h; }
+};
+
+//---------------------------------------------------------
+//   hashElement
+//---------------------------------------------------------
+
+static void hashElement(BrailleHasher& h, const Element* e)
+{
+    h.add(int(e->type()));
+    h.add(e->track());
+    h.add(e->subtype());
+    h.add(e->tick());
+    h.add(e->visible());
+    if (e->isTextBase()) {
+        h.add(toTextBase(e)->xmlText());
+    }
+
+    switch (e->type()) {
+    case ElementType::CLEF:
+        h.add(int(toClef(e)->clefType()));
+        break;
+    case ElementType::KEYSIG:
+        h.add(int(toKeySig(e)->key()));
+        h.add(toKeySig(e)->isCustom());
+        break;
+    case ElementType::TIMESIG:
+        h.add(toTimeSig(e)->sig());
+        h.add(int(toTimeSig(e)->timeSigType()));
+        break;
+    case ElementType::BREATH:
+        h.add(int(toBreath(e)->symId()));
+        break;
+    case ElementType::MEASURE_REPEAT:
+        h.add(toMeasureRepeat(e)->numMeasures());
+        break;
+    case ElementType::MARKER:
+    case ElementType::JUMP:
+        // the text style decides on which side of the measure they are rendered
+        h.add(int(toTextBase(e)->tid()));
+        break;
+    default:
+        break;
+    }
+
+    if (!e->isChordRest()) {
+        return;
+    }
+    const ChordRest* cr = toChordRest(e);
+    h.add(int(cr->durationType().type()));
+    h.add(cr->dots());
+    h.add(cr->ticks());
+    if (cr->tuplet()) {
+        h.add(cr->tuplet()->ratio());
+        h.add(cr->tuplet()->tick());
+    }
+    for (const Element* el : cr->el()) {
+        hashElement(h, el);
+    }
+    if (!cr->isChord()) {
+        return;
+    }
+
+    const Chord* chord = toChord(cr);
+    h.add(int(chord->noteType()));
+    if (chord->arpeggio()) {
+        h.add(int(chord->arpeggio()->arpeggioType()));
+    }
+    if (chord->tremolo()) {
+        h.add(chord->tremolo()->subtype());
+    }
+    for (const Articulation* a : chord->articulations()) {
+        hashElement(h, a);
+    }
+    for (const Chord* grace : chord->graceNotes()) {
+        hashElement(h, grace);
+    }
+    for (const Note* note : chord->notes()) {
+        h.add(note->epitch());
+        h.add(note->tpc());
+        h.add(int(note->accidentalType()));
+        h.add(note->tieBack() != nullptr);
+        // a chord tie depends on the notes of the next chord
+        if (note->tieFor() && note->tieFor()->endNote()) {
+            const Chord* next = note->tieFor()->endNote()->chord();
+            h.add(next->tick());
+            for (const Note* n : next->notes()) {
+                h.add(n->epitch());
+                h.add(n->tieBack() != nullptr);
+            }
+        } else {
+            h.add(-1);
+        }
+        for (const Spanner* sp : note->spannerFor()) {
+            h.add(int(sp->type()));
+        }
+        for (const Element* el : note->el()) {
+            hashElement(h, el);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   measureHash
+//    hash of everything brailleMeasure() reads for the
+//    staff, including the spanners which overlap the
+//    measure and the chords ties lead to
+//---------------------------------------------------------
+
+quint64 ExportBraille::measureHash(Measure* measure, int staffIdx)
+{
+    BrailleHasher h;
+    h.add(measure->tick());
+    h.add(measure->ticks());
+    h.add(measure->mmRestCount());
+
+    for (const Element* el : measure->el()) {
+        if (el->isMarker() || el->isJump()) {
+            hashElement(h, el);
+        }
+    }
+
+    auto spanners = score->spannerMap().findOverlapping(measure->tick().ticks(), measure->endTick().ticks());
+    for (auto interval : spanners) {
+        Spanner* sp = interval.value;
+        if (!sp) {
+            continue;
+        }
+        h.add(int(sp->type()));
+        h.add(sp->tick());
+        h.add(sp->tick2());
+        h.add(sp->track());
+        h.add(sp->effectiveTrack2());
+        if (sp->isSlur()) {
+            h.add(notesInSlur(toSlur(sp)));
+        } else if (sp->isHairpin()) {
+            h.add(int(toHairpin(sp)->hairpinType()));
+            h.add(toHairpin(sp)->beginText());
+        } else if (sp->isVolta()) {
+            h.add(toVolta(sp)->text());
+            h.add(sp->startElement() == measure);
+        }
+    }
+
+    const int startTrack = staffIdx * VOICES;
+    const int endTrack   = startTrack + VOICES;
+    for (Segment* seg = measure->first(); seg; seg = seg->next()) {
+        for (const Element* annotation : seg->annotations()) {
+            if (annotation->isTempoText() || (annotation->track() >= startTrack && annotation->track() < endTrack)) {
+                hashElement(h, annotation);
+            }
+        }
+        for (int track = startTrack; track < endTrack; ++track) {
+            const Element* el = seg->element(track);
+            if (el) {
+                hashElement(h, el);
+            }
+        }
+    }
+    return h.result();
+}
+
+//---------------------------------------------------------
+//   cachedBrailleMeasure
+//    look the measure up by content and staff context;
+//    on a hit only the staff context after the measure
+//    is restored
+//---------------------------------------------------------
+
+QString ExportBraille::cachedBrailleMeasure(Measure* measure, int staffIdx)
+{
+    if (!cache) {
+        return brailleMeasure(measure, staffIdx);
+    }
+    const BrailleExportCache::MeasureKey key { measureHash(measure, staffIdx), staffIdx, context[staffIdx] };
+    if (const BrailleExportCache::Entry* entry = cache->find(key)) {
+        context[staffIdx] = entry->context;
+        return entry->braille;
+    }
+    QString braille = brailleMeasure(measure, staffIdx);
+    cache->insert(key, braille, context[staffIdx]);
+    return braille;
+}
+
 QString ExportBraille::brailleMeasure(Measure* measure, int staffCount)
 {
     QString rez;
@@ -1369,7 +1595,8 @@ QString ExportBraille::brailleChordRootNote(Chord* chord, Note* rootNote)
     int octave = rootNote->octave();
     // 3.2.1. Page 53. Music Braille Code 2015.
     // Octave signs at the beginning of the line or when the melodic line is interrupted by specific elements
-    if (!this->previousNote[chord->staffIdx()]) {
+    BrailleStaffContext& ctx = context[chord->staffIdx()];
+    if (!ctx.hasPreviousNote) {
         octaveBraille = brailleOctave(octave);
     }
     // 3.2.2. Octave signs in a melodic progression. Page 53. Music Braille Code 2015.
@@ -1377,12 +1604,15 @@ QString ExportBraille::brailleChordRootNote(Chord* chord, Note* rootNote)
     // b. the octave is always marked in a skip greater than a fifth
     // c. the octave is only marked in a skip of a fourth or fifth when the second note is in a different octave from the first.
     else {
-        int interval = computeInterval(previousNote[chord->staffIdx()], rootNote, false);
-        if (interval > 5 || (interval > 3 && (previousNote[chord->staffIdx()]->octave() != rootNote->octave()))) {
+        int interval = computeInterval(ctx.previousEpitch, ctx.previousTpc, rootNote->epitch(), rootNote->tpc(), false);
+        if (interval > 5 || (interval > 3 && (ctx.previousOctave != rootNote->octave()))) {
             octaveBraille = brailleOctave(octave);
         }
     }
-    previousNote[chord->staffIdx()] = rootNote;
+    ctx.hasPreviousNote = true;
+    ctx.previousEpitch  = rootNote->epitch();
+    ctx.previousTpc     = rootNote->tpc();
+    ctx.previousOctave  = rootNote->octave();
 
     QString accidentalBraille = QString();
     if (rootNote->accidental()) {
@@ -1407,12 +1637,17 @@ QString ExportBraille::brailleChordRootNote(Chord* chord, Note* rootNote)
 }
 
 int ExportBraille::computeInterval(Note* note1, Note* note2, bool ignoreOctave)
+{
+    return computeInterval(note1->epitch(), note1->tpc(), note2->epitch(), note2->tpc(), ignoreOctave);
+}
+
+int ExportBraille::computeInterval(int epitch1, int tpc1, int epitch2, int tpc2, bool ignoreOctave)
 {
     // TODO is it possible to not have pitch?
     // if yes, then this algorithm will fail in that case
 
     QList<QString> initNotes;
-    if (note1->epitch() < note2->epitch()) {
+    if (epitch1 < epitch2) {
         initNotes << "A" << "B" << "C" << "D" << "E" << "F" << "G";
     } else {
         initNotes << "G" << "F" << "E" << "D" << "C" << "B" << "A";
@@ -1421,8 +1656,8 @@ int ExportBraille::computeInterval(Note* note1, Note* note2, bool ignoreOctave)
     QString note1PitchName;
     QString note2PitchName;
     QString accidental; //We don't need this, but tpc2name requires it
-    tpc2name(note1->tpc(), NoteSpellingType::STANDARD, NoteCaseType::UPPER, note1PitchName, accidental);
-    tpc2name(note2->tpc(), NoteSpellingType::STANDARD, NoteCaseType::UPPER, note2PitchName, accidental);
+    tpc2name(tpc1, NoteSpellingType::STANDARD, NoteCaseType::UPPER, note1PitchName, accidental);
+    tpc2name(tpc2, NoteSpellingType::STANDARD, NoteCaseType::UPPER, note2PitchName, accidental);
 
     QList<QString> notes;
     int rootNodeIdx = initNotes.indexOf(note1PitchName);
@@ -1434,8 +1669,8 @@ int ExportBraille::computeInterval(Note* note1, Note* note2, bool ignoreOctave)
     }
 
     int interval = notes.indexOf(note2PitchName) + 1;
-    if (!ignoreOctave && abs(note1->epitch() - note2->epitch()) >= 12) {
-        interval += (abs(note1->epitch() - note2->epitch()) / 12) * 8 - 1;
+    if (!ignoreOctave && abs(epitch1 - epitch2) >= 12) {
+        interval += (abs(epitch1 - epitch2) / 12) * 8 - 1;
     }
 
     return interval;
@@ -1540,7 +1775,7 @@ QString ExportBraille::brailleChord(Chord* chord)
     // In Treble, Soprano, Alto clefs: Write the upper most note, then rest of notes as intervals downward
     // In Tenor, Baritone, Bass clefs: Write the lower most note, then rest of notes as intervals upward
     QList<Note*> notes;
-    if (ascendingChords(currentCleffType[chord->staffIdx()])) {
+    if (ascendingChords(context[chord->staffIdx()].clef)) {
         for (auto it = chord->notes().begin(); it != chord->notes().end(); ++it) {
             notes.push_back(*it);
         }
@@ -1793,11 +2028,11 @@ QString ExportBraille::brailleKeySig(KeySig* keySig)
     //In Braille, the key signature is printed only at it's first appearance.
     //Paragraf 6.5. Page 61. Music Braille Code 2015.
     if (!keySig || keySig->segment()->isKeySigAnnounceType()
-        || (currentKey[keySig->staffIdx()] == keySig->key() && !keySig->isCustom())) {
+        || (context[keySig->staffIdx()].key == keySig->key() && !keySig->isCustom())) {
         return QString();
     }
 
-    currentKey[keySig->staffIdx()] = keySig->key();
+    context[keySig->staffIdx()].key = keySig->key();
     resetOctave(keySig->staffIdx());
 
     QString brailleKeySig = QString();
@@ -2522,8 +2757,18 @@ QString ExportBraille::brailleJump(Jump* jump)
 
 QString TextToUEBBraille::braille(QChar c)
 {
-    if (textToBrailleASCII[c] != nullptr) {
-        return QString(textToBrailleASCII[c]);
+    const char16_t u = c.unicode();
+    if ((u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z')) {
+        return QString(QChar(u | 0x20));
+    }
+    if (u >= '0' && u <= '9') {
+        return QString(QLatin1Char("jabcdefghi"[u - '0']));
+    }
+    const TextToBraille* end = std::end(textToBrailleTable);
+    const TextToBraille* i = std::lower_bound(std::begin(textToBrailleTable), end, u,
+                                              [](const TextToBraille& e, char16_t ch) { return e.c < ch; });
+    if (i != end && i->c == u) {
+        return QString(i->braille);
     }
     return QString(c);
 }
@@ -0,0 +1,122 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef __EXPORTBRAILLE_H__
+#define __EXPORTBRAILLE_H__
+
+#include <QHash>
+#include <QString>
+
+#include "libmscore/clef.h"
+#include "libmscore/key.h"
+
+class QIODevice;
+
+namespace Ms {
+class Score;
+
+//---------------------------------------------------------
+//   BrailleStaffContext
+//    what the braille of a measure depends on besides the
+//    measure itself: the clef and key last written on the
+//    staff and the note octave marks are relative to
+//---------------------------------------------------------
+
+struct BrailleStaffContext {
+    ClefType clef       { ClefType::INVALID };
+    Key key             { Key::INVALID };
+    bool hasPreviousNote { false };
+    int previousEpitch  { 0 };
+    int previousTpc     { 0 };
+    int previousOctave  { 0 };
+
+    bool operator==(const BrailleStaffContext& c) const
+    {
+        return clef == c.clef && key == c.key && hasPreviousNote == c.hasPreviousNote
+               && (!hasPreviousNote
+                   || (previousEpitch == c.previousEpitch && previousTpc == c.previousTpc
+                       && previousOctave == c.previousOctave));
+    }
+};
+
+//---------------------------------------------------------
+//   BrailleExportCache
+//    braille of the measures of a score, kept from one
+//    export to the next. A measure is translated again
+//    only if its content hash or the staff context it
+//    starts with changed; entries an export did not use
+//    are dropped at its end.
+//---------------------------------------------------------
+
+class BrailleExportCache
+{
+public:
+    struct Stats {
+        int hits;
+        int misses;
+    };
+
+private:
+    friend class ExportBraille;
+
+    struct MeasureKey {
+        quint64 content;
+        int staffIdx;
+        BrailleStaffContext context;
+        bool operator==(const MeasureKey& k) const
+        {
+            return content == k.content && staffIdx == k.staffIdx && context == k.context;
+        }
+    };
+    friend uint qHash(const MeasureKey& k, uint seed)
+    {
+        uint h = ::qHash(k.content, seed) ^ uint(k.staffIdx);
+        h = 31 * h + uint(k.context.clef);
+        h = 31 * h + uint(k.context.key);
+        return k.context.hasPreviousNote ? 31 * h + uint(k.context.previousEpitch) : h;
+    }
+
+    struct Entry {
+        QString braille;
+        BrailleStaffContext context;       // staff context after the measure
+        int generation;
+    };
+
+    QHash<MeasureKey, Entry> _measures;
+    int _generation { 0 };
+    Stats _stats { 0, 0 };
+
+    const Entry* find(const MeasureKey& key);
+    void insert(const MeasureKey& key, const QString& braille, const BrailleStaffContext& context);
+    void beginExport() { ++_generation; }
+    void endExport();
+
+public:
+    int size() const { return _measures.size(); }
+    void clear() { _measures.clear(); }
+    Stats stats() const { return _stats; }
+    void resetStats() { _stats = { 0, 0 }; }
+};
+
+bool saveBraille(Score* score, QIODevice* device);
+bool saveBraille(Score* score, const QString& name);
+bool saveBraille(Score* score, QIODevice* device, BrailleExportCache* cache);
+bool saveBraille(Score* score, const QString& name, BrailleExportCache* cache);
+}     // namespace Ms
+#endif
@@ -21,17 +21,22 @@
 
 #include "testbase.h"
 
+#include <QBuffer>
+#include <QDir>
+#include <QFileInfo>
+
 #include "libmscore/score.h"
+#include "importexport/braille/internal/exportbraille.h"
 
 // start includes required for fixupScore()
 #include "libmscore/measure.h"
 #include "libmscore/staff.h"
 #include "libmscore/keysig.h"
 // end includes required for fixupScore()
-
-namespace Ms {
-extern bool saveBraille(Score*, const QString&);
-}
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/segment.h"
+#include "libmscore/textbase.h"
 
 static const QString BRAILLE_DIR("data/");
 
@@ -46,6 +51,7 @@ class TestBrailleIO : public QObject, public MTest
     Q_OBJECT
 
     void brailleMscxExportTestRef(const char* file);
+    std::vector<MasterScore*> readCorpus();
 
 private slots:
     void initTestCase();
@@ -106,6 +112,13 @@ private slots:
     // removed the 4th measure from the example as MuseScore does not have a representations for mordents with accidentals
     void hairpins() { brailleMscxExportTestRef("testHairpins_Example_22.3.3.2_MBC2015"); }
     void sectionBreak() { brailleMscxExportTestRef("testSectionBreak"); }
+
+    void cachedExport();
+    void cachedExportAfterEdit();
+    void cachedExportAfterMarkerMove();    // a marker moved to the other side of its measure is rendered again
+
+    void benchmarkExport();           // export the whole corpus
+    void benchmarkCachedExport();     // export the corpus again, reusing the braille of unchanged measures
 };
 
 //---------------------------------------------------------
@@ -147,5 +160,199 @@ void TestBrailleIO::brailleMscxExportTestRef(const char* file)
     delete score;
 }
 
+//---------------------------------------------------------
+//   cachedExport
+//    the second export of every corpus file with a cache
+//    reuses the braille of every measure and still matches
+//    the reference
+//---------------------------------------------------------
+
+void TestBrailleIO::cachedExport()
+{
+    const QStringList files = QDir(root + "/" + BRAILLE_DIR).entryList({ "*.mscx" }, QDir::Files, QDir::Name);
+    QVERIFY(!files.empty());
+    for (const QString& f : files) {
+        const QString file = QFileInfo(f).completeBaseName();
+        if (!QFileInfo::exists(root + "/" + BRAILLE_DIR + file + "_ref.brf")) {
+            continue;
+        }
+        MasterScore* score = readScore(BRAILLE_DIR + f);
+        QVERIFY(score);
+        fixupScore(score);
+        score->doLayout();
+        BrailleExportCache cache;
+        QVERIFY(Ms::saveBraille(score, file + "_cached.brf", &cache));
+        cache.resetStats();
+        QVERIFY(Ms::saveBraille(score, file + "_cached.brf", &cache));
+        QVERIFY(cache.stats().hits > 0);
+        QCOMPARE(cache.stats().misses, 0);
+        QVERIFY(compareFiles(file + "_cached.brf", BRAILLE_DIR + file + "_ref.brf"));
+        delete score;
+    }
+}
+
+//---------------------------------------------------------
+//   cachedExportAfterEdit
+//    after a measure is edited, an export with the cache
+//    of the previous export equals a fresh export
+//---------------------------------------------------------
+
+void TestBrailleIO::cachedExportAfterEdit()
+{
+    MasterScore* score = readScore(BRAILLE_DIR + "testPitches.mscx");
+    QVERIFY(score);
+    fixupScore(score);
+    score->doLayout();
+
+    BrailleExportCache cache;
+    QBuffer cached;
+    cached.open(QIODevice::WriteOnly);
+    QVERIFY(Ms::saveBraille(score, &cached, &cache));
+    cached.close();
+
+    // move the first note of the second measure up an octave
+    Measure* m = score->firstMeasure()->nextMeasure();
+    QVERIFY(m);
+    Segment* s = m->first(SegmentType::ChordRest);
+    while (s && !(s->element(0) && s->element(0)->isChord())) {
+        s = s->next(SegmentType::ChordRest);
+    }
+    QVERIFY(s);
+    Note* note = toChord(s->element(0))->upNote();
+    score->startCmd();
+    score->undoChangePitch(note, note->pitch() + 12, note->tpc1(), note->tpc2());
+    score->endCmd();
+
+    cache.resetStats();
+    QBuffer incremental;
+    incremental.open(QIODevice::WriteOnly);
+    QVERIFY(Ms::saveBraille(score, &incremental, &cache));
+    incremental.close();
+    QVERIFY(cache.stats().hits > 0);
+    QVERIFY(cache.stats().misses > 0);
+
+    QBuffer fresh;
+    fresh.open(QIODevice::WriteOnly);
+    QVERIFY(Ms::saveBraille(score, &fresh));
+    fresh.close();
+
+    QVERIFY(incremental.data() != cached.data());
+    QCOMPARE(incremental.data(), fresh.data());
+    delete score;
+}
+
+//---------------------------------------------------------
+//   cachedExportAfterMarkerMove
+//    markers and jumps are rendered on the left or the
+//    right of their measure depending on their text style
+//---------------------------------------------------------
+
+void TestBrailleIO::cachedExportAfterMarkerMove()
+{
+    MasterScore* score = readScore(BRAILLE_DIR + "testJumps_Example_20.2.1_MBC2015.mscx");
+    QVERIFY(score);
+    fixupScore(score);
+    score->doLayout();
+
+    BrailleExportCache cache;
+    QBuffer cached;
+    cached.open(QIODevice::WriteOnly);
+    QVERIFY(Ms::saveBraille(score, &cached, &cache));
+    cached.close();
+
+    TextBase* marker = nullptr;
+    for (Measure* m = score->firstMeasure(); m && !marker; m = m->nextMeasure()) {
+        for (Element* el : m->el()) {
+            if (el->isMarker() || el->isJump()) {
+                marker = toTextBase(el);
+                break;
+            }
+        }
+    }
+    QVERIFY(marker);
+    const Tid tid = marker->tid() == Tid::REPEAT_LEFT ? Tid::REPEAT_RIGHT : Tid::REPEAT_LEFT;
+    score->startCmd();
+    marker->undoChangeProperty(Pid::SUB_STYLE, int(tid));
+    score->endCmd();
+    QCOMPARE(marker->tid(), tid);
+
+    cache.resetStats();
+    QBuffer incremental;
+    incremental.open(QIODevice::WriteOnly);
+    QVERIFY(Ms::saveBraille(score, &incremental, &cache));
+    incremental.close();
+    QVERIFY(cache.stats().misses > 0);
+
+    QBuffer fresh;
+    fresh.open(QIODevice::WriteOnly);
+    QVERIFY(Ms::saveBraille(score, &fresh));
+    fresh.close();
+
+    QVERIFY(incremental.data() != cached.data());
+    QCOMPARE(incremental.data(), fresh.data());
+    delete score;
+}
+
+//---------------------------------------------------------
+//   readCorpus
+//---------------------------------------------------------
+
+std::vector<MasterScore*> TestBrailleIO::readCorpus()
+{
+    std::vector<MasterScore*> scores;
+    const QStringList files = QDir(root + "/" + BRAILLE_DIR).entryList({ "*.mscx" }, QDir::Files, QDir::Name);
+    for (const QString& file : files) {
+        MasterScore* score = readScore(BRAILLE_DIR + file);
+        if (score) {
+            fixupScore(score);
+            score->doLayout();
+            scores.push_back(score);
+        }
+    }
+    return scores;
+}
+
+void TestBrailleIO::benchmarkExport()
+{
+    const bool debugMode = MScore::debugMode;
+    MScore::debugMode = false;
+    std::vector<MasterScore*> scores = readCorpus();
+    QVERIFY(!scores.empty());
+    QBuffer buffer;
+    QBENCHMARK {
+        for (MasterScore* score : scores) {
+            buffer.open(QIODevice::WriteOnly);
+            Ms::saveBraille(score, &buffer);
+            buffer.close();
+        }
+    }
+    qDeleteAll(scores);
+    MScore::debugMode = debugMode;
+}
+
+void TestBrailleIO::benchmarkCachedExport()
+{
+    const bool debugMode = MScore::debugMode;
+    MScore::debugMode = false;
+    std::vector<MasterScore*> scores = readCorpus();
+    QVERIFY(!scores.empty());
+    std::vector<BrailleExportCache> caches(scores.size());
+    QBuffer buffer;
+    QBENCHMARK {
+        for (size_t i = 0; i < scores.size(); ++i) {
+            buffer.open(QIODevice::WriteOnly);
+            Ms::saveBraille(scores[i], &buffer, &caches[i]);
+            buffer.close();
+        }
+    }
+    int hits = 0;
+    for (const BrailleExportCache& cache : caches) {
+        hits += cache.stats().hits;
+    }
+    QVERIFY(hits > 0);
+    qDeleteAll(scores);
+    MScore::debugMode = debugMode;
+}
+
 QTEST_MAIN(TestBrailleIO)
 #include "tst_braille_io.moc"
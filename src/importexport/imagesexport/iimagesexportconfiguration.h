@@ -38,6 +38,11 @@ public:
     virtual float exportPngDpiResolution() const = 0;
     virtual bool exportPngWithTransparentBackground() const = 0;
 
+    // Svg
+    //! off by default: files with <use> references to glyph <defs> are smaller,
+    //! but not every consumer of exported svg handles them
+    virtual bool exportSvgReuseGlyphs() const = 0;
+
     //! NOTE Maybe set from command line
     virtual void setExportPngDpiResolution(std::optional<float> dpi) = 0;
 };
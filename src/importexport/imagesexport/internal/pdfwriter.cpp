@@ -23,8 +23,14 @@
 
 #include "libmscore/score.h"
 
+#include <deque>
+
 #include <QPdfWriter>
 #include <QPainter>
+#include <QPicture>
+#include <QSharedPointer>
+#include <QThread>
+#include <QtConcurrent>
 
 using namespace mu::iex::imagesexport;
 using namespace mu::system;
@@ -41,7 +47,6 @@ mu::Ret PdfWriter::write(const notation::INotationPtr notation, IODevice& destin
     }
 
     score->setPrinting(true);
-    MScore::pdfPrinting = true;
 
     QPdfWriter pdfWriter(&destinationDevice);
     pdfWriter.setResolution(configuration()->exportPdfDpiResolution());
@@ -49,6 +54,16 @@ mu::Ret PdfWriter::write(const notation::INotationPtr notation, IODevice& destin
     pdfWriter.setTitle(documentTitle(*score));
     pdfWriter.setPageMargins(QMarginsF());
 
+    // Pages are recorded into QPictures on the thread pool and replayed
+    // into the PDF in order. A QPicture records fonts at its own resolution
+    // and resolves them against the target device on replay, so font sizes
+    // are computed for the resolution of the PDF writer, which is set from
+    // the configuration and does not depend on the screen.
+    // Each pool task installs this context for itself.
+    RenderContext ctx = RenderContext::current();
+    ctx.pdfPrinting = true;
+    ctx.pixelRatio  = DPI / pdfWriter.logicalDpiX();
+
     QPainter painter;
     if (!painter.begin(&pdfWriter)) {
         return false;
@@ -61,21 +76,39 @@ mu::Ret PdfWriter::write(const notation::INotationPtr notation, IODevice& destin
                               size.height() * pdfWriter.logicalDpiY()));
     painter.setWindow(QRect(0.0, 0.0, size.width() * DPI, size.height() * DPI));
 
-    double pixelRationBackup = MScore::pixelRatio;
-    MScore::pixelRatio = DPI / pdfWriter.logicalDpiX();
+    using PagePicture = QSharedPointer<QPicture>;
+    auto recordPage = [score, ctx](int pageNumber) {
+        RenderContextScope renderContext(ctx);
+        PagePicture picture(new QPicture);
+        QPainter p(picture.data());
+        p.setRenderHint(QPainter::Antialiasing, true);
+        p.setRenderHint(QPainter::TextAntialiasing, true);
+        score->printPage(&p, pageNumber);
+        p.end();
+        return picture;
+    };
+
+    // keep a bounded number of recorded pages in flight, so that
+    // memory does not grow with the length of the score
+    const int pages    = score->npages();
+    const int inFlight = qMax(2, 2 * QThread::idealThreadCount());
+    std::deque<QFuture<PagePicture> > queue;
+    int nextPage = 0;
+    for (int pageNumber = 0; pageNumber < pages; ++pageNumber) {
+        while (nextPage < pages && int(queue.size()) < inFlight) {
+            queue.push_back(QtConcurrent::run(recordPage, nextPage++));
+        }
+        PagePicture picture = queue.front().result();
+        queue.pop_front();
 
-    for (int pageNumber = 0; pageNumber < score->npages(); ++pageNumber) {
         if (pageNumber > 0) {
             pdfWriter.newPage();
         }
-
-        score->print(&painter, pageNumber);
+        painter.drawPicture(0, 0, *picture);
     }
 
     painter.end();
     score->setPrinting(false);
-    MScore::pixelRatio = pixelRationBackup;
-    MScore::pdfPrinting = false;
 
     return true;
 }
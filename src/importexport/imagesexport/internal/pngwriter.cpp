@@ -44,8 +44,6 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
 
     score->setPrinting(true); // don’t print page break symbols etc.
 
-    double pixelRatioBackup = Ms::MScore::pixelRatio;
-
     const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
     const QList<Ms::Page*>& pages = score->pages();
 
@@ -75,7 +73,9 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
     image.fill(TRANSPARENT_BACKGROUND ? 0 : Qt::white);
 
     double scaling = CANVAS_DPI / Ms::DPI;
-    Ms::MScore::pixelRatio = 1.0 / scaling;
+    Ms::RenderContext ctx = Ms::RenderContext::current();
+    ctx.pixelRatio = 1.0 / scaling;
+    Ms::RenderContextScope renderContext(ctx);
 
     QPainter painter(&image);
     painter.setRenderHint(QPainter::Antialiasing, true);
@@ -92,7 +92,6 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
     image.save(&destinationDevice, "png");
 
     score->setPrinting(false);
-    Ms::MScore::pixelRatio = pixelRatioBackup;
 
     return true;
 }
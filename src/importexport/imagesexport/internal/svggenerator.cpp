@@ -39,6 +39,7 @@
 **
 ****************************************************************************/
 
+#include <QHash>
 #include <QTextStream>
 #include <QBuffer>
 #include <QTextCodec>
@@ -189,9 +190,7 @@ public:
     QTextStream* stream;
     int resolution;
 
-    QString header;
-//    QString defs; // NEEDED FOR GRADIENTS
-    QString body;
+    QString defs;
 
     QBrush brush;
     QPen pen;
@@ -247,11 +246,18 @@ private:
     qreal _dx { 0.0 };
     qreal _dy { 0.0 };
 
+// Glyph reuse: paths drawn more than once (noteheads, accidentals, clefs...)
+// are written once as a <g> in <defs> and instantiated with <use>.
+    bool _reuseGlyphs { false };
+    QHash<QString, int> _glyphIds;         // path data relative to its first point -> glyph number
+
 protected:
 // The Ms::Element being generated right now
     const Ms::Element* _element = NULL;
 
     void writeImage(const QRectF& r, const QByteArray& imageData, const QString& mimeFormat);
+    void writePathData(QTextStream& s, const QPainterPath& p, qreal dx, qreal dy) const;
+    bool drawGlyph(const QPainterPath& p);
 
 // SVG strings as constants
 #define SVG_SPACE    ' '
@@ -298,6 +304,13 @@ protected:
 #define SVG_IMAGE       "<image"
 #define SVG_PATH        "<path"
 #define SVG_POLYLINE    "<polyline"
+#define SVG_USE         "<use"
+#define SVG_HREF        " xlink:href=\"#"
+#define SVG_GROUP_BEGIN  "<g id=\""
+#define SVG_GROUP_END    "</g>"
+#define SVG_DEFS_BEGIN   "<defs>"
+#define SVG_DEFS_END     "</defs>"
+#define SVG_GLYPH_ID     "g"
 
 #define SVG_PRESERVE_ASPECT " preserveAspectRatio=\""
 
@@ -1025,6 +1038,16 @@ void SvgGenerator::setElement(const Ms::Element* e)
     static_cast<SvgPaintEngine*>(paintEngine())->_element = e;
 }
 
+/*!
+    setReuseGlyphs() function
+    Write paths that are drawn repeatedly, like noteheads and
+    accidentals, once as a <g> in <defs> and draw them with <use>.
+*/
+void SvgGenerator::setReuseGlyphs(bool val)
+{
+    static_cast<SvgPaintEngine*>(paintEngine())->_reuseGlyphs = val;
+}
+
 /*****************************************************************************
  * class SvgPaintEngine
  */
@@ -1050,9 +1073,16 @@ bool SvgPaintEngine::begin(QPaintDevice*)
         return false;
     }
 
-    // Stream the headers
-    d->stream = new QTextStream(&d->header);
-    stream() << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>" << Qt::endl << SVG_BEGIN;
+    // Stream everything straight to the output device; QTextStream
+    // buffers the writes, so avoid Qt::endl, which flushes
+    d->stream = new QTextStream(d->outputDevice);
+#ifndef QT_NO_TEXTCODEC
+    d->stream->setCodec(QTextCodec::codecForName("UTF-8"));
+#endif
+    d->defs.clear();
+    _glyphIds.clear();
+
+    stream() << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>" << '\n' << SVG_BEGIN;
     if (d->viewBox.isValid()) {
         // viewBox has floating point values, size width/height is integer
         stream() << SVG_WIDTH << d->viewBox.width() << SVG_PX << SVG_QUOTE
@@ -1061,24 +1091,18 @@ bool SvgPaintEngine::begin(QPaintDevice*)
         stream() << SVG_VIEW_BOX << d->viewBox.left()
                  << SVG_SPACE << d->viewBox.top()
                  << SVG_SPACE << d->viewBox.width()
-                 << SVG_SPACE << d->viewBox.height() << SVG_QUOTE << Qt::endl;
+                 << SVG_SPACE << d->viewBox.height() << SVG_QUOTE << '\n';
     }
     stream() << " xmlns=\"http://www.w3.org/2000/svg\""
                 " xmlns:xlink=\"http://www.w3.org/1999/xlink\""
-                " version=\"1.2\" baseProfile=\"tiny\">" << Qt::endl;
+                " version=\"1.2\" baseProfile=\"tiny\">" << '\n';
     if (!d->attributes.title.isEmpty()) {
-        stream() << SVG_TITLE_BEGIN << d->attributes.title.toHtmlEscaped() << SVG_TITLE_END << Qt::endl;
+        stream() << SVG_TITLE_BEGIN << d->attributes.title.toHtmlEscaped() << SVG_TITLE_END << '\n';
     }
     if (!d->attributes.description.isEmpty()) {
-        stream() << SVG_DESC_BEGIN << d->attributes.description.toHtmlEscaped() << SVG_DESC_END << Qt::endl;
+        stream() << SVG_DESC_BEGIN << d->attributes.description.toHtmlEscaped() << SVG_DESC_END << '\n';
     }
 
-// <defs> is currently empty. It's necessary for gradients.
-//    d->stream->setString(&d->defs);
-//    *d->stream << "<defs>\n";
-
-    // Point the stream at the body string, for other functions to populate
-    d->stream->setString(&d->body);
     return true;
 }
 
@@ -1086,24 +1110,17 @@ bool SvgPaintEngine::end()
 {
     Q_D(SvgPaintEngine);
 
-// <defs> is currently empty
-//    d->stream->setString(&d->defs);
-//    stream() << "</defs>\n";
-
-    // Point the stream at the real output device (the .svg file)
-    d->stream->setDevice(d->outputDevice);
-
-#ifndef QT_NO_TEXTCODEC
-    d->stream->setCodec(QTextCodec::codecForName("UTF-8"));
-#endif
-
-    // Stream our strings out to the device, in order
-    stream() << d->header;
-//    stream() << d->defs;
-    stream() << d->body;
-    stream() << SVG_END << Qt::endl;
+    // Symbols for reused glyphs; <use> may refer forward to them
+    if (!d->defs.isEmpty()) {
+        stream() << SVG_DEFS_BEGIN << '\n' << d->defs << SVG_DEFS_END << '\n';
+    }
+    stream() << SVG_END << '\n';
+    stream().flush();
 
     delete d->stream;
+    d->stream = 0;
+    d->defs.clear();
+    _glyphIds.clear();
     return true;
 }
 
@@ -1161,7 +1178,7 @@ void SvgPaintEngine::writeImage(const QRectF& r, const QByteArray& imageData, co
              << SVG_PRESERVE_ASPECT << SVG_NONE << SVG_QUOTE;
 
     stream() << " xlink:href=\"data:" << mimeFormat << ";base64,"
-             << imageData.toBase64() << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
+             << imageData.toBase64() << SVG_QUOTE << SVG_ELEMENT_END << '\n';
 }
 
 void SvgPaintEngine::updateState(const QPaintEngineState& s)
@@ -1216,37 +1233,27 @@ void SvgPaintEngine::updateState(const QPaintEngineState& s)
     }
 }
 
-void SvgPaintEngine::drawPath(const QPainterPath& p)
+void SvgPaintEngine::writePathData(QTextStream& s, const QPainterPath& p, qreal dx, qreal dy) const
 {
-    stream() << SVG_PATH << stateString;
-
-    // fill-rule is here because UpdateState() doesn't have a QPainterPath arg
-    // Majority of <path>s use the default value: fill-rule="nonzero"
-    if (p.fillRule() == Qt::OddEvenFill) {
-        stream() << SVG_FILL_RULE;
-    }
-
-    // Path data
-    stream() << SVG_D;
     for (int i = 0; i < p.elementCount(); ++i) {
         const QPainterPath::Element& e = p.elementAt(i);
-        qreal x = e.x + _dx;
-        qreal y = e.y + _dy;
+        qreal x = e.x + dx;
+        qreal y = e.y + dy;
         switch (e.type) {
         case QPainterPath::MoveToElement:
-            stream() << SVG_MOVE << x << SVG_COMMA << y;
+            s << SVG_MOVE << x << SVG_COMMA << y;
             break;
         case QPainterPath::LineToElement:
-            stream() << SVG_LINE << x << SVG_COMMA << y;
+            s << SVG_LINE << x << SVG_COMMA << y;
             break;
         case QPainterPath::CurveToElement:
-            stream() << SVG_CURVE << x << SVG_COMMA << y;
+            s << SVG_CURVE << x << SVG_COMMA << y;
             ++i;
             while (i < p.elementCount()) {
                 const QPainterPath::Element& ee = p.elementAt(i);
                 if (ee.type == QPainterPath::CurveToDataElement) {
-                    stream() << SVG_SPACE << ee.x + _dx
-                             << SVG_COMMA << ee.y + _dy;
+                    s << SVG_SPACE << ee.x + dx
+                      << SVG_COMMA << ee.y + dy;
                     ++i;
                 } else {
                     --i;
@@ -1258,10 +1265,78 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
             break;
         }
         if (i <= p.elementCount() - 1) {
-            stream() << SVG_SPACE;
+            s << SVG_SPACE;
         }
     }
-    stream() << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
+}
+
+//---------------------------------------------------------
+//   drawGlyph
+//    draw p as <use> of a <g> in <defs> holding the path
+//    relative to its first point; the group is created
+//    the first time a path of this shape is drawn.
+//    Returns false if p is too simple to be worth it.
+//---------------------------------------------------------
+
+bool SvgPaintEngine::drawGlyph(const QPainterPath& p)
+{
+    static constexpr int MIN_GLYPH_ELEMENTS = 12;
+    if (p.elementCount() < MIN_GLYPH_ELEMENTS) {
+        return false;
+    }
+    const QPointF origin(p.elementAt(0).x, p.elementAt(0).y);
+
+    // round the relative coordinates, so that the same glyph at
+    // different positions yields the same string
+    QPainterPath rp(p);
+    for (int i = 0; i < rp.elementCount(); ++i) {
+        const QPainterPath::Element& e = rp.elementAt(i);
+        rp.setElementPositionAt(i, qRound((e.x - origin.x()) * 1000.0) / 1000.0,
+                                qRound((e.y - origin.y()) * 1000.0) / 1000.0);
+    }
+    QString data;
+    QTextStream ds(&data);
+    if (p.fillRule() == Qt::OddEvenFill) {
+        ds << SVG_FILL_RULE;
+    }
+    ds << SVG_D;
+    writePathData(ds, rp, 0.0, 0.0);
+    ds << SVG_QUOTE;
+    ds.flush();
+
+    auto i = _glyphIds.find(data);
+    if (i == _glyphIds.end()) {
+        i = _glyphIds.insert(data, _glyphIds.size());
+        QTextStream defs(&d_func()->defs);
+        defs << SVG_GROUP_BEGIN << SVG_GLYPH_ID << i.value() << SVG_QUOTE << SVG_GT
+             << SVG_PATH << data << SVG_ELEMENT_END << SVG_GROUP_END << '\n';
+    }
+
+    stream() << SVG_USE << stateString
+             << SVG_HREF << SVG_GLYPH_ID << i.value() << SVG_QUOTE
+             << SVG_X << SVG_QUOTE << origin.x() + _dx << SVG_QUOTE
+             << SVG_Y << SVG_QUOTE << origin.y() + _dy << SVG_QUOTE
+             << SVG_ELEMENT_END << '\n';
+    return true;
+}
+
+void SvgPaintEngine::drawPath(const QPainterPath& p)
+{
+    if (_reuseGlyphs && drawGlyph(p)) {
+        return;
+    }
+    stream() << SVG_PATH << stateString;
+
+    // fill-rule is here because UpdateState() doesn't have a QPainterPath arg
+    // Majority of <path>s use the default value: fill-rule="nonzero"
+    if (p.fillRule() == Qt::OddEvenFill) {
+        stream() << SVG_FILL_RULE;
+    }
+
+    // Path data
+    stream() << SVG_D;
+    writePathData(stream(), p, _dx, _dy);
+    stream() << SVG_QUOTE << SVG_ELEMENT_END << '\n';
 }
 
 void SvgPaintEngine::drawPolygon(const QPointF* points, int pointCount,
@@ -1284,7 +1359,7 @@ void SvgPaintEngine::drawPolygon(const QPointF* points, int pointCount,
                 stream() << SVG_SPACE;
             }
         }
-        stream() << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
+        stream() << SVG_QUOTE << SVG_ELEMENT_END << '\n';
     } else {
         path.closeSubpath();
         drawPath(path);
@@ -105,6 +105,7 @@ public:
     int resolution() const;
 
     void setElement(const Ms::Element* e);
+    void setReuseGlyphs(bool val);
 
 protected:
     QPaintEngine* paintEngine() const;
@@ -47,11 +47,12 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
 
     score->setPrinting(true); // don’t print page break symbols etc.
 
-    Ms::MScore::pdfPrinting = true;
-    Ms::MScore::svgPrinting = true;
+    Ms::RenderContext ctx = Ms::RenderContext::current();
+    ctx.pdfPrinting = true;
+    ctx.svgPrinting = true;
+    Ms::RenderContextScope renderContext(ctx);
 
     const QList<Ms::Page*>& pages = score->pages();
-    double pixelRationBackup = Ms::MScore::pixelRatio;
 
     const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
     if (PAGE_NUMBER < 0 || PAGE_NUMBER >= pages.size()) {
@@ -64,6 +65,7 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
     QString title(score->title());
     printer.setTitle(pages.size() > 1 ? QString("%1 (%2)").arg(title).arg(PAGE_NUMBER + 1) : title);
     printer.setOutputDevice(&destinationDevice);
+    printer.setReuseGlyphs(options.value(OptionKey::REUSE_GLYPHS, Val(configuration()->exportSvgReuseGlyphs())).toBool());
 
     const int TRIM_MARGINS_SIZE = options.value(OptionKey::TRIM_MARGINS_SIZE, Val(0)).toInt();
 
@@ -85,7 +87,8 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
         painter.translate(-pageRect.topLeft());
     }
 
-    Ms::MScore::pixelRatio = Ms::DPI / printer.logicalDpiX();
+    ctx.pixelRatio = Ms::DPI / printer.logicalDpiX();
+    Ms::RenderContextScope printerContext(ctx);
 
     if (!options[OptionKey::TRANSPARENT_BACKGROUND].toBool()) {
         painter.fillRect(pageRect, Qt::white);
@@ -209,10 +212,7 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
     painter.end(); // Writes MuseScore SVG file to disk, finally
 
     // Clean up and return
-    Ms::MScore::pixelRatio = pixelRationBackup;
     score->setPrinting(false);
-    Ms::MScore::pdfPrinting = false;
-    Ms::MScore::svgPrinting = false;
 
     return true;
 }
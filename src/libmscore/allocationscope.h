@@ -0,0 +1,51 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __ALLOCATIONSCOPE_H__
+#define __ALLOCATIONSCOPE_H__
+
+#include <QtGlobal>
+
+namespace Ms {
+//---------------------------------------------------------
+//   AllocationScope
+//    counts the heap allocations of elements and shape
+//    storage made on the current thread while it exists;
+//    used by the layout benchmarks
+//---------------------------------------------------------
+
+class AllocationScope
+{
+    quint64 _count { 0 };
+    AllocationScope* _previous;
+
+    static inline thread_local AllocationScope* _current { nullptr };
+
+public:
+    AllocationScope()
+        : _previous(_current) { _current = this; }
+    ~AllocationScope() { _current = _previous; }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    quint64 count() const { return _count; }
+
+    static void allocated()
+    {
+        for (AllocationScope* s = _current; s; s = s->_previous) {
+            ++s->_count;
+        }
+    }
+};
+}     // namespace Ms
+#endif
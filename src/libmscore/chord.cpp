@@ -222,6 +222,7 @@ Chord::Chord(Score* s)
     : ChordRest(s)
 {
     _ledgerLines      = 0;
+    _spareLedgerLines = 0;
     _stem             = 0;
     _hook             = 0;
     _stemDirection    = Direction::AUTO;
@@ -245,6 +246,7 @@ Chord::Chord(const Chord& c, bool link)
         score()->undo(new Link(this, const_cast<Chord*>(&c)));
     }
     _ledgerLines = 0;
+    _spareLedgerLines = 0;
 
     for (Note* onote : c._notes) {
         Note* nnote = new Note(*onote, link);
@@ -374,7 +376,8 @@ Chord::~Chord()
     delete _stemSlash;
     delete _stem;
     delete _hook;
-    for (LedgerLine* ll = _ledgerLines; ll;) {
+    resetLedgerLines();
+    for (LedgerLine* ll = _spareLedgerLines; ll;) {
         LedgerLine* llNext = ll->next();
         delete ll;
         ll = llNext;
@@ -873,7 +876,7 @@ void Chord::addLedgerLines()
             qreal _spatium = spatium();
             qreal stepDistance = lineDistance * 0.5;
             for (auto lld : vecLines) {
-                LedgerLine* h = new LedgerLine(score());
+                LedgerLine* h = takeLedgerLine();
                 h->setParent(this);
                 h->setTrack(track);
                 h->setVisible(lld.visible && staffVisible);
@@ -889,6 +892,37 @@ void Chord::addLedgerLines()
     }
 }
 
+//---------------------------------------------------------
+//   resetLedgerLines
+//    move all ledger lines to the spare list; layout
+//    takes them from there instead of allocating new ones
+//---------------------------------------------------------
+
+void Chord::resetLedgerLines()
+{
+    while (_ledgerLines) {
+        LedgerLine* l = _ledgerLines->next();
+        _ledgerLines->setNext(_spareLedgerLines);
+        _spareLedgerLines = _ledgerLines;
+        _ledgerLines = l;
+    }
+}
+
+//---------------------------------------------------------
+//   takeLedgerLine
+//---------------------------------------------------------
+
+LedgerLine* Chord::takeLedgerLine()
+{
+    if (!_spareLedgerLines) {
+        return new LedgerLine(score());
+    }
+    LedgerLine* l = _spareLedgerLines;
+    _spareLedgerLines = l->next();
+    l->setNext(nullptr);
+    return l;
+}
+
 //-----------------------------------------------------------------------------
 //   computeUp
 //    rules:
@@ -1855,11 +1889,7 @@ void Chord::layoutPitched()
     qreal graceMag         = score()->styleD(Sid::graceNoteMag);
     qreal chordX           = (_noteType == NoteType::NORMAL) ? ipos().x() : 0.0;
 
-    while (_ledgerLines) {
-        LedgerLine* l = _ledgerLines->next();
-        delete _ledgerLines;
-        _ledgerLines = l;
-    }
+    resetLedgerLines();
 
     qreal lll    = 0.0;           // space to leave at left of chord
     qreal rrr    = 0.0;           // space to leave at right of chord
@@ -2144,11 +2174,7 @@ void Chord::layoutTablature()
         c->layoutTablature();
     }
 
-    while (_ledgerLines) {
-        LedgerLine* l = _ledgerLines->next();
-        delete _ledgerLines;
-        _ledgerLines = l;
-    }
+    resetLedgerLines();
 
     qreal lll         = 0.0;                    // space to leave at left of chord
     qreal rrr         = 0.0;                    // space to leave at right of chord
@@ -2239,7 +2265,7 @@ void Chord::layoutTablature()
         qreal extraLen    = 0;
         qreal llX         = stemX - (headWidth + extraLen) * 0.5;
         for (int i = 0; i < ledgerLines; i++) {
-            LedgerLine* ldgLin = new LedgerLine(score());
+            LedgerLine* ldgLin = takeLedgerLine();
             ldgLin->setParent(this);
             ldgLin->setTrack(track());
             ldgLin->setVisible(visible());
@@ -3551,24 +3577,24 @@ Shape Chord::shape() const
 {
     Shape shape;
     if (_hook && _hook->addToSkyline()) {
-        shape.add(_hook->shape().translated(_hook->pos()));
+        shape.add(_hook->shape(), _hook->pos());
     }
     if (_stem && _stem->addToSkyline()) {
         // stem direction is not known soon enough for cross staff beamed notes
         if (!(beam() && (staffMove() || beam()->cross()))) {
-            shape.add(_stem->shape().translated(_stem->pos()));
+            shape.add(_stem->shape(), _stem->pos());
         }
     }
     if (_stemSlash && _stemSlash->addToSkyline()) {
-        shape.add(_stemSlash->shape().translated(_stemSlash->pos()));
+        shape.add(_stemSlash->shape(), _stemSlash->pos());
     }
     if (_arpeggio && _arpeggio->addToSkyline()) {
-        shape.add(_arpeggio->shape().translated(_arpeggio->pos()));
+        shape.add(_arpeggio->shape(), _arpeggio->pos());
     }
 //      if (_tremolo)
 //            shape.add(_tremolo->shape().translated(_tremolo->pos()));
     for (Note* note : _notes) {
-        shape.add(note->shape().translated(note->pos()));
+        shape.add(note->shape(), note->pos());
         for (Element* e : note->el()) {
             if (!e->addToSkyline()) {
                 continue;
@@ -3580,15 +3606,15 @@ Shape Chord::shape() const
     }
     for (Element* e : el()) {
         if (e->addToSkyline()) {
-            shape.add(e->shape().translated(e->pos()));
+            shape.add(e->shape(), e->pos());
         }
     }
     for (Chord* chord : _graceNotes) {    // process grace notes last, needed for correct shape calculation
-        shape.add(chord->shape().translated(chord->pos()));
+        shape.add(chord->shape(), chord->pos());
     }
     shape.add(ChordRest::shape());      // add lyrics
     for (LedgerLine* l = _ledgerLines; l; l = l->next()) {
-        shape.add(l->shape().translated(l->pos()));
+        shape.add(l->shape(), l->pos());
     }
     if (_spaceLw || _spaceRw) {
         shape.addHorizontalSpacing(Shape::SPACING_GENERAL, -_spaceLw, _spaceRw);
@@ -60,6 +60,7 @@ class Chord final : public ChordRest
 {
     std::vector<Note*> _notes;           // sorted to decreasing line step
     LedgerLine* _ledgerLines;            // single linked list
+    LedgerLine* _spareLedgerLines;       // ledger lines of the previous layout, kept for reuse
 
     Stem* _stem;
     Hook* _hook;
@@ -85,6 +86,8 @@ class Chord final : public ChordRest
     qreal downPos() const override;
     qreal centerX() const;
     void addLedgerLines();
+    void resetLedgerLines();
+    LedgerLine* takeLedgerLine();
     void processSiblings(std::function<void(Element*)> func) const;
 
     void layoutPitched();
@@ -0,0 +1,302 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "chordlayoutcache.h"
+
+#include "accidental.h"
+#include "beam.h"
+#include "chord.h"
+#include "hook.h"
+#include "measure.h"
+#include "note.h"
+#include "score.h"
+#include "segment.h"
+#include "staff.h"
+#include "stafftype.h"
+#include "stem.h"
+#include "stemslash.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   layout relevant style
+//    style values read by layoutChords1/2/3 and by
+//    the chord and note metrics they depend on
+//---------------------------------------------------------
+
+static const Sid chordLayoutStyle[] = {
+    Sid::spatium,
+    Sid::MusicalSymbolFont,
+    Sid::accidentalDistance,
+    Sid::accidentalNoteDistance,
+    Sid::alignAccidentalsLeft,
+    Sid::dotNoteDistance,
+    Sid::dotDotDistance,
+    Sid::stemWidth,
+    Sid::smallNoteMag,
+    Sid::graceNoteMag,
+    Sid::ledgerLineLength,
+    Sid::ledgerLineWidth,
+};
+
+//---------------------------------------------------------
+//   styleMatches
+//---------------------------------------------------------
+
+bool ChordLayoutCache::styleMatches(const Score* part, const Score* master)
+{
+    for (Sid sid : chordLayoutStyle) {
+        if (part->styleV(sid) != master->styleV(sid)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   contentVersion
+//    combines the properties of a chord and its notes that
+//    layoutChords1() depends on; a cached result is only
+//    replayed for a chord with the same content version
+//---------------------------------------------------------
+
+static inline void combine(uint& v, int x)
+{
+    v ^= uint(x) + 0x9e3779b9u + (v << 6) + (v >> 2);
+}
+
+uint ChordLayoutCache::contentVersion(const Chord* c)
+{
+    uint v = 0;
+    combine(v, c->up());
+    combine(v, c->voice());
+    combine(v, c->small());
+    combine(v, int(c->mag() * 1000.0));
+    combine(v, c->stem() != nullptr);
+    combine(v, int(c->durationType().type()));
+    combine(v, c->dots());
+    combine(v, int(c->notes().size()));
+    for (const Note* n : c->notes()) {
+        combine(v, n->line());
+        combine(v, int(n->headGroup()));
+        combine(v, int(n->headType()));
+        combine(v, n->small());
+        combine(v, n->fixed());
+        combine(v, int(n->userMirror()));
+        combine(v, int(n->userDotPosition()));
+        combine(v, n->accidental() ? int(n->accidental()->accidentalType()) : -1);
+    }
+    return v;
+}
+
+//---------------------------------------------------------
+//   replayable
+//    chords which layoutChords1() lays out with more than
+//    the segment/staff at hand are not cached, nor are
+//    chords on tablature staves which it does not lay out
+//---------------------------------------------------------
+
+static bool replayable(const Chord* c)
+{
+    return c->links() && !c->staffMove() && c->graceNotes().empty() && !(c->beam() && c->beam()->cross())
+           && !c->staff()->isTabStaff(c->tick());
+}
+
+//---------------------------------------------------------
+//   store
+//    record the result of layoutChords1() for the chords
+//    of segment/staff in the master score
+//---------------------------------------------------------
+
+void ChordLayoutCache::store(Segment* segment, int staffIdx)
+{
+    const int startTrack = staffIdx * VOICES;
+    const int endTrack   = startTrack + VOICES;
+
+    int chords = 0;
+    bool ok = true;
+    for (int track = startTrack; track < endTrack; ++track) {
+        Element* e = segment->element(track);
+        if (e && e->isChord()) {
+            ++chords;
+            ok = ok && replayable(toChord(e));
+        }
+    }
+
+    for (int track = startTrack; track < endTrack; ++track) {
+        Element* e = segment->element(track);
+        if (!e || !e->isChord()) {
+            continue;
+        }
+        Chord* c = toChord(e);
+        if (!c->links()) {
+            continue;
+        }
+        if (!ok) {
+            _chords.erase(c->links()->lid());
+            continue;
+        }
+        ChordData& d = _chords[c->links()->lid()];
+        d.chord         = c;
+        d.version       = contentVersion(c);
+        d.x             = c->ipos().x();
+        d.dotPosX       = segment->dotPosX(staffIdx);
+        d.chordsInStaff = chords;
+        d.notes.resize(c->notes().size());
+        for (size_t i = 0; i < c->notes().size(); ++i) {
+            const Note* n = c->notes()[i];
+            NoteData& nd  = d.notes[i];
+            nd.pos           = n->ipos();
+            nd.accidentalPos = n->accidental() ? n->accidental()->ipos() : QPointF();
+            nd.line          = n->line();
+            nd.dotPosition   = n->dotPosition();
+            nd.mirror        = n->mirror();
+            nd.hidden        = n->hidden();
+            nd.dotsHidden    = n->dotsHidden();
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   replay
+//    apply the cached results of the linked master chords
+//    to segment/staff of a part score; returns false if
+//    any chord differs from its master in a way that
+//    could change the layout
+//---------------------------------------------------------
+
+bool ChordLayoutCache::replay(Segment* segment, int staffIdx) const
+{
+    const int startTrack = staffIdx * VOICES;
+    const int endTrack   = startTrack + VOICES;
+    const Score* master  = segment->score()->masterScore();
+    const Staff* staff   = segment->score()->staff(staffIdx);
+    const Fraction tick  = segment->tick();
+
+    std::pair<Chord*, const ChordData*> chords[VOICES];
+    int nchords = 0;
+    const Segment* masterSegment = nullptr;
+    int masterStaffIdx = -1;
+
+    for (int track = startTrack; track < endTrack; ++track) {
+        Element* e = segment->element(track);
+        if (!e || !e->isChord()) {
+            continue;
+        }
+        Chord* c = toChord(e);
+        if (!replayable(c) || !c->links()) {
+            return false;
+        }
+        const Chord* mc = nullptr;
+        for (ScoreElement* se : *c->links()) {
+            if (se->score() == master) {
+                mc = toChord(se);
+                break;
+            }
+        }
+        if (!mc) {
+            return false;
+        }
+        auto i = _chords.find(c->links()->lid());
+        if (i == _chords.end()) {
+            return false;
+        }
+        const ChordData& d = i->second;
+        if (d.chord != mc || d.version != contentVersion(mc) || d.version != contentVersion(c)) {
+            return false;
+        }
+        if (nchords == 0) {
+            const Staff* mstaff = mc->staff();
+            if (staff->staffMag(tick) != mstaff->staffMag(tick) || !(*staff->staffType(tick) == *mstaff->staffType(tick))) {
+                return false;
+            }
+            masterSegment  = mc->segment();
+            masterStaffIdx = mc->staffIdx();
+        } else if (mc->segment() != masterSegment || mc->staffIdx() != masterStaffIdx) {
+            return false;
+        }
+        chords[nchords++] = { c, &d };
+    }
+    if (nchords == 0 || chords[0].second->chordsInStaff != nchords) {
+        return false;
+    }
+
+    for (int i = 0; i < nchords; ++i) {
+        Chord* c = chords[i].first;
+        const ChordData& d = *chords[i].second;
+        c->rxpos() = d.x;
+        if (c->stemSlash()) {
+            c->stemSlash()->layout();
+        }
+        for (size_t k = 0; k < d.notes.size(); ++k) {
+            Note* n = c->notes()[k];
+            const NoteData& nd = d.notes[k];
+            n->setMirror(nd.mirror);
+            n->setHidden(nd.hidden);
+            n->setDotsHidden(nd.dotsHidden);
+            if (n->rypos() != nd.pos.y()) {
+                n->rypos() = nd.pos.y();
+                if (c->stem()) {
+                    c->stem()->layout();
+                    if (c->hook()) {
+                        c->hook()->rypos() = c->stem()->hookPos().y();
+                    }
+                }
+            }
+            n->rxpos() = nd.pos.x();
+            Accidental* ac = n->accidental();
+            if (ac && !n->fixed()) {
+                ac->layout();
+                ac->setPos(nd.accidentalPos);
+            }
+            n->setDotY(nd.dotPosition);
+        }
+    }
+    segment->setDotPosX(staffIdx, chords[0].second->dotPosX);
+    return true;
+}
+
+//---------------------------------------------------------
+//   remove
+//    forget the entry of a chord removed from the master
+//---------------------------------------------------------
+
+void ChordLayoutCache::remove(const Chord* c)
+{
+    if (c->links()) {
+        auto i = _chords.find(c->links()->lid());
+        if (i != _chords.end() && i->second.chord == c) {
+            _chords.erase(i);
+        }
+    }
+}
+
+void ChordLayoutCache::remove(const MeasureBase* first, const MeasureBase* last)
+{
+    if (_chords.empty()) {
+        return;
+    }
+    for (const MeasureBase* mb = first; mb; mb = mb->next()) {
+        if (mb->isMeasure()) {
+            for (const Segment* s = toMeasure(mb)->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+                for (const Element* e : s->elist()) {
+                    if (e && e->isChord()) {
+                        remove(toChord(e));
+                    }
+                }
+            }
+        }
+        if (mb == last) {
+            break;
+        }
+    }
+}
+}
@@ -0,0 +1,78 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __CHORDLAYOUTCACHE_H__
+#define __CHORDLAYOUTCACHE_H__
+
+#include <unordered_map>
+#include <vector>
+
+#include <QPointF>
+
+#include "types.h"
+
+namespace Ms {
+class Chord;
+class MeasureBase;
+class Score;
+class Segment;
+
+//---------------------------------------------------------
+//   ChordLayoutCache
+//    results of Score::layoutChords1() for the chords of a
+//    master score. Part scores whose layout relevant style
+//    equals the master style replay them for the linked
+//    chords instead of computing note offsets, mirroring,
+//    dot and accidental positions again.
+//    Entries are keyed by the link id of the chord, which
+//    stays the same for the lifetime of the chord, and carry
+//    a content version of the chord they were stored for.
+//---------------------------------------------------------
+
+class ChordLayoutCache
+{
+public:
+    struct NoteData {
+        QPointF pos;
+        QPointF accidentalPos;
+        int line                { 0 };
+        Direction dotPosition   { Direction::AUTO };
+        bool mirror             { false };
+        bool hidden             { false };
+        bool dotsHidden         { false };
+    };
+
+    struct ChordData {
+        const Chord* chord      { nullptr };  // master chord the data was stored for
+        uint version            { 0 };        // contentVersion() of that chord
+        qreal x                 { 0.0 };
+        qreal dotPosX           { 0.0 };      // dot column of the segment/staff
+        int chordsInStaff       { 0 };
+        std::vector<NoteData> notes;
+    };
+
+private:
+    std::unordered_map<int, ChordData> _chords;
+
+public:
+    void clear() { _chords.clear(); }
+    size_t size() const { return _chords.size(); }
+    void store(Segment* segment, int staffIdx);
+    bool replay(Segment* segment, int staffIdx) const;
+    void remove(const Chord*);
+    void remove(const MeasureBase* first, const MeasureBase* last);
+
+    static bool styleMatches(const Score* part, const Score* master);
+    static uint contentVersion(const Chord*);
+};
+}     // namespace Ms
+#endif
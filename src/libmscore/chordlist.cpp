@@ -1711,6 +1711,7 @@ int ChordList::privateID = -1000;
 
 void ChordList::configureAutoAdjust(qreal emag, qreal eadjust, qreal mmag, qreal madjust)
 {
+    clearParseCache();
     _emag = emag;
     _eadjust = eadjust;
     _mmag = mmag;
@@ -1736,6 +1737,7 @@ void ChordList::configureAutoAdjust(qreal emag, qreal eadjust, qreal mmag, qreal
 
 void ChordList::read(XmlReader& e)
 {
+    clearParseCache();
     int fontIdx = 0;
     _autoAdjust = false;
     while (e.readNextStartElement()) {
@@ -1987,12 +1989,30 @@ bool ChordList::loaded() const
     return !renderListRoot.empty();
 }
 
+//---------------------------------------------------------
+//   parse
+//    parse name as ParsedChord::parse() does; the result
+//    is cached until the chord list is reloaded
+//---------------------------------------------------------
+
+ChordList::ParseResult& ChordList::parse(const QString& name, bool syntaxOnly, bool preferMinor) const
+{
+    const QPair<QString, int> key(name, int(syntaxOnly) | (int(preferMinor) << 1));
+    auto i = _parseCache.find(key);
+    if (i == _parseCache.end()) {
+        i = _parseCache.insert(key, ParseResult());
+        i->parsedChord.parse(name, this, syntaxOnly, preferMinor);
+    }
+    return *i;
+}
+
 //---------------------------------------------------------
 //   unload
 //---------------------------------------------------------
 
 void ChordList::unload()
 {
+    clearParseCache();
     clear();
     symbols.clear();
     fonts.clear();
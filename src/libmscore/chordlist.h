@@ -13,6 +13,7 @@
 #ifndef __CHORDLIST_H__
 #define __CHORDLIST_H__
 
+#include <QHash>
 #include <QMap>
 
 namespace Ms {
@@ -243,11 +244,28 @@ struct ChordFont {
 
 class ChordList : public QMap<int, ChordDescription>
 {
+public:
+    //---------------------------------------------------------
+    //   ParseResult
+    //    cached result of parsing a chord name against this
+    //    chord list; the description lookup is only valid as
+    //    long as no descriptions were added
+    //---------------------------------------------------------
+
+    struct ParseResult {
+        ParsedChord parsedChord;
+        int descriptionId       { 0 };
+        bool descriptionFound   { false };
+        int descriptionCount    { -1 };       // size() at the time of the description lookup
+    };
+
+private:
     QMap<QString, ChordSymbol> symbols;
     bool _autoAdjust = false;
     qreal _nmag = 1.0, _nadjust = 0.0;
     qreal _emag = 1.0, _eadjust = 0.0;
     qreal _mmag = 1.0, _madjust = 0.0;
+    mutable QHash<QPair<QString, int>, ParseResult> _parseCache;
 
 public:
     QList<ChordFont> fonts;
@@ -270,6 +288,9 @@ public:
     bool loaded() const;
     void unload();
     ChordSymbol symbol(const QString& s) const { return symbols.value(s); }
+
+    ParseResult& parse(const QString& name, bool syntaxOnly, bool preferMinor) const;
+    void clearParseCache() { _parseCache.clear(); }
 };
 }     // namespace Ms
 #endif
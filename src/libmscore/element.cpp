@@ -445,6 +445,47 @@ Part* Element::part() const
     return s ? s->part() : 0;
 }
 
+//---------------------------------------------------------
+//   setSelected
+//    selection changes the drawing color, so the recorded
+//    display list of the page has to be redrawn
+//---------------------------------------------------------
+
+void Element::setSelected(bool f)
+{
+    if (f != selected()) {
+        invalidateDisplayList();
+    }
+    setFlag(ElementFlag::SELECTED, f);
+}
+
+//---------------------------------------------------------
+//   setDropTarget
+//---------------------------------------------------------
+
+void Element::setDropTarget(bool v) const
+{
+    if (v != dropTarget()) {
+        invalidateDisplayList();
+    }
+    setFlag(ElementFlag::DROP_TARGET, v);
+}
+
+//---------------------------------------------------------
+//   invalidateDisplayList
+//    of the page the element is drawn on, of all pages
+//    if it is not on a page
+//---------------------------------------------------------
+
+void Element::invalidateDisplayList() const
+{
+    if (const Element* page = findAncestor(ElementType::PAGE)) {
+        toPage(page)->invalidateDisplayList();
+    } else if (score()) {
+        score()->invalidateDisplayLists();
+    }
+}
+
 //---------------------------------------------------------
 //   curColor
 //---------------------------------------------------------
@@ -2394,7 +2435,7 @@ void Element::autoplaceSegmentElement(qreal minDistance)
             qreal totalWidth = m->width();
             for (Measure* nm = m->nextMeasure(); nm; nm = nm->nextMeasure()) {
                 if (s2.right() > totalWidth) {
-                    s1.add(nm->staffShape(si).translated(QPointF(totalWidth, 0.0)));
+                    s1.add(nm->staffShape(si), QPointF(totalWidth, 0.0));
                     totalWidth += nm->width();
                 } else {
                     break;
@@ -2405,7 +2446,7 @@ void Element::autoplaceSegmentElement(qreal minDistance)
             totalWidth = 0;
             for (Measure* pm = m->prevMeasure(); pm; pm = pm->prevMeasure()) {
                 if (s2.left() > totalWidth) {
-                    s1.add(pm->staffShape(si).translated(QPointF(-(totalWidth + pm->width()), 0.0)));
+                    s1.add(pm->staffShape(si), QPointF(-(totalWidth + pm->width()), 0.0));
                     totalWidth += pm->width();
                 } else {
                     break;
@@ -2473,7 +2514,7 @@ void Element::autoplaceSegmentElement(qreal minDistance)
             bool cnm = (s2.right() > m->width()) && m->nextMeasure() && m->nextMeasure()->system() == m->system();
             if (cnm) {
                 Measure* nm = m->nextMeasure();
-                s1.add(nm->staffShape(si).translated(QPointF(m->width(), 0.0)));
+                s1.add(nm->staffShape(si), QPointF(m->width(), 0.0));
             }
             qreal d = placeAbove() ? s2.minVerticalDistance(s1) : s1.minVerticalDistance(s2);
             if (d > -minDistance) {
@@ -244,7 +244,7 @@ public:
     inline bool flag(ElementFlag f) const { return _flags & f; }
 
     bool selected() const { return flag(ElementFlag::SELECTED); }
-    virtual void setSelected(bool f) { setFlag(ElementFlag::SELECTED, f); }
+    virtual void setSelected(bool f);
 
     bool visible() const { return !flag(ElementFlag::INVISIBLE); }
     virtual void setVisible(bool f) { setFlag(ElementFlag::INVISIBLE, !f); }
@@ -450,7 +450,7 @@ public:
  */
     virtual bool mousePress(EditData&) { return false; }
 
-    mutable bool itemDiscovered      { false };       ///< helper flag for bsp
+    mutable bool itemDiscovered      { false };       ///< helper flag for hit testing
 
     void scanElements(void* data, void (* func)(void*, Element*), bool all=true) override;
 
@@ -479,7 +479,8 @@ public:
     void setSelectable(bool val) { setFlag(ElementFlag::NOT_SELECTABLE, !val); }
 
     bool dropTarget() const { return flag(ElementFlag::DROP_TARGET); }
-    void setDropTarget(bool v) const { setFlag(ElementFlag::DROP_TARGET, v); }
+    void setDropTarget(bool v) const;
+    void invalidateDisplayList() const;
 
     bool composition() const { return flag(ElementFlag::COMPOSITION); }
     void setComposition(bool v) const { setFlag(ElementFlag::COMPOSITION, v); }
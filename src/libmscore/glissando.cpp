@@ -108,10 +108,10 @@ void GlissandoSegment::draw(QPainter* painter) const
             ids.push_back(SymId::wiggleTrill);
         }
         // this is very ugly but fix #68846 for now
-        bool tmp = MScore::pdfPrinting;
-        MScore::pdfPrinting = true;
+        RenderContext ctx = RenderContext::current();
+        ctx.pdfPrinting = true;
+        RenderContextScope renderContext(ctx);
         score()->scoreFont()->draw(ids, painter, magS(), QPointF(x, -(b.y() + b.height() * 0.5)), scale);
-        MScore::pdfPrinting = tmp;
     }
 
     if (glissando()->showText()) {
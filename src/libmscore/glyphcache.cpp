@@ -0,0 +1,149 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <climits>
+#include <vector>
+
+#include <QPainter>
+
+#include "glyphcache.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   GlyphCache
+//---------------------------------------------------------
+
+GlyphCache::GlyphCache(qint64 budget)
+    : _budget(budget)
+{
+    setBudget(budget);
+}
+
+//---------------------------------------------------------
+//   instance
+//---------------------------------------------------------
+
+GlyphCache* GlyphCache::instance()
+{
+    static GlyphCache cache;
+    return &cache;
+}
+
+//---------------------------------------------------------
+//   setBudget
+//---------------------------------------------------------
+
+void GlyphCache::setBudget(qint64 bytes)
+{
+    _budget = bytes;
+    const int shardBudget = int(qBound(qint64(1), bytes / SHARDS, qint64(INT_MAX)));
+    for (Shard& s : _shards) {
+        QMutexLocker lock(&s.mutex);
+        s.masks.setMaxCost(shardBudget);
+    }
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void GlyphCache::clear()
+{
+    for (Shard& s : _shards) {
+        QMutexLocker lock(&s.mutex);
+        s.masks.clear();
+    }
+}
+
+//---------------------------------------------------------
+//   stats
+//---------------------------------------------------------
+
+GlyphCache::Stats GlyphCache::stats() const
+{
+    Stats st { _hits, _misses, 0 };
+    for (const Shard& s : _shards) {
+        QMutexLocker lock(&s.mutex);
+        st.bytes += s.masks.totalCost();
+    }
+    return st;
+}
+
+void GlyphCache::resetStats()
+{
+    _hits   = 0;
+    _misses = 0;
+}
+
+//---------------------------------------------------------
+//   mask
+//    return the coverage mask for key; it is rendered by
+//    rasterize if it is not cached. Returns false if the
+//    glyph cannot be rendered.
+//---------------------------------------------------------
+
+bool GlyphCache::mask(const GlyphKey& key, const Rasterizer& rasterize, GlyphImage& result)
+{
+    Shard& s = shard(key);
+    QMutexLocker lock(&s.mutex);
+    if (const GlyphImage* gi = s.masks.object(key)) {
+        result = *gi;
+        ++_hits;
+        return true;
+    }
+
+    ++_misses;
+    if (!rasterize(result)) {
+        return false;
+    }
+    s.masks.insert(key, new GlyphImage(result), cost(result.image));
+    return true;
+}
+
+//---------------------------------------------------------
+//   draw
+//    draw the mask at pos in color; the alpha of the glyph
+//    is limited by the alpha of color. The colored glyph is
+//    built in a buffer of the painting thread, so drawing
+//    does not allocate pixels.
+//---------------------------------------------------------
+
+void GlyphCache::draw(QPainter* painter, const QPointF& pos, const GlyphImage& mask, QRgb color)
+{
+    thread_local std::vector<QRgb> buffer;
+
+    const QImage& src = mask.image;
+    const int w = src.width();
+    const int h = src.height();
+    if (buffer.size() < size_t(w) * h) {
+        buffer.resize(size_t(w) * h);
+    }
+
+    const int r = qRed(color);
+    const int g = qGreen(color);
+    const int b = qBlue(color);
+    const int maxAlpha = qAlpha(color);
+    QRgb* d = buffer.data();
+    for (int y = 0; y < h; ++y) {
+        const uchar* s = src.constScanLine(y);
+        for (int x = 0; x < w; ++x) {
+            *d++ = *s ? qPremultiply(qRgba(r, g, b, qMin(int(*s), maxAlpha))) : 0;
+            ++s;
+        }
+    }
+
+    QImage img(reinterpret_cast<const uchar*>(buffer.data()), w, h, w * int(sizeof(QRgb)),
+               QImage::Format_ARGB32_Premultiplied);
+    img.setDevicePixelRatio(src.devicePixelRatio());
+    painter->drawImage(pos + mask.offset, img);
+}
+}
@@ -0,0 +1,130 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __GLYPHCACHE_H__
+#define __GLYPHCACHE_H__
+
+#include <atomic>
+#include <functional>
+
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QPointF>
+
+class QPainter;
+
+#include "sym.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   GlyphKey
+///   \cond PLUGIN_API \private \endcond
+//    a rendered glyph, independent of its color
+//---------------------------------------------------------
+
+struct GlyphKey {
+    FT_Face face;
+    SymId id;
+    qreal magX;
+    qreal magY;
+    qreal worldScale;
+
+    GlyphKey(FT_Face _f, SymId _id, qreal mx, qreal my, qreal s)
+        : face(_f), id(_id), magX(mx), magY(my), worldScale(s) {}
+    bool operator==(const GlyphKey& k) const
+    {
+        return face == k.face && id == k.id && magX == k.magX && magY == k.magY && worldScale == k.worldScale;
+    }
+};
+
+inline uint qHash(const GlyphKey& k, uint seed = 0)
+{
+    uint h = ::qHash(quintptr(k.face), seed);
+    h = 31 * h + uint(k.id);
+    h = 31 * h + ::qHash(k.magX);
+    h = 31 * h + ::qHash(k.magY);
+    return 31 * h + ::qHash(k.worldScale);
+}
+
+//---------------------------------------------------------
+//   GlyphImage
+///   \cond PLUGIN_API \private \endcond
+//---------------------------------------------------------
+
+struct GlyphImage {
+    QImage image;           // Format_Alpha8 coverage mask
+    QPointF offset;
+};
+
+//---------------------------------------------------------
+//   GlyphCache
+///   \cond PLUGIN_API \private \endcond
+//    process wide cache of rendered score font glyphs
+//
+//    Coverage masks are cached per glyph/magnification/scale
+//    and colored when they are drawn, so a glyph is kept once
+//    whatever colors it is painted in. The cache is bounded
+//    by a memory budget in bytes and split into shards with
+//    their own lock, so painting from several threads does
+//    not serialize on a single mutex.
+//---------------------------------------------------------
+
+class GlyphCache
+{
+public:
+    //! renders the coverage mask for a key; called on a miss
+    //! only, with the lock of the key's shard held, so a glyph
+    //! is rasterized once. It must not use the cache.
+    using Rasterizer = std::function<bool(GlyphImage&)>;
+
+    struct Stats {
+        quint64 hits;           // mask found
+        quint64 misses;         // glyph had to be rasterized
+        qint64 bytes;           // memory currently used
+    };
+
+private:
+    static constexpr int SHARDS = 8;
+
+    struct Shard {
+        mutable QMutex mutex;
+        QCache<GlyphKey, GlyphImage> masks;
+    };
+
+    Shard _shards[SHARDS];
+    std::atomic<qint64> _budget;
+    std::atomic<quint64> _hits { 0 };
+    std::atomic<quint64> _misses { 0 };
+
+    Shard& shard(const GlyphKey& k) { return _shards[qHash(k) % SHARDS]; }
+    static int cost(const QImage& img) { return qMax(1, int(img.sizeInBytes())); }
+
+public:
+    static constexpr qint64 DEFAULT_BUDGET = 16 * 1024 * 1024;
+
+    GlyphCache(qint64 budget = DEFAULT_BUDGET);
+
+    static GlyphCache* instance();
+
+    bool mask(const GlyphKey& key, const Rasterizer& rasterize, GlyphImage& result);
+    static void draw(QPainter* painter, const QPointF& pos, const GlyphImage& mask, QRgb color);
+
+    void setBudget(qint64 bytes);
+    qint64 budget() const { return _budget; }
+    void clear();
+
+    Stats stats() const;
+    void resetStats();
+};
+}     // namespace Ms
+#endif
@@ -771,15 +771,23 @@ const ChordDescription* Harmony::parseHarmony(const QString& ss, int* root, int*
     if (useLiteral) {
         cd = descr(s);
     } else {
-        _parsedForm = new ParsedChord();
-        _parsedForm->parse(s, cl, syntaxOnly, preferMinor);
+        ChordList::ParseResult& pr = cl->parse(s, syntaxOnly, preferMinor);
+        _parsedForm = new ParsedChord(pr.parsedChord);
         // parser prepends "=" to name of implied minor chords
         // use this here as well
         if (preferMinor) {
             s = _parsedForm->name();
         }
         // look up to see if we already have a descriptor (chord has been used before)
-        cd = descr(s, _parsedForm);
+        if (pr.descriptionCount == cl->size()) {
+            auto i = cl->find(pr.descriptionId);
+            cd = pr.descriptionFound && i != cl->end() ? &*i : 0;
+        } else {
+            cd = descr(s, _parsedForm);
+            pr.descriptionFound = cd;
+            pr.descriptionId    = cd ? cd->id : 0;
+            pr.descriptionCount = cl->size();
+        }
     }
     if (cd) {
         // descriptor found; use its information
@@ -2000,8 +2008,7 @@ const ParsedChord* Harmony::parsedForm()
 {
     if (!_parsedForm) {
         ChordList* cl = score()->style().chordList();
-        _parsedForm = new ParsedChord();
-        _parsedForm->parse(_textName, cl, false);
+        _parsedForm = new ParsedChord(cl->parse(_textName, false, false).parsedChord);
     }
     return _parsedForm;
 }
@@ -17,6 +17,9 @@
 #include "mscore.h"
 #include "imageStore.h"
 
+#include <QCoreApplication>
+#include <QThread>
+
 namespace Ms {
 //---------------------------------------------------------
 //   propertyList
@@ -112,6 +115,15 @@ QSizeF Image::imageSize() const
     return imageType == ImageType::RASTER ? rasterDoc->size() : svgDoc->defaultSize();
 }
 
+//---------------------------------------------------------
+//   isGuiThread
+//---------------------------------------------------------
+
+static bool isGuiThread()
+{
+    return !QCoreApplication::instance() || QThread::currentThread() == QCoreApplication::instance()->thread();
+}
+
 //---------------------------------------------------------
 //   draw
 //---------------------------------------------------------
@@ -138,8 +150,20 @@ void Image::draw(QPainter* painter) const
             }
             if (score() && score()->printing() && !MScore::svgPrinting) {
                 // use original image size for printing, but not for svg for reasonable file size.
+                //! NOTE pages are printed on pool threads, QPixmap can only be used on the GUI thread
                 painter->scale(s.width() / rasterDoc->width(), s.height() / rasterDoc->height());
-                painter->drawPixmap(QPointF(0, 0), QPixmap::fromImage(*rasterDoc));
+                painter->drawImage(QPointF(0, 0), *rasterDoc);
+            } else if (!isGuiThread()) {
+                // no pixmap and no cached buffer off the GUI thread
+                QTransform t = painter->transform();
+                QSize ss = QSizeF(s.width() * t.m11(), s.height() * t.m22()).toSize();
+                t.setMatrix(1.0, t.m12(), t.m13(), t.m21(), 1.0, t.m23(), t.m31(), t.m32(), t.m33());
+                painter->setWorldTransform(t);
+                if (rasterDoc->isNull() || ss.isEmpty()) {
+                    emptyImage = true;
+                } else {
+                    painter->drawImage(QPointF(0.0, 0.0), rasterDoc->scaled(ss, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+                }
             } else {
                 QTransform t = painter->transform();
                 QSize ss = QSizeF(s.width() * t.m11(), s.height() * t.m22()).toSize();
@@ -10,6 +10,7 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <atomic>
 #include <cmath>
 #include <QtMath>
 
@@ -156,8 +157,16 @@ void Score::layoutChords1(Segment* segment, int staffIdx)
     const int startTrack = staffIdx * VOICES;
     const int endTrack   = startTrack + VOICES;
     const Fraction tick = segment->tick();
+    const bool storeChordLayout = MScore::reuseMasterChordLayout && isMaster() && !excerpts().empty();
 
     if (staff->isTabStaff(tick)) {
+        if (storeChordLayout) {
+            masterScore()->chordLayoutCache().store(segment, staffIdx);     // drops stale entries
+        }
+        layoutSegmentElements(segment, startTrack, endTrack);
+        return;
+    }
+    if (_replayChordLayout && masterScore()->chordLayoutCache().replay(segment, staffIdx)) {
         layoutSegmentElements(segment, startTrack, endTrack);
         return;
     }
@@ -593,6 +602,10 @@ void Score::layoutChords1(Segment* segment, int staffIdx)
         layoutChords3(notes, staff, segment);
     }
 
+    if (storeChordLayout) {
+        masterScore()->chordLayoutCache().store(segment, staffIdx);
+    }
+
     layoutSegmentElements(segment, startTrack, endTrack);
 }
 
@@ -1654,6 +1667,15 @@ static void distributeStaves(Page* page)
     Score* score { page->score() };
     VerticalGapDataList vgdl;
 
+    // All gap data of the page live in one block which is released at once;
+    // reserve the exact number of gaps so that pointers into it stay valid.
+    size_t maxGaps { 0 };
+    for (System* system : page->systems()) {
+        maxGaps += system->vbox() ? 1 : system->staves()->size();
+    }
+    std::vector<VerticalGapData> vgdStorage;
+    vgdStorage.reserve(maxGaps);
+
     // Find and classify all gaps between staves.
     int ngaps { 0 };
     qreal prevYBottom  { page->tm() };
@@ -1664,7 +1686,8 @@ static void distributeStaves(Page* page)
     bool transferCurlyBracket  { false };
     for (System* system : page->systems()) {
         if (system->vbox()) {
-            VerticalGapData* vgd = new VerticalGapData(!ngaps++, system, nullptr, nullptr, nullptr, prevYBottom);
+            vgdStorage.emplace_back(!ngaps++, system, nullptr, nullptr, nullptr, prevYBottom);
+            VerticalGapData* vgd = &vgdStorage.back();
             vgd->addSpaceAroundVBox(true);
             prevYBottom = system->y();
             yBottom     = system->y() + system->height();
@@ -1697,7 +1720,8 @@ static void distributeStaves(Page* page)
                     continue;
                 }
 
-                VerticalGapData* vgd = new VerticalGapData(!ngaps++, system, staff, sysStaff, activeSpacer, prevYBottom);
+                vgdStorage.emplace_back(!ngaps++, system, staff, sysStaff, activeSpacer, prevYBottom);
+                VerticalGapData* vgd = &vgdStorage.back();
                 activeSpacer = nullptr;
 
                 if (newSystem) {
@@ -1839,7 +1863,6 @@ static void distributeStaves(Page* page)
         system->layoutBracketsVertical();
         system->layoutInstrumentNames();
     }
-    vgdl.deleteAll();
 }
 
 //---------------------------------------------------------
@@ -2136,6 +2159,7 @@ System* Score::getNextSystem(LayoutContext& lc)
         lc.systemOldMeasure = system->measures().empty() ? 0 : system->measures().back();
         system->clear();       // remove measures from system
     }
+    system->setContentVersion(lc.layoutVersion);
     _systems.append(system);
     if (!isVBox) {
         int nstaves = Score::nstaves();
@@ -3719,7 +3743,7 @@ void layoutTies(Chord* ch, System* system, const Fraction& stick)
         if (t) {
             TieSegment* ts = t->layoutFor(system);
             if (ts && ts->addToSkyline()) {
-                staff->skyline().add(ts->shape().translated(ts->pos()));
+                staff->skyline().add(ts->shape(), ts->pos());
             }
         }
         t = note->tieBack();
@@ -3727,7 +3751,7 @@ void layoutTies(Chord* ch, System* system, const Fraction& stick)
             if (t->startNote()->tick() < stick) {
                 TieSegment* ts = t->layoutBack(system);
                 if (ts && ts->addToSkyline()) {
-                    staff->skyline().add(ts->shape().translated(ts->pos()));
+                    staff->skyline().add(ts->shape(), ts->pos());
                 }
             }
         }
@@ -3877,14 +3901,14 @@ void alignHarmonies(const System* system, const std::vector<Segment*>& sl, bool
             for (Element* e : qAsConst(modified)) {
                 const Segment* s = toSegment(e->parent());
                 const MeasureBase* m = toMeasureBase(s->parent());
-                system->staff(e->staffIdx())->skyline().add(e->shape().translated(e->pos() + s->pos() + m->pos()));
+                system->staff(e->staffIdx())->skyline().add(e->shape(), e->pos() + s->pos() + m->pos());
                 if (e->isFretDiagram()) {
                     FretDiagram* fd = toFretDiagram(e);
                     Harmony* h = fd->harmony();
                     if (h) {
-                        system->staff(e->staffIdx())->skyline().add(h->shape().translated(h->pos() + fd->pos() + s->pos() + m->pos()));
+                        system->staff(e->staffIdx())->skyline().add(h->shape(), h->pos() + fd->pos() + s->pos() + m->pos());
                     } else {
-                        system->staff(e->staffIdx())->skyline().add(fd->shape().translated(fd->pos() + s->pos() + m->pos()));
+                        system->staff(e->staffIdx())->skyline().add(fd->shape(), fd->pos() + s->pos() + m->pos());
                     }
                 }
             }
@@ -3969,7 +3993,7 @@ static void processLines(System* system, std::vector<Spanner*> lines, bool align
     //
     for (SpannerSegment* ss : segments) {
         if (ss->addToSkyline()) {
-            system->staff(ss->staffIdx())->skyline().add(ss->shape().translated(ss->pos()));
+            system->staff(ss->staffIdx())->skyline().add(ss->shape(), ss->pos());
         }
     }
 }
@@ -4479,7 +4503,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
 
                         // add element to skyline
                         if (e->addToSkyline()) {
-                            skyline.add(e->shape().translated(e->pos() + p));
+                            skyline.add(e->shape(), e->pos() + p);
                         }
 
                         // add tremolo to skyline
@@ -4489,7 +4513,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
                             Chord* c2 = t->chord2();
                             if (!t->twoNotes() || (c1 && !c1->staffMove() && c2 && !c2->staffMove())) {
                                 if (t->chord() == e && t->addToSkyline()) {
-                                    skyline.add(t->shape().translated(t->pos() + e->pos() + p));
+                                    skyline.add(t->shape(), t->pos() + e->pos() + p);
                                 }
                             }
                         }
@@ -4693,7 +4717,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
         int si = d->staffIdx();
         Segment* s = d->segment();
         Measure* m = s->measure();
-        system->staff(si)->skyline().add(d->shape().translated(d->pos() + s->pos() + m->pos()));
+        system->staff(si)->skyline().add(d->shape(), d->pos() + s->pos() + m->pos());
     }
 
     //-------------------------------------------------------------
@@ -4868,7 +4892,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
                     ss->rypos() = y;
                 }
                 if (ss->addToSkyline()) {
-                    system->staff(staffIdx)->skyline().add(ss->shape().translated(ss->pos()));
+                    system->staff(staffIdx)->skyline().add(ss->shape(), ss->pos());
                 }
             }
 
@@ -4930,6 +4954,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
 
 void LayoutContext::collectPage()
 {
+    page->invalidateDisplayList();
     const qreal slb = score->styleP(Sid::staffLowerBorder);
     bool breakPages = score->layoutMode() != LayoutMode::SYSTEM;
     qreal ey        = page->height() - page->bm();
@@ -5037,6 +5062,7 @@ void LayoutContext::collectPage()
                     score = ms;
                     QList<System*>& systems = ms->systems();
                     if (systems.empty() || systems.front()->measures().empty()) {
+                        qDeleteAll(systemList);     // left over from the previous movement
                         systemList         = systems;
                         systems.clear();
                         measureNo          = 0;
@@ -5090,6 +5116,11 @@ void LayoutContext::collectPage()
 
     Fraction stick = Fraction(-1,1);
     for (System* s : page->systems()) {
+        if (MScore::reuseUnchangedSystems && !systemChanged(s)) {
+            // system was taken over unchanged from the previous layout,
+            // only its position on the page may have moved
+            continue;
+        }
         Score* currentScore = s->score();
         for (MeasureBase* mb : s->measures()) {
             if (!mb->isMeasure()) {
@@ -5166,6 +5197,82 @@ void LayoutContext::collectPage()
     page->rebuildBspTree();
 }
 
+//---------------------------------------------------------
+//   systemChanged
+//    return true if the system was reflowed by this layout
+//    pass or follows a reflowed system (spanners
+//    continued from there may end in it)
+//---------------------------------------------------------
+
+bool LayoutContext::systemChanged(const System* system) const
+{
+    if (system->contentVersion() == layoutVersion || system->measures().empty()) {
+        return true;
+    }
+    const MeasureBase* pm = system->measures().front()->prevMM();
+    const System* ps = pm ? pm->system() : nullptr;
+    return ps && ps->contentVersion() == layoutVersion;
+}
+
+//---------------------------------------------------------
+//   takeOverPages
+//    Once the range is laid out, the following systems
+//    are taken over unchanged. If the next one started a
+//    page in the previous layout, all remaining pages
+//    would be filled as they were, even if the pages
+//    before now hold more or fewer systems: take them over
+//    as they are, only renumbered and moved. Two sided
+//    layouts alternate the margins, so there the page
+//    count must have changed by an even number.
+//    Return true if the layout is complete.
+//---------------------------------------------------------
+
+bool LayoutContext::takeOverPages()
+{
+    if (!rangeDone || !curSystem || oldPages.empty() || systemChanged(curSystem)) {
+        return false;
+    }
+    int first = 0;
+    while (first < oldPages.size() && (oldPages[first].empty() || oldPages[first].front() != curSystem)) {
+        ++first;
+    }
+    if (first == oldPages.size()) {
+        return false;
+    }
+    const int shift = curPage - (oldFirstPage + first);
+    if ((shift & 1) && score->styleB(Sid::pageTwosided)) {
+        return false;
+    }
+
+    // the systems still to come must be the ones on these pages
+    int idx = 0;
+    for (int i = first; i < oldPages.size(); ++i) {
+        for (System* s : oldPages[i]) {
+            if (s != curSystem && (idx >= systemList.size() || systemList[idx++] != s)) {
+                return false;
+            }
+        }
+    }
+
+    for (int i = first; i < oldPages.size(); ++i) {
+        getNextPage();
+        if (shift) {
+            page->invalidateDisplayList();
+        }
+        page->systems().clear();
+        for (System* s : oldPages[i]) {
+            page->appendSystem(s);
+            if (s != curSystem) {
+                score->systems().append(systemList.takeFirst());
+            }
+            prevSystem = s;
+        }
+        page->rebuildBspTree();
+    }
+    curSystem = nullptr;
+    return true;
+}
+
 //---------------------------------------------------------
 //   doLayout
 //    do a complete (re-) layout
@@ -5225,6 +5332,15 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     _scoreFont     = ScoreFont::fontFactory(style().value(Sid::MusicalSymbolFont).toString());
     _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
 
+    if (isMaster()) {
+        if (layoutAll) {
+            masterScore()->chordLayoutCache().clear();
+        }
+        _replayChordLayout = false;
+    } else {
+        _replayChordLayout = MScore::reuseMasterChordLayout && ChordLayoutCache::styleMatches(this, masterScore());
+    }
+
     if (cmdState().layoutFlags & LayoutFlag::REBUILD_MIDI_MAPPING) {
         if (isMaster()) {
             masterScore()->rebuildMidiMapping();
@@ -5294,6 +5410,13 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
         }
 
         _systems.erase(_systems.begin() + systemIndex, _systems.end());
+
+        if (MScore::reuseUnchangedSystems && !(isMaster() && masterScore()->next())) {
+            lc.oldFirstPage = lc.curPage;
+            for (int i = lc.curPage; i < npages(); ++i) {
+                lc.oldPages.push_back(pages()[i]->systems());
+            }
+        }
         if (!lc.nextMeasure->prevMeasure()) {
             lc.measureNo = 0;
             lc.tick      = Fraction(0,1);
@@ -5339,7 +5462,10 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
                 toMeasure(mb)->mmRest()->setSystem(0);
             }
         }
-        qDeleteAll(_systems);
+        // keep the systems for reuse by getNextSystem() instead of
+        // deleting and reallocating them with all their staves;
+        // the ones left over are deleted at the end of layout
+        lc.systemList = _systems;
         _systems.clear();
 
         qDeleteAll(pages());
@@ -5382,7 +5508,9 @@ void LayoutContext::layout()
         //    c) this page ends with the same measure as the previous layout
         //    pageOldMeasure will be last measure from previous layout if range was completed on or before this page
         //    it will be nullptr if this page was never laid out or if we collected a system for next page
-    } while (curSystem && !(rangeDone && lmb == pageOldMeasure));
+        // or
+        // 3) the remaining pages can be taken over from the previous layout (see takeOverPages())
+    } while (curSystem && !(rangeDone && lmb == pageOldMeasure) && !takeOverPages());
     // && page->system(0)->measures().back()->tick() > endTick // FIXME: perhaps the first measure was meant? Or last system?
 
     if (!curSystem) {
@@ -5409,6 +5537,8 @@ void LayoutContext::layout()
 LayoutContext::LayoutContext(Score* s)
     : score(s)
 {
+    static std::atomic<int> layoutVersionCounter { 0 };
+    layoutVersion = ++layoutVersionCounter;
     firstSystemIndent = score && score->styleB(Sid::enableIndentationOnFirstSystem);
 }
 
@@ -5596,17 +5726,6 @@ qreal VerticalGapData::addFillSpacing(qreal step, qreal maxFill)
     return res;
 }
 
-//---------------------------------------------------------
-//   deleteAll
-//---------------------------------------------------------
-
-void VerticalGapDataList::deleteAll()
-{
-    for (auto vsd : *this) {
-        delete vsd;
-    }
-}
-
 //---------------------------------------------------------
 //   sumStretchFactor
 //---------------------------------------------------------
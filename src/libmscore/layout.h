@@ -70,7 +70,6 @@ public:
 class VerticalGapDataList : public QList<VerticalGapData*>
 {
 public:
-    void deleteAll();
     qreal sumStretchFactor() const;
     qreal smallest(qreal limit=-1.0) const;
 };
@@ -87,9 +86,12 @@ struct LayoutContext {
     bool firstSystemIndent   { true };
     Page* page               { 0 };
     int curPage              { 0 };        // index in Score->page()s
+    int layoutVersion        { 0 };        // stamped on every system reflowed by this layout pass
     Fraction tick            { 0, 1 };
 
     QList<System*> systemList;            // reusable systems
+    QList<QList<System*> > oldPages;      // systems of the pages from oldFirstPage on, as laid out before
+    int oldFirstPage         { 0 };
     std::set<Spanner*> processedSpanners;
 
     System* prevSystem       { 0 };       // used during page layout
@@ -117,6 +119,8 @@ struct LayoutContext {
     int adjustMeasureNo(MeasureBase*);
     void getNextPage();
     void collectPage();
+    bool systemChanged(const System*) const;
+    bool takeOverPages();
 };
 
 //---------------------------------------------------------
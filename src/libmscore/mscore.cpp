@@ -71,6 +71,9 @@ bool MScore::showSkylines        = false;
 bool MScore::showMeasureShapes   = false;
 bool MScore::noHorizontalStretch = false;
 bool MScore::noVerticalStretch   = false;
+bool MScore::reuseUnchangedSystems = false;
+bool MScore::reuseMasterChordLayout = false;
+bool MScore::useDisplayLists = false;
 bool MScore::showBoundingRect    = false;
 bool MScore::showSystemBoundingRect    = false;
 bool MScore::showCorruptedMeasures = true;
@@ -115,13 +118,14 @@ int MScore::sampleRate  = 44100;
 int MScore::mtcType;
 
 bool MScore::noExcerpts = false;
-bool MScore::noImages = false;
-bool MScore::pdfPrinting = false;
-bool MScore::svgPrinting = false;
+RenderSetting<bool, &RenderContext::noImages> MScore::noImages { false };
+RenderSetting<bool, &RenderContext::pdfPrinting> MScore::pdfPrinting { false };
+RenderSetting<bool, &RenderContext::svgPrinting> MScore::svgPrinting { false };
 
-double MScore::pixelRatio  = 0.8;         // DPI / logicalDPI
+RenderSetting<double, &RenderContext::pixelRatio> MScore::pixelRatio { 0.8 };         // DPI / logicalDPI
+RenderSetting<bool, &RenderContext::recordingDisplayList> MScore::recordingDisplayList { false };
 
-MPaintDevice* MScore::_paintDevice;
+static thread_local const RenderContext* currentRenderContext = nullptr;
 
 Sequencer* MScore::seq = 0;
 MuseScoreCore* MuseScoreCore::mscoreCore;
@@ -467,10 +471,44 @@ const char* MScore::errorGroup()
 
 MPaintDevice* MScore::paintDevice()
 {
-    if (!_paintDevice) {
-        _paintDevice = new MPaintDevice();
-    }
-    return _paintDevice;
+    static MPaintDevice* paintDevice = new MPaintDevice();     // thread safe initialization
+    return paintDevice;
+}
+
+//---------------------------------------------------------
+//   current
+//    the render context in effect for the calling thread
+//---------------------------------------------------------
+
+RenderContext RenderContext::current()
+{
+    return { MScore::pixelRatio, MScore::pdfPrinting, MScore::svgPrinting, MScore::noImages, MScore::recordingDisplayList };
+}
+
+//---------------------------------------------------------
+//   threadContext
+//    the context installed by a RenderContextScope on the
+//    calling thread, nullptr if there is none
+//---------------------------------------------------------
+
+const RenderContext* RenderContext::threadContext()
+{
+    return currentRenderContext;
+}
+
+//---------------------------------------------------------
+//   RenderContextScope
+//---------------------------------------------------------
+
+RenderContextScope::RenderContextScope(const RenderContext& ctx)
+    : _context(ctx), _saved(currentRenderContext)
+{
+    currentRenderContext = &_context;
+}
+
+RenderContextScope::~RenderContextScope()
+{
+    currentRenderContext = _saved;
 }
 
 //---------------------------------------------------------
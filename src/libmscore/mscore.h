@@ -13,6 +13,8 @@
 #ifndef __MSCORE_H__
 #define __MSCORE_H__
 
+#include <atomic>
+
 #include <QPaintEngine>
 
 #include "config.h"
@@ -308,6 +310,58 @@ public:
     virtual ~MPaintDevice() {}
 };
 
+//---------------------------------------------------------
+//   RenderContext
+//    the MScore settings layout and drawing depend on.
+//    The values set on MScore apply to all threads; a
+//    thread which lays out or renders a score with other
+//    settings installs its own context with a
+//    RenderContextScope, which overrides them for that
+//    thread only, so that several scores can be laid out
+//    and rendered concurrently.
+//---------------------------------------------------------
+
+struct RenderContext {
+    double pixelRatio;
+    bool pdfPrinting;
+    bool svgPrinting;
+    bool noImages;
+    bool recordingDisplayList;
+
+    static RenderContext current();
+    static const RenderContext* threadContext();
+};
+
+//---------------------------------------------------------
+//   RenderSetting
+//    a process wide value which reads the override of
+//    the RenderContextScope of the calling thread, if any
+//---------------------------------------------------------
+
+template<typename T, T RenderContext::* member>
+class RenderSetting
+{
+    std::atomic<T> _value;
+
+public:
+    explicit RenderSetting(T val)
+        : _value(val) {}
+    RenderSetting(const RenderSetting&) = delete;
+
+    operator T() const
+    {
+        const RenderContext* ctx = RenderContext::threadContext();
+        return ctx ? ctx->*member : _value.load(std::memory_order_relaxed);
+    }
+
+    //! NOTE sets the process wide value, not the one of a RenderContextScope
+    RenderSetting& operator=(T val)
+    {
+        _value.store(val, std::memory_order_relaxed);
+        return *this;
+    }
+};
+
 //---------------------------------------------------------
 //   MScore
 //    MuseScore application object
@@ -324,8 +378,6 @@ class MScore
     static int _hRaster, _vRaster;
     static bool _verticalOrientation;
 
-    static MPaintDevice* _paintDevice;
-
 public:
     enum class DirectionH : char {   /**.\{*/
         AUTO, LEFT, RIGHT                                       /**\}*/
@@ -386,6 +438,9 @@ public:
 // #ifndef NDEBUG
     static bool noHorizontalStretch;
     static bool noVerticalStretch;
+    static bool reuseUnchangedSystems;
+    static bool reuseMasterChordLayout;
+    static bool useDisplayLists;
     static bool showSegmentShapes;
     static bool showSkylines;
     static bool showMeasureShapes;
@@ -406,11 +461,12 @@ public:
     static bool noGui;
 
     static bool noExcerpts;
-    static bool noImages;
-
-    static bool pdfPrinting;
-    static bool svgPrinting;
-    static double pixelRatio;
+    // see RenderContext
+    static RenderSetting<bool, &RenderContext::noImages> noImages;
+    static RenderSetting<bool, &RenderContext::pdfPrinting> pdfPrinting;
+    static RenderSetting<bool, &RenderContext::svgPrinting> svgPrinting;
+    static RenderSetting<double, &RenderContext::pixelRatio> pixelRatio;
+    static RenderSetting<bool, &RenderContext::recordingDisplayList> recordingDisplayList;
 
     static qreal verticalPageGap;
     static qreal horizontalPageGapEven;
@@ -423,6 +479,24 @@ public:
     static const char* errorGroup();
 };
 
+//---------------------------------------------------------
+//   RenderContextScope
+//    install a render context for the current thread;
+//    the previous one is restored on destruction
+//---------------------------------------------------------
+
+class RenderContextScope
+{
+    RenderContext _context;
+    const RenderContext* _saved;
+
+public:
+    RenderContextScope(const RenderContext&);
+    ~RenderContextScope();
+    RenderContextScope(const RenderContextScope&) = delete;
+    RenderContextScope& operator=(const RenderContextScope&) = delete;
+};
+
 //---------------------------------------------------------
 //   center
 //---------------------------------------------------------
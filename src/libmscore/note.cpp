@@ -2084,12 +2084,27 @@ void Note::addParentheses()
     score()->undoAddElement(s);
 }
 
+//---------------------------------------------------------
+//   setMark
+//    the mark colors the note (playback highlighting), so
+//    the display list of its page has to be redrawn
+//---------------------------------------------------------
+
+void Note::setMark(bool v) const
+{
+    if (v != _mark) {
+        invalidateDisplayList();
+    }
+    _mark = v;
+}
+
 //---------------------------------------------------------
 //   setDotY
 //---------------------------------------------------------
 
 void Note::setDotY(Direction pos)
 {
+    _dotPosition = pos;
     bool onLine = false;
     qreal y = 0;
 
@@ -263,6 +263,7 @@ private:
 
     MScore::DirectionH _userMirror { MScore::DirectionH::AUTO };        ///< user override of mirror
     Direction _userDotPosition     { Direction::AUTO };                 ///< user override of dot position
+    Direction _dotPosition         { Direction::AUTO };                 ///< dot position resolved by layout
 
     NoteHead::Scheme _headScheme { NoteHead::Scheme::HEAD_AUTO };
     NoteHead::Group _headGroup { NoteHead::Group::HEAD_NORMAL };
@@ -527,9 +528,10 @@ public:
     QString propertyUserValue(Pid) const override;
 
     bool mark() const { return _mark; }
-    void setMark(bool v) const { _mark = v; }
+    void setMark(bool v) const;
     void setScore(Score* s) override;
     void setDotY(Direction);
+    Direction dotPosition() const { return _dotPosition; }
 
     void addParentheses();
 
@@ -13,6 +13,7 @@
 #include "page.h"
 
 #include <QDateTime>
+#include <QPainter>
 
 #include "score.h"
 #include "text.h"
@@ -62,8 +63,7 @@ QList<Element*> Page::items(const QRectF& r)
     if (!bspTreeValid) {
         doRebuildBspTree();
     }
-    QList<Element*> el = bspTree.items(r);
-    return el;
+    return _rtree.items(r);
 #else
     Q_UNUSED(r)
     return QList<Element*>();
@@ -76,13 +76,58 @@ QList<Element*> Page::items(const QPointF& p)
     if (!bspTreeValid) {
         doRebuildBspTree();
     }
-    return bspTree.items(p);
+    return _rtree.items(p);
 #else
     Q_UNUSED(p)
     return QList<Element*>();
 #endif
 }
 
+//---------------------------------------------------------
+//   displayList
+//    all elements of the page recorded as a list of paint
+//    operations, in page coordinates. Layout and changes of
+//    the elements on the page invalidate it, it is recorded
+//    again when the page is painted next, so redrawing an
+//    unchanged page (scrolling, zooming, repainting the
+//    canvas) just replays it.
+//---------------------------------------------------------
+
+const QPicture& Page::displayList()
+{
+    if (!displayListValid()) {
+        recordDisplayList();
+    }
+    return _displayList;
+}
+
+//---------------------------------------------------------
+//   displayListValid
+//---------------------------------------------------------
+
+bool Page::displayListValid() const
+{
+    return _displayListValid && _displayListGeneration == score()->displayListGeneration();
+}
+
+//---------------------------------------------------------
+//   recordDisplayList
+//---------------------------------------------------------
+
+void Page::recordDisplayList()
+{
+    RenderContext ctx = RenderContext::current();
+    ctx.recordingDisplayList = true;
+    RenderContextScope renderContext(ctx);
+
+    _displayList = QPicture();
+    QPainter p(&_displayList);
+    paintElements(p, items(abbox()));
+    p.end();
+    _displayListValid      = true;
+    _displayListGeneration = score()->displayListGeneration();
+}
+
 //---------------------------------------------------------
 //   appendSystem
 //---------------------------------------------------------
@@ -236,46 +281,26 @@ void Page::scanElements(void* data, void (* func)(void*, Element*), bool all)
 
 #ifdef USE_BSP
 //---------------------------------------------------------
-//   bspInsert
+//   rtreeCollect
 //---------------------------------------------------------
 
-static void bspInsert(void* bspTree, Element* e)
-{
-    ((BspTree*)bspTree)->insert(e);
-}
-
-static void countElements(void* data, Element* /*e*/)
+static void rtreeCollect(void* data, Element* e)
 {
-    ++(*(int*)data);
+    static_cast<std::vector<RTree::Entry>*>(data)->push_back({ RTree::Box(e->pageBoundingRect()), e });
 }
 
 //---------------------------------------------------------
 //   doRebuildBspTree
+//    bulk load the hit testing tree with all elements
+//    of the page
 //---------------------------------------------------------
 
 void Page::doRebuildBspTree()
 {
-    int n = 0;
-    scanElements(&n, countElements, false);
-
-    QRectF r;
-    if (score()->layoutMode() == LayoutMode::LINE) {
-        qreal w = 0.0;
-        qreal h = 0.0;
-        if (!_systems.empty()) {
-            h = _systems.front()->height();
-            if (!_systems.front()->measures().empty()) {
-                MeasureBase* mb = _systems.front()->measures().back();
-                w = mb->x() + mb->width();
-            }
-        }
-        r = QRectF(0.0, 0.0, w, h);
-    } else {
-        r = abbox();
-    }
-
-    bspTree.initialize(r, n);
-    scanElements(&bspTree, &bspInsert, false);
+    std::vector<RTree::Entry> entries;
+    entries.reserve(_rtree.size());
+    scanElements(&entries, rtreeCollect, false);
+    _rtree.build(std::move(entries));
     bspTreeValid = true;
 }
 
@@ -13,9 +13,11 @@
 #ifndef __PAGE_H__
 #define __PAGE_H__
 
+#include <QPicture>
+
 #include "config.h"
 #include "element.h"
-#include "bsp.h"
+#include "rtree.h"
 
 namespace Ms {
 class System;
@@ -35,10 +37,13 @@ class Page final : public Element
     QList<System*> _systems;
     int _no;                        // page number
 #ifdef USE_BSP
-    BspTree bspTree;
+    RTree _rtree;
     void doRebuildBspTree();
 #endif
     bool bspTreeValid;
+    QPicture _displayList;
+    mutable bool _displayListValid { false };
+    int _displayListGeneration { -1 };
 
     QString replaceTextMacros(const QString&) const;
     void drawHeaderFooter(QPainter*, int area, const QString&) const;
@@ -76,6 +81,27 @@ public:
 
     QList<Element*> items(const QRectF& r);
     QList<Element*> items(const QPointF& p);
+    const QPicture& displayList();
+    void recordDisplayList();
+    bool displayListValid() const;
+    void invalidateDisplayList() const { _displayListValid = false; }
+
+    //! call visitor(Element*) for every element whose page bounding
+    //! rectangle intersects r, without building a list
+    template<typename Visitor>
+    void visitItems(const QRectF& r, Visitor visitor)
+    {
+#ifdef USE_BSP
+        if (!bspTreeValid) {
+            doRebuildBspTree();
+        }
+        _rtree.visit(r, visitor);
+#else
+        Q_UNUSED(r)
+        Q_UNUSED(visitor)
+#endif
+    }
+
     void rebuildBspTree() { bspTreeValid = false; }
     QPointF pagePos() const override { return QPointF(); }       ///< position in page coordinates
     QList<Element*> elements() const;           ///< list of visible elements
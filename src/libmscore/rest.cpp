@@ -1073,7 +1073,7 @@ Shape Rest::shape() const
     }
     for (Element* e : el()) {
         if (e->addToSkyline()) {
-            shape.add(e->shape().translated(e->pos()));
+            shape.add(e->shape(), e->pos());
         }
     }
     return shape;
@@ -0,0 +1,224 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "rtree.h"
+#include "element.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   unite
+//---------------------------------------------------------
+
+void RTree::Box::unite(const Box& b)
+{
+    if (x2 < x1) {
+        *this = b;
+        return;
+    }
+    x1 = qMin(x1, b.x1);
+    y1 = qMin(y1, b.y1);
+    x2 = qMax(x2, b.x2);
+    y2 = qMax(y2, b.y2);
+}
+
+//---------------------------------------------------------
+//   strSort
+//    sort-tile-recursive ordering: sort by x center,
+//    cut into vertical slices of slice * nodeSize items
+//    and sort every slice by y center
+//---------------------------------------------------------
+
+template<typename Iterator>
+static void strSort(Iterator begin, Iterator end, int nodeSize)
+{
+    const int n = int(end - begin);
+    if (n <= nodeSize) {
+        return;
+    }
+    std::sort(begin, end, [](const auto& a, const auto& b) {
+        return a.box.x1 + a.box.x2 < b.box.x1 + b.box.x2;
+    });
+    const int nodes  = (n + nodeSize - 1) / nodeSize;
+    const int slices = int(std::ceil(std::sqrt(double(nodes))));
+    const int sliceSize = slices * nodeSize;
+    for (int i = 0; i < n; i += sliceSize) {
+        Iterator sliceEnd = begin + qMin(i + sliceSize, n);
+        std::sort(begin + i, sliceEnd, [](const auto& a, const auto& b) {
+            return a.box.y1 + a.box.y2 < b.box.y1 + b.box.y2;
+        });
+    }
+}
+
+//---------------------------------------------------------
+//   build
+//    bulk load the tree, replacing all previous content
+//---------------------------------------------------------
+
+void RTree::build(std::vector<Entry>&& entries)
+{
+    _entries = std::move(entries);
+    _overflow.clear();
+    _removed = 0;
+    pack();
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void RTree::clear()
+{
+    _entries.clear();
+    _nodes.clear();
+    _levelStart.clear();
+    _overflow.clear();
+    _removed = 0;
+}
+
+//---------------------------------------------------------
+//   pack
+//---------------------------------------------------------
+
+void RTree::pack()
+{
+    _nodes.clear();
+    _levelStart.clear();
+
+    const int n = int(_entries.size());
+    if (n == 0) {
+        return;
+    }
+    _nodes.reserve(n / (NODE_SIZE - 1) + 8);
+
+    strSort(_entries.begin(), _entries.end(), NODE_SIZE);
+    _levelStart.push_back(0);
+    for (int i = 0; i < n; i += NODE_SIZE) {
+        Node node;
+        node.first = i;
+        node.count = qMin(NODE_SIZE, n - i);
+        for (int k = 0; k < node.count; ++k) {
+            node.box.unite(_entries[i + k].box);
+        }
+        _nodes.push_back(node);
+    }
+
+    int begin = 0;
+    int end   = int(_nodes.size());
+    while (end - begin > 1) {
+        packLevel(begin, end);
+        begin = end;
+        end   = int(_nodes.size());
+    }
+}
+
+//---------------------------------------------------------
+//   packLevel
+//    create the parent level for nodes [begin, end)
+//---------------------------------------------------------
+
+void RTree::packLevel(int begin, int end)
+{
+    strSort(_nodes.begin() + begin, _nodes.begin() + end, NODE_SIZE);
+    _levelStart.push_back(end);
+    for (int i = begin; i < end; i += NODE_SIZE) {
+        Node node;
+        node.first = i - begin;
+        node.count = qMin(NODE_SIZE, end - i);
+        for (int k = 0; k < node.count; ++k) {
+            node.box.unite(_nodes[i + k].box);
+        }
+        _nodes.push_back(node);
+    }
+}
+
+//---------------------------------------------------------
+//   insert
+//    add a single element; the tree is repacked once the
+//    overflow list grows too long for a linear scan
+//---------------------------------------------------------
+
+void RTree::insert(Element* e)
+{
+    _overflow.push_back({ Box(e->pageBoundingRect()), e });
+    if (int(_overflow.size()) > qMax(NODE_SIZE * 4, int(_entries.size()) / 8)) {
+        _entries.erase(std::remove_if(_entries.begin(), _entries.end(), [](const Entry& entry) { return !entry.element; }),
+                       _entries.end());
+        _entries.insert(_entries.end(), _overflow.begin(), _overflow.end());
+        _overflow.clear();
+        _removed = 0;
+        pack();
+    }
+}
+
+//---------------------------------------------------------
+//   remove
+//    oldBox is the page bounding box the element had
+//    when it was inserted
+//---------------------------------------------------------
+
+void RTree::remove(Element* e, const QRectF& oldBox)
+{
+    for (auto i = _overflow.begin(); i != _overflow.end(); ++i) {
+        if (i->element == e) {
+            _overflow.erase(i);
+            return;
+        }
+    }
+    if (_levelStart.empty()) {
+        return;
+    }
+    const Box b(oldBox);
+    const int leaves = _levelStart.size() > 1 ? _levelStart[1] : int(_nodes.size());
+    for (int i = 0; i < leaves; ++i) {
+        const Node& node = _nodes[i];
+        if (!node.box.intersects(b)) {
+            continue;
+        }
+        for (int k = node.first; k < node.first + node.count; ++k) {
+            if (_entries[k].element == e) {
+                _entries[k].element = nullptr;
+                ++_removed;
+                return;
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   items
+//---------------------------------------------------------
+
+QList<Element*> RTree::items(const QRectF& r) const
+{
+    QList<Element*> l;
+    visit(r, [&l, &r](Element* e) {
+        if (e->pageBoundingRect().intersects(r)) {
+            l.append(e);
+        }
+    });
+    return l;
+}
+
+QList<Element*> RTree::items(const QPointF& p) const
+{
+    QList<Element*> l;
+    visit(p, [&l, &p](Element* e) {
+        if (e->contains(p)) {
+            l.append(e);
+        }
+    });
+    return l;
+}
+}
@@ -0,0 +1,163 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __RTREE_H__
+#define __RTREE_H__
+
+#include <vector>
+
+#include <QRectF>
+#include <QList>
+
+namespace Ms {
+class Element;
+
+//---------------------------------------------------------
+//   RTree
+//    packed R-tree over element bounding boxes,
+//    bulk loaded with sort-tile-recursive (STR) packing
+//
+//    All nodes and entries live in two contiguous arrays;
+//    the nodes are stored level by level, leaves first,
+//    root last. Elements inserted after the bulk load are
+//    kept in a small unsorted overflow list until the next
+//    rebuild, removed ones are tombstoned.
+//---------------------------------------------------------
+
+class RTree
+{
+public:
+    struct Box {
+        qreal x1 { 0.0 };
+        qreal y1 { 0.0 };
+        qreal x2 { -1.0 };
+        qreal y2 { -1.0 };
+
+        Box() = default;
+        Box(const QRectF& r)
+            : x1(r.left()), y1(r.top()), x2(r.right()), y2(r.bottom()) {}
+
+        bool intersects(const Box& b) const { return x1 <= b.x2 && b.x1 <= x2 && y1 <= b.y2 && b.y1 <= y2; }
+        bool contains(qreal x, qreal y) const { return x1 <= x && x <= x2 && y1 <= y && y <= y2; }
+        void unite(const Box& b);
+    };
+
+    struct Entry {
+        Box box;
+        Element* element { nullptr };          // nullptr if removed
+    };
+
+private:
+    static constexpr int NODE_SIZE = 16;
+
+    struct Node {
+        Box box;
+        int first { 0 };        // index of first child in the level below (or in _entries)
+        int count { 0 };
+    };
+
+    std::vector<Entry> _entries;
+    std::vector<Node> _nodes;
+    std::vector<int> _levelStart;           // index of the first node of each level in _nodes
+    std::vector<Entry> _overflow;           // inserted after the bulk load
+    int _removed { 0 };
+
+    void pack();
+    void packLevel(int begin, int end);
+
+    template<typename Test, typename Visitor>
+    void search(const Test& test, Visitor& visitor) const;
+
+public:
+    void build(std::vector<Entry>&& entries);
+    void clear();
+
+    void insert(Element* e);
+    void remove(Element* e, const QRectF& oldBox);
+
+    int size() const { return int(_entries.size() + _overflow.size()) - _removed; }
+    bool empty() const { return size() == 0; }
+    int depth() const { return int(_levelStart.size()); }
+
+    //! visitor is called as visitor(Element*) for every element whose
+    //! bounding box intersects the rectangle or contains the point;
+    //! no memory is allocated
+    template<typename Visitor>
+    void visit(const QRectF& r, Visitor visitor) const
+    {
+        const Box b(r);
+        search([&b](const Box& box) { return box.intersects(b); }, visitor);
+    }
+
+    template<typename Visitor>
+    void visit(const QPointF& p, Visitor visitor) const
+    {
+        const qreal x = p.x();
+        const qreal y = p.y();
+        search([x, y](const Box& box) { return box.contains(x, y); }, visitor);
+    }
+
+    QList<Element*> items(const QRectF& r) const;
+    QList<Element*> items(const QPointF& p) const;
+};
+
+//---------------------------------------------------------
+//   search
+//---------------------------------------------------------
+
+template<typename Test, typename Visitor>
+void RTree::search(const Test& test, Visitor& visitor) const
+{
+    for (const Entry& entry : _overflow) {
+        if (entry.element && test(entry.box)) {
+            visitor(entry.element);
+        }
+    }
+    if (_nodes.empty()) {
+        return;
+    }
+
+    // explicit stack of (level, node index); the tree is at most
+    // a handful of levels deep, so a fixed size array is plenty
+    struct Item {
+        int level;
+        int node;
+    };
+    Item stack[NODE_SIZE * 8];
+    int sp = 0;
+    const int rootLevel = depth() - 1;
+    stack[sp++] = { rootLevel, int(_nodes.size()) - 1 };
+
+    while (sp) {
+        const Item item = stack[--sp];
+        const Node& node = _nodes[item.node];
+        if (!test(node.box)) {
+            continue;
+        }
+        if (item.level == 0) {
+            const Entry* e = _entries.data() + node.first;
+            for (const Entry* end = e + node.count; e != end; ++e) {
+                if (e->element && test(e->box)) {
+                    visitor(e->element);
+                }
+            }
+        } else {
+            const int childLevel = item.level - 1;
+            const int first = _levelStart[childLevel] + node.first;
+            for (int i = node.count - 1; i >= 0; --i) {
+                stack[sp++] = { childLevel, first + i };
+            }
+        }
+    }
+}
+}     // namespace Ms
+#endif
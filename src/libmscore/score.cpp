@@ -5261,6 +5261,11 @@ void Score::addRefresh(const QRectF& r)
 {
     _updateState.refresh |= r;
     cmdState().setUpdateMode(UpdateMode::Update);
+    for (Page* page : pages()) {
+        if (page->canvasBoundingRect().intersects(r)) {
+            page->invalidateDisplayList();
+        }
+    }
 }
 
 //---------------------------------------------------------
@@ -5299,6 +5304,9 @@ Staff* Score::staff(const QString& staffId) const
 void MasterScore::setUpdateAll()
 {
     _cmdState.setUpdateMode(UpdateMode::UpdateAll);
+    for (Score* s : scoreList()) {
+        s->invalidateDisplayLists();
+    }
 }
 
 //---------------------------------------------------------
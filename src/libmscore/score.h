@@ -33,6 +33,7 @@
 #include "layoutbreak.h"
 #include "property.h"
 #include "sym.h"
+#include "chordlayoutcache.h"
 
 namespace mu {
 namespace notation {
@@ -490,6 +491,7 @@ private:
     bool _showInstrumentNames   { true };
     bool _showVBox              { true };
     bool _printing              { false };        ///< True if we are drawing to a printer
+    int _displayListGeneration  { 0 };            ///< bumped whenever recorded page display lists get stale
     bool _autosaveDirty         { true };
     bool _savedCapture          { false };        ///< True if we saved an image capture
     bool _saved                 { false };      ///< True if project was already saved; only on first
@@ -511,6 +513,7 @@ private:
     PlayMode _playMode { PlayMode::SYNTHESIZER };
 
     qreal _noteHeadWidth { 0.0 };         // cached value
+    bool _replayChordLayout { false };    // take layoutChords1() results from the master score
     QString accInfo;                      ///< information about selected element(s) for use by screen-readers
     QString accMessage;                   ///< temporary status message for use by screen-readers
 
@@ -863,6 +866,7 @@ public:
     bool saveCompressedFile(QIODevice*, const QString& fileName, bool onlySelection, bool createThumbnail = true);
 
     void print(QPainter* printer, int page);
+    void printPage(QPainter* printer, int page) const;
     ChordRest* getSelectedChordRest() const;
     QSet<ChordRest*> getSelectedChordRests() const;
     void getSelectedChordRest2(ChordRest** cr1, ChordRest** cr2) const;
@@ -922,7 +926,15 @@ public:
     void setSaved(bool v) { _saved = v; }
     void setSavedCapture(bool v) { _savedCapture = v; }
     bool printing() const { return _printing; }
-    void setPrinting(bool val) { _printing = val; }
+    int displayListGeneration() const { return _displayListGeneration; }
+    void invalidateDisplayLists() { ++_displayListGeneration; }
+    void setPrinting(bool val)
+    {
+        if (val != _printing) {
+            invalidateDisplayLists();
+        }
+        _printing = val;
+    }
     void setAutosaveDirty(bool v) { _autosaveDirty = v; }
     bool autosaveDirty() const { return _autosaveDirty; }
     virtual bool playlistDirty() const;
@@ -1350,6 +1362,8 @@ class MasterScore : public Score
     Omr* _omr               { 0 };
     bool _showOmr           { false };
 
+    ChordLayoutCache _chordLayoutCache;
+
     std::shared_ptr<Avs::AvsOmr> _avsOmr { nullptr };
 
     Fraction _pos[3];                      ///< 0 - current, 1 - left loop, 2 - right loop
@@ -1418,6 +1432,8 @@ public:
 
     virtual CmdState& cmdState() override { return _cmdState; }
     const CmdState& cmdState() const override { return _cmdState; }
+
+    ChordLayoutCache& chordLayoutCache() { return _chordLayoutCache; }
     virtual void addLayoutFlags(LayoutFlags val) override { _cmdState.layoutFlags |= val; }
     virtual void setInstrumentsChanged(bool val) override { _cmdState._instrumentsChanged = val; }
 
@@ -15,6 +15,7 @@
 
 #include "types.h"
 #include "style.h"
+#include "allocationscope.h"
 
 namespace Ms {
 class ScoreElement;
@@ -189,6 +190,9 @@ public:
 
     virtual ~ScoreElement();
 
+    static void* operator new(size_t size) { AllocationScope::allocated(); return ::operator new(size); }
+    static void operator delete(void* p) { ::operator delete(p); }
+
     // Score Tree functions
     virtual ScoreElement* treeParent() const { return nullptr; }
     virtual ScoreElement* treeChild(int n) const { Q_UNUSED(n); return nullptr; }
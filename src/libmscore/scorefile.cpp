@@ -563,17 +563,18 @@ QImage Score::createThumbnail()
     pm.setDotsPerMeterY(dpm);
     pm.fill(0xffffffff);
 
-    double pr = MScore::pixelRatio;
-    MScore::pixelRatio = 1.0;
+    {
+        RenderContext ctx = RenderContext::current();
+        ctx.pixelRatio = 1.0;
+        RenderContextScope renderContext(ctx);
 
-    QPainter p(&pm);
-    p.setRenderHint(QPainter::Antialiasing, true);
-    p.setRenderHint(QPainter::TextAntialiasing, true);
-    p.scale(mag, mag);
-    print(&p, 0);
-    p.end();
-
-    MScore::pixelRatio = pr;
+        QPainter p(&pm);
+        p.setRenderHint(QPainter::Antialiasing, true);
+        p.setRenderHint(QPainter::TextAntialiasing, true);
+        p.scale(mag, mag);
+        print(&p, 0);
+        p.end();
+    }
 
     if (layoutMode() != mode) {
         setLayoutMode(mode);
@@ -1042,8 +1043,24 @@ Score::FileError MasterScore::read1(XmlReader& e, bool ignoreVersionError)
 
 void Score::print(QPainter* painter, int pageNo)
 {
+    RenderContext ctx = RenderContext::current();
+    ctx.pdfPrinting = true;
+    RenderContextScope renderContext(ctx);
+
     _printing  = true;
-    MScore::pdfPrinting = true;
+    printPage(painter, pageNo);
+    _printing = false;
+}
+
+//---------------------------------------------------------
+//   printPage
+//    draw a page without touching the printing flags;
+//    the caller sets them. Different pages may be drawn
+//    from different threads at the same time.
+//---------------------------------------------------------
+
+void Score::printPage(QPainter* painter, int pageNo) const
+{
     Page* page = pages().at(pageNo);
     QRectF fr  = page->abbox();
 
@@ -1058,8 +1075,6 @@ void Score::print(QPainter* painter, int pageNo)
         e->draw(painter);
         painter->restore();
     }
-    MScore::pdfPrinting = false;
-    _printing = false;
 }
 
 //---------------------------------------------------------
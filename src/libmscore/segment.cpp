@@ -675,6 +675,9 @@ void Segment::remove(Element* el)
     case ElementType::REST:
     {
         _elist[track] = 0;
+        if (el->isChord() && score()->isMaster()) {
+            score()->masterScore()->chordLayoutCache().remove(toChord(el));
+        }
         int staffIdx = el->staffIdx();
         measure()->checkMultiVoices(staffIdx);
         // spanners with this cr as start or end element will need relayout
@@ -2211,7 +2214,7 @@ void Segment::createShape(int staffIdx)
     for (int track = staffIdx * VOICES; track < (staffIdx + 1) * VOICES; ++track) {
         Element* e = _elist[track];
         if (e) {
-            s.add(e->shape().translated(e->pos()));
+            s.add(e->shape(), e->pos());
         }
     }
 #endif
@@ -2230,7 +2233,7 @@ void Segment::createShape(int staffIdx)
         if (effectiveTrack >= strack && effectiveTrack < etrack) {
             setVisible(true);
             if (e->addToSkyline() && !e->isMeasureRepeat()) {
-                s.add(e->shape().translated(e->pos()));
+                s.add(e->shape(), e->pos());
             }
         }
     }
@@ -2266,7 +2269,7 @@ void Segment::createShape(int staffIdx)
                    && !e->isStaffText()) {
             // annotations added here are candidates for collision detection
             // lyrics, ...
-            s.add(e->shape().translated(e->pos()));
+            s.add(e->shape(), e->pos());
         }
     }
 }
@@ -12,8 +12,133 @@
 
 #include "shape.h"
 #include "segment.h"
+#include "allocationscope.h"
+
+#include <cstring>
+#include <new>
+#include <type_traits>
 
 namespace Ms {
+static_assert(std::is_trivially_copyable<ShapeElement>::value, "Shape copies its elements with memcpy");
+
+//---------------------------------------------------------
+//   Shape
+//---------------------------------------------------------
+
+Shape::Shape(const Shape& s)
+    : Shape()
+{
+    *this = s;
+}
+
+Shape::Shape(Shape&& s) noexcept
+    : Shape()
+{
+    *this = std::move(s);
+}
+
+Shape& Shape::operator=(const Shape& s)
+{
+    if (&s == this) {
+        return *this;
+    }
+    _size = 0;
+    reserve(s._size);
+    if (s._size) {
+        memcpy(static_cast<void*>(_data), s._data, s._size * sizeof(ShapeElement));
+    }
+    _size = s._size;
+    return *this;
+}
+
+Shape& Shape::operator=(Shape&& s) noexcept
+{
+    if (&s == this) {
+        return *this;
+    }
+    if (s.isInline()) {
+        release();
+        if (s._size) {
+            memcpy(static_cast<void*>(_data), s._data, s._size * sizeof(ShapeElement));
+        }
+    } else {
+        release();
+        _data = s._data;
+        _capacity = s._capacity;
+        s._data = s.inlineData();
+        s._capacity = INLINE_SIZE;
+    }
+    _size = s._size;
+    s._size = 0;
+    return *this;
+}
+
+//---------------------------------------------------------
+//   release
+//    drop heap storage, leaves an empty inline shape
+//---------------------------------------------------------
+
+void Shape::release()
+{
+    if (!isInline()) {
+        ::operator delete(_data);
+        _data = inlineData();
+        _capacity = INLINE_SIZE;
+    }
+    _size = 0;
+}
+
+//---------------------------------------------------------
+//   reserve
+//---------------------------------------------------------
+
+void Shape::reserve(size_t n)
+{
+    if (n <= _capacity) {
+        return;
+    }
+    AllocationScope::allocated();
+    ShapeElement* d = static_cast<ShapeElement*>(::operator new(n * sizeof(ShapeElement)));
+    if (_size) {
+        memcpy(static_cast<void*>(d), _data, _size * sizeof(ShapeElement));
+    }
+    if (!isInline()) {
+        ::operator delete(_data);
+    }
+    _data = d;
+    _capacity = n;
+}
+
+//---------------------------------------------------------
+//   push_back
+//---------------------------------------------------------
+
+void Shape::push_back(const ShapeElement& e)
+{
+    const ShapeElement se(e);     // e may live in this shape
+    if (_size == _capacity) {
+        reserve(_capacity * 2);
+    }
+    new (_data + _size) ShapeElement(se);
+    ++_size;
+}
+
+//---------------------------------------------------------
+//   add
+//---------------------------------------------------------
+
+void Shape::add(const Shape& s)
+{
+    if (&s == this) {
+        Shape copy(s);
+        add(copy);
+        return;
+    }
+    reserve(_size + s._size);
+    for (const ShapeElement& r : s) {
+        push_back(r);
+    }
+}
 //---------------------------------------------------------
 //   addHorizontalSpacing
 //    Currently implemented by adding rectangles of zero
@@ -37,14 +162,14 @@ void Shape::addHorizontalSpacing(HorizontalSpacingType type, qreal leftEdge, qre
 
 void Shape::translate(const QPointF& pt)
 {
-    for (QRectF& r : *this) {
+    for (ShapeElement& r : *this) {
         r.translate(pt);
     }
 }
 
 void Shape::translateX(qreal xo)
 {
-    for (QRectF& r : *this) {
+    for (ShapeElement& r : *this) {
         r.setLeft(r.left() + xo);
         r.setRight(r.right() + xo);
     }
@@ -52,7 +177,7 @@ void Shape::translateX(qreal xo)
 
 void Shape::translateY(qreal yo)
 {
-    for (QRectF& r : *this) {
+    for (ShapeElement& r : *this) {
         r.setTop(r.top() + yo);
         r.setBottom(r.bottom() + yo);
     }
@@ -60,22 +185,47 @@ void Shape::translateY(qreal yo)
 
 //---------------------------------------------------------
 //   translated
+//    a temporary shape, as returned by Element::shape(),
+//    is moved and translated in place
+//---------------------------------------------------------
+
+Shape Shape::translated(const QPointF& pt) const&
+{
+    Shape s(*this);
+    s.translate(pt);
+    return s;
+}
+
+Shape Shape::translated(const QPointF& pt) &&
+{
+    translate(pt);
+    return std::move(*this);
+}
+
+//---------------------------------------------------------
+//   add
+//    append s moved by offset; same as add(s.translated(offset))
+//    without creating a temporary shape
 //---------------------------------------------------------
 
-Shape Shape::translated(const QPointF& pt) const
+void Shape::add(const Shape& s, const QPointF& offset)
 {
-    Shape s;
-    for (const ShapeElement& r : *this)
+    if (&s == this) {
+        Shape copy(s);
+        add(copy, offset);
+        return;
+    }
+    reserve(_size + s._size);
+    for (const ShapeElement& r : s)
 #ifndef NDEBUG
     {
-        s.add(r.translated(pt), r.text);
+        add(r.translated(offset), r.text);
     }
 #else
     {
-        s.add(r.translated(pt));
+        add(r.translated(offset));
     }
 #endif
-    return s;
 }
 
 //-------------------------------------------------------------------
@@ -236,9 +386,11 @@ qreal Shape::bottomDistance(const QPointF& p) const
 
 void Shape::remove(const QRectF& r)
 {
-    for (auto i = begin(); i != end(); ++i) {
+    ShapeElement* e = end();
+    for (ShapeElement* i = begin(); i != e; ++i) {
         if (*i == r) {
-            erase(i);
+            memmove(static_cast<void*>(i), i + 1, (e - i - 1) * sizeof(ShapeElement));
+            --_size;
             return;
         }
     }
@@ -42,9 +42,8 @@ struct ShapeElement : public QRectF {
 //   Shape
 //---------------------------------------------------------
 
-class Shape : public std::vector<ShapeElement>
+class Shape
 {
-// class Shape : std::vector<ShapeElement> {
 public:
     enum HorizontalSpacingType {
         SPACING_GENERAL = 0,
@@ -52,13 +51,23 @@ public:
         SPACING_HARMONY,
     };
 
-    Shape() {}
+    Shape()
+        : _data(inlineData()) {}
 #ifndef NDEBUG
-    Shape(const QRectF& r, const char* s = 0) { add(r, s); }
+    Shape(const QRectF& r, const char* s = 0)
+        : Shape() { add(r, s); }
 #else
-    Shape(const QRectF& r) { add(r); }
+    Shape(const QRectF& r)
+        : Shape() { add(r); }
 #endif
-    void add(const Shape& s) { insert(end(), s.begin(), s.end()); }
+    Shape(const Shape&);
+    Shape(Shape&&) noexcept;
+    Shape& operator=(const Shape&);
+    Shape& operator=(Shape&&) noexcept;
+    ~Shape() { release(); }
+
+    void add(const Shape& s);
+    void add(const Shape& s, const QPointF& offset);
 #ifndef NDEBUG
     void add(const QRectF& r, const char* t = 0);
 #else
@@ -72,7 +81,8 @@ public:
     void translate(const QPointF&);
     void translateX(qreal);
     void translateY(qreal);
-    Shape translated(const QPointF&) const;
+    Shape translated(const QPointF&) const&;
+    Shape translated(const QPointF&) &&;
 
     qreal minHorizontalDistance(const Shape&) const;
     qreal minVerticalDistance(const Shape&) const;
@@ -83,9 +93,15 @@ public:
     qreal top() const;
     qreal bottom() const;
 
-    size_t size() const { return std::vector<ShapeElement>::size(); }
-    bool empty() const { return std::vector<ShapeElement>::empty(); }
-    void clear() { std::vector<ShapeElement>::clear(); }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    void clear() { _size = 0; }
+    void reserve(size_t n);
+
+    const ShapeElement* begin() const { return _data; }
+    const ShapeElement* end() const { return _data + _size; }
+    ShapeElement* begin() { return _data; }
+    ShapeElement* end() { return _data + _size; }
 
     bool contains(const QPointF&) const;
     bool intersects(const QRectF& rr) const;
@@ -95,6 +111,21 @@ public:
 #ifndef NDEBUG
     void dump(const char*) const;
 #endif
+
+private:
+    //! NOTE Most shapes hold one or two rectangles. These live in the
+    //! shape itself, larger shapes spill to the heap.
+    static constexpr size_t INLINE_SIZE = 2;
+
+    ShapeElement* inlineData() { return reinterpret_cast<ShapeElement*>(_inline); }
+    bool isInline() const { return _data == reinterpret_cast<const ShapeElement*>(_inline); }
+    void push_back(const ShapeElement&);
+    void release();
+
+    ShapeElement* _data;
+    size_t _size { 0 };
+    size_t _capacity { INLINE_SIZE };
+    alignas(ShapeElement) unsigned char _inline[INLINE_SIZE * sizeof(ShapeElement)];
 };
 
 //---------------------------------------------------------
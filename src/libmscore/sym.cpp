@@ -16,10 +16,16 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
-#include <QCache>
+#include <QMutex>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
 
 #include "style.h"
 #include "sym.h"
+#include "glyphcache.h"
 #include "utils.h"
 #include "score.h"
 #include "xml.h"
@@ -28,8 +34,10 @@
 #include FT_GLYPH_H
 #include FT_IMAGE_H
 #include FT_BBOX_H
+#include FT_OUTLINE_H
 
 static FT_Library ftlib;
+static QMutex ftMutex;          // guards the FreeType faces and the lazily created print fonts
 
 namespace Ms {
 //---------------------------------------------------------
@@ -6365,16 +6373,6 @@ SymId Sym::userName2id(const QString& s)
     return SymId::noSym;
 }
 
-//---------------------------------------------------------
-//   GlyphKey operator==
-//---------------------------------------------------------
-
-bool GlyphKey::operator==(const GlyphKey& k) const
-{
-    return (face == k.face) && (id == k.id)
-           && (magX == k.magX) && (magY == k.magY) && (worldScale == k.worldScale) && (color == k.color);
-}
-
 Sym ScoreFont::sym(SymId id) const
 {
     int index = static_cast<int>(id);
@@ -6421,13 +6419,10 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
         }
         return;
     }
-    int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
-    if (rv) {
-        qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
-        return;
-    }
-
-    if (MScore::pdfPrinting) {
+    // glyphs recorded into a page display list are drawn as text,
+    // so that replaying it at any zoom level stays sharp
+    if (MScore::pdfPrinting || MScore::recordingDisplayList) {
+        QMutexLocker lock(&ftMutex);        // pages may be printed in parallel
         if (font == 0) {
             QString s(_fontPath + _filename);
             if (-1 == QFontDatabase::addApplicationFont(s)) {
@@ -6441,30 +6436,53 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
             font->setStyleStrategy(QFont::NoFontMerging);
             font->setHintingPreference(QFont::PreferVerticalHinting);
         }
+        QFont f(*font);
+        lock.unlock();
         qreal size = 20.0 * MScore::pixelRatio;
-        font->setPointSize(size);
+        f.setPointSize(size);
         QSizeF imag = QSizeF(1.0 / mag.width(), 1.0 / mag.height());
         painter->scale(mag.width(), mag.height());
-        painter->setFont(*font);
+        painter->setFont(f);
         painter->drawText(QPointF(pos.x() * imag.width(), pos.y() * imag.height()), toString(id));
         painter->scale(imag.width(), imag.height());
         return;
     }
 
-    QColor color(painter->pen().color());
-
     int pr           = painter->device()->devicePixelRatio();
     qreal pixelRatio = qreal(pr > 0 ? pr : 1);
     worldScale      *= pixelRatio;
 //      if (worldScale < 1.0)
 //            worldScale = 1.0;
-    int scale16X      = lrint(worldScale * 6553.6 * mag.width() * DPI_F);
-    int scale16Y      = lrint(worldScale * 6553.6 * mag.height() * DPI_F);
 
-    GlyphKey gk(face, id, mag.width(), mag.height(), worldScale, color);
-    GlyphPixmap* pm = cache->object(gk);
+    // Large glyphs (high resolution images, big zoom factors) are filled
+    // as outlines by the scanline rasterizer of the raster engine: their
+    // masks would be big, differ for every magnification and rarely be
+    // reused. Small glyphs are blitted from the glyph cache. The default
+    // threshold keeps noteheads, rests, flags and accidentals on masks
+    // up to 600 dpi (a notehead is about 25 px at 300 dpi, 50 px at 600).
+    QPaintEngine* engine = painter->paintEngine();
+    if (engine && engine->type() == QPaintEngine::Raster) {
+        const QRectF bb = sym(id).bbox();
+        if (qMax(bb.width() * mag.width(), bb.height() * mag.height()) * worldScale > _outlineThreshold) {
+            const QPainterPath path = outline(id);
+            painter->save();
+            painter->translate(pos);
+            painter->scale(mag.width(), mag.height());
+            painter->fillPath(path, painter->pen().color());
+            painter->restore();
+            return;
+        }
+    }
 
-    if (!pm) {
+    auto rasterize = [this, id, &mag, worldScale](GlyphImage& mask) {
+        QMutexLocker lock(&ftMutex);
+        int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
+        if (rv) {
+            qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
+            return false;
+        }
+        int scale16X = lrint(worldScale * 6553.6 * mag.width() * DPI_F);
+        int scale16Y = lrint(worldScale * 6553.6 * mag.height() * DPI_F);
         FT_Matrix matrix {
             scale16X, 0,
             0,       scale16Y
@@ -6476,7 +6494,8 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
         rv = FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, 0, 1);
         if (rv) {
             qDebug("glyph to bitmap failed: 0x%x", rv);
-            return;
+            FT_Done_Glyph(glyph);
+            return false;
         }
 
         FT_BitmapGlyph gb = (FT_BitmapGlyph)glyph;
@@ -6484,30 +6503,25 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
 
         if (bm->width == 0 || bm->rows == 0) {
             qDebug("zero glyph, id %d", int(id));
-            return;
+            FT_Done_Glyph(glyph);
+            return false;
         }
-        QImage img(QSize(bm->width, bm->rows), QImage::Format_ARGB32);
-        img.fill(Qt::transparent);
-
+        QImage img(QSize(bm->width, bm->rows), QImage::Format_Alpha8);
         for (unsigned y = 0; y < bm->rows; ++y) {
-            unsigned* dst      = (unsigned*)img.scanLine(y);
-            unsigned char* src = (unsigned char*)(bm->buffer) + bm->pitch * y;
-            for (unsigned x = 0; x < bm->width; ++x) {
-                unsigned val = *src++;
-                color.setAlpha(std::min(int(val), painter->pen().color().alpha()));
-                *dst++ = color.rgba();
-            }
-        }
-        pm = new GlyphPixmap;
-        pm->pm = QPixmap::fromImage(img, Qt::NoFormatConversion);
-        pm->pm.setDevicePixelRatio(worldScale);
-        pm->offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
-        if (!cache->insert(gk, pm)) {
-            qDebug("cannot cache glyph");
+            memcpy(img.scanLine(y), (unsigned char*)(bm->buffer) + bm->pitch * y, bm->width);
         }
+        img.setDevicePixelRatio(worldScale);
+        mask.image  = img;
+        mask.offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
         FT_Done_Glyph(glyph);
+        return true;
+    };
+
+    GlyphImage gi;
+    GlyphKey gk(face, id, mag.width(), mag.height(), worldScale);
+    if (GlyphCache::instance()->mask(gk, rasterize, gi)) {
+        GlyphCache::draw(painter, pos, gi, painter->pen().color().rgba());
     }
-    painter->drawPixmap(pos + pm->offset, pm->pm);
 }
 
 void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos, int n) const
@@ -6623,6 +6637,81 @@ QString ScoreFont::toString(SymId id) const
     return codeToString(code);
 }
 
+//---------------------------------------------------------
+//   outline
+//    glyph outline in score coordinates for mag 1. The
+//    curves are flattened into polygons once per glyph,
+//    at the resolution of the FreeType face (26.6 fixed
+//    point at 200 pixels), so that filling does not need
+//    to subdivide them again.
+//---------------------------------------------------------
+
+static int outlineMoveTo(const FT_Vector* to, void* user)
+{
+    static_cast<QPainterPath*>(user)->moveTo(to->x, to->y);
+    return 0;
+}
+
+static int outlineLineTo(const FT_Vector* to, void* user)
+{
+    static_cast<QPainterPath*>(user)->lineTo(to->x, to->y);
+    return 0;
+}
+
+static int outlineConicTo(const FT_Vector* c, const FT_Vector* to, void* user)
+{
+    static_cast<QPainterPath*>(user)->quadTo(c->x, c->y, to->x, to->y);
+    return 0;
+}
+
+static int outlineCubicTo(const FT_Vector* c1, const FT_Vector* c2, const FT_Vector* to, void* user)
+{
+    static_cast<QPainterPath*>(user)->cubicTo(c1->x, c1->y, c2->x, c2->y, to->x, to->y);
+    return 0;
+}
+
+//---------------------------------------------------------
+//   outlineScale
+//    score units per outline unit (26.6 fixed point) of a
+//    face set to ppem pixels; a glyph of 20 pixels is
+//    DPI score units high
+//---------------------------------------------------------
+
+static qreal outlineScale(FT_UShort ppem)
+{
+    return DPI_F * 20.0 / (qreal(ppem) * 64.0);
+}
+
+QPainterPath ScoreFont::outline(SymId id) const
+{
+    QMutexLocker lock(&ftMutex);
+    auto i = _outlines.constFind(int(id));
+    if (i != _outlines.constEnd()) {
+        return *i;
+    }
+
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill);
+    int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
+    if (rv) {
+        qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
+    } else if (face->glyph->format == FT_GLYPH_FORMAT_OUTLINE) {
+        static const FT_Outline_Funcs funcs {
+            outlineMoveTo, outlineLineTo, outlineConicTo, outlineCubicTo, 0, 0
+        };
+        QPainterPath curves;
+        FT_Outline_Decompose(&face->glyph->outline, &funcs, &curves);
+
+        const QTransform toScore = QTransform::fromScale(outlineScale(face->size->metrics.x_ppem),
+                                                         -outlineScale(face->size->metrics.y_ppem));
+        for (const QPolygonF& polygon : curves.toSubpathPolygons()) {
+            path.addPolygon(toScore.map(polygon));
+        }
+    }
+    _outlines.insert(int(id), path);
+    return path;
+}
+
 //---------------------------------------------------------
 //   computeMetrics
 //---------------------------------------------------------
@@ -6668,11 +6757,121 @@ void ScoreFont::load()
         qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
         return;
     }
-    cache = new QCache<GlyphKey, GlyphPixmap>(100);
 
     qreal pixelSize = 200.0;
     FT_Set_Pixel_Sizes(face, 0, int(pixelSize + .5));
 
+    QFile fi(_fontPath + "metadata.json");
+    if (!fi.open(QIODevice::ReadOnly)) {
+        qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
+    }
+    const QByteArray metadata = fi.readAll();
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(fontImage);
+    hash.addData(metadata);
+    const QByteArray fontHash = hash.result();
+
+    const QString cachePath = metricsCachePath();
+    if (!readMetrics(cachePath, fontHash)) {
+        loadMetrics(metadata);
+        writeMetrics(cachePath, fontHash);
+    }
+    _engravingDefaults.push_back(std::make_pair(Sid::MusicalTextFont, QString("%1 Text").arg(_family)));
+
+    // create missing composed glyphs
+    struct Composed {
+        SymId id;
+        std::vector<SymId> rids;
+    } composed[] = {
+        { SymId::ornamentPrallMordent,
+          {
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentMiddleVerticalStroke,
+              SymId::ornamentZigZagLineWithRightEnd
+          } },
+        { SymId::ornamentUpPrall,
+          {
+              SymId::ornamentBottomLeftConcaveStroke,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineWithRightEnd
+          } },
+        { SymId::ornamentUpMordent,
+          {
+              SymId::ornamentBottomLeftConcaveStroke,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentMiddleVerticalStroke,
+              SymId::ornamentZigZagLineWithRightEnd
+          } },
+        { SymId::ornamentPrallDown,
+          {
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentBottomRightConcaveStroke,
+          } },
+#if 0
+        {
+            SymId::ornamentDownPrall,
+            {
+                SymId::ornamentTopLeftConvexStroke,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentZigZagLineWithRightEnd
+            }
+        },
+#endif
+        {
+            SymId::ornamentDownMordent,
+            {
+                SymId::ornamentLeftVerticalStroke,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentMiddleVerticalStroke,
+                SymId::ornamentZigZagLineWithRightEnd
+            }
+        },
+        { SymId::ornamentPrallUp,
+          {
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentTopRightConvexStroke,
+          } },
+        { SymId::ornamentLinePrall,
+          {
+              SymId::ornamentLeftVerticalStroke,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineWithRightEnd
+          } }
+    };
+
+    for (const Composed& c : composed) {
+        if (!_symbols[int(c.id)].isValid()) {
+            Sym* sym = &_symbols[int(c.id)];
+            std::vector<SymId> s;
+            for (SymId id : c.rids) {
+                s.push_back(id);
+            }
+            sym->setSymList(s);
+            sym->setBbox(bbox(s, 1.0));
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   loadMetrics
+//    compute the glyph metrics with FreeType and read
+//    anchors, alternates and engraving defaults from the
+//    font metadata
+//---------------------------------------------------------
+
+void ScoreFont::loadMetrics(const QByteArray& metadata)
+{
     for (size_t id = 0; id < _mainSymCodeTable.size(); ++id) {
         uint code = _mainSymCodeTable[id];
         if (code == 0) {
@@ -6684,13 +6883,9 @@ void ScoreFont::load()
     }
 
     QJsonParseError error;
-    QFile fi(_fontPath + "metadata.json");
-    if (!fi.open(QIODevice::ReadOnly)) {
-        qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
-    }
-    QJsonObject metadataJson = QJsonDocument::fromJson(fi.readAll(), &error).object();
+    QJsonObject metadataJson = QJsonDocument::fromJson(metadata, &error).object();
     if (error.error != QJsonParseError::NoError) {
-        qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(fi.fileName()),
+        qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(_fontPath + "metadata.json"),
                error.offset, qPrintable(error.errorString()));
     }
 
@@ -6783,91 +6978,6 @@ void ScoreFont::load()
             }
         }
     }
-    _engravingDefaults.push_back(std::make_pair(Sid::MusicalTextFont, QString("%1 Text").arg(_family)));
-
-    // create missing composed glyphs
-    struct Composed {
-        SymId id;
-        std::vector<SymId> rids;
-    } composed[] = {
-        { SymId::ornamentPrallMordent,
-          {
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentMiddleVerticalStroke,
-              SymId::ornamentZigZagLineWithRightEnd
-          } },
-        { SymId::ornamentUpPrall,
-          {
-              SymId::ornamentBottomLeftConcaveStroke,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineWithRightEnd
-          } },
-        { SymId::ornamentUpMordent,
-          {
-              SymId::ornamentBottomLeftConcaveStroke,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentMiddleVerticalStroke,
-              SymId::ornamentZigZagLineWithRightEnd
-          } },
-        { SymId::ornamentPrallDown,
-          {
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentBottomRightConcaveStroke,
-          } },
-#if 0
-        {
-            SymId::ornamentDownPrall,
-            {
-                SymId::ornamentTopLeftConvexStroke,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentZigZagLineWithRightEnd
-            }
-        },
-#endif
-        {
-            SymId::ornamentDownMordent,
-            {
-                SymId::ornamentLeftVerticalStroke,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentMiddleVerticalStroke,
-                SymId::ornamentZigZagLineWithRightEnd
-            }
-        },
-        { SymId::ornamentPrallUp,
-          {
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentTopRightConvexStroke,
-          } },
-        { SymId::ornamentLinePrall,
-          {
-              SymId::ornamentLeftVerticalStroke,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineWithRightEnd
-          } }
-    };
-
-    for (const Composed& c : composed) {
-        if (!_symbols[int(c.id)].isValid()) {
-            Sym* sym = &_symbols[int(c.id)];
-            std::vector<SymId> s;
-            for (SymId id : c.rids) {
-                s.push_back(id);
-            }
-            sym->setSymList(s);
-            sym->setBbox(bbox(s, 1.0));
-        }
-    }
-
     // access needed stylistic alternates
 
     struct StylisticAlternate {
@@ -6980,6 +7090,186 @@ void ScoreFont::load()
 #endif
 }
 
+//---------------------------------------------------------
+//   metrics cache
+//    the result of loadMetrics() is stored per font in a
+//    binary file: a header, one SymRecord per SymId, then
+//    the anchors and the engraving defaults. The file is
+//    only valid for the font and metadata it was created
+//    from (hash) and for this layout of the records
+//    (METRICS_VERSION, record sizes).
+//---------------------------------------------------------
+
+static const char METRICS_MAGIC[4] = { 'M', 'S', 'F', 'M' };
+static constexpr quint32 METRICS_VERSION = 1;
+
+struct MetricsHeader {
+    char magic[4];
+    quint32 version;
+    char hash[16];
+    quint32 symbols;
+    quint32 anchors;
+    quint32 defaults;
+    quint32 recordSize;
+    double textEnclosureThickness;
+};
+
+struct SymRecord {
+    qint32 code;
+    quint32 index;
+    double bbox[4];
+    double advance;
+};
+
+struct AnchorRecord {
+    quint32 sym;
+    quint32 anchor;
+    double x;
+    double y;
+};
+
+struct DefaultRecord {
+    quint32 sid;
+    quint32 reserved;
+    double value;
+};
+
+static constexpr quint32 METRICS_RECORD_SIZE
+    = (sizeof(SymRecord) << 16) | (sizeof(AnchorRecord) << 8) | sizeof(DefaultRecord);
+
+QString ScoreFont::_metricsCacheDir;
+qreal ScoreFont::_outlineThreshold = 128.0;
+
+//---------------------------------------------------------
+//   metricsCachePath
+//---------------------------------------------------------
+
+QString ScoreFont::metricsCachePath() const
+{
+    if (_metricsCacheDir.isNull()) {
+        _metricsCacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        if (!_metricsCacheDir.isEmpty()) {
+            _metricsCacheDir += "/scorefonts";
+        }
+    }
+    if (_metricsCacheDir.isEmpty()) {
+        return QString();
+    }
+    return QString("%1/%2.metrics").arg(_metricsCacheDir, _name.toLower());
+}
+
+//---------------------------------------------------------
+//   readMetrics
+//    read metrics from the cache file instead of loading
+//    them; returns false if the file is missing or stale
+//---------------------------------------------------------
+
+bool ScoreFont::readMetrics(const QString& path, const QByteArray& hash)
+{
+    if (path.isEmpty()) {
+        return false;
+    }
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const qint64 size = f.size();
+    if (size < qint64(sizeof(MetricsHeader))) {
+        return false;
+    }
+    const uchar* data = f.map(0, size);
+    if (!data) {
+        return false;
+    }
+
+    MetricsHeader h;
+    memcpy(&h, data, sizeof(h));
+    if (memcmp(h.magic, METRICS_MAGIC, sizeof(h.magic)) || h.version != METRICS_VERSION
+        || h.recordSize != METRICS_RECORD_SIZE || hash.size() != int(sizeof(h.hash))
+        || memcmp(h.hash, hash.constData(), sizeof(h.hash)) || h.symbols != quint32(_symbols.size())) {
+        return false;
+    }
+    const qint64 expected = qint64(sizeof(MetricsHeader)) + h.symbols * sizeof(SymRecord)
+                            + h.anchors * sizeof(AnchorRecord) + h.defaults * sizeof(DefaultRecord);
+    if (size != expected) {
+        return false;
+    }
+
+    const uchar* p = data + sizeof(MetricsHeader);
+    for (quint32 i = 0; i < h.symbols; ++i, p += sizeof(SymRecord)) {
+        SymRecord r;
+        memcpy(&r, p, sizeof(r));
+        Sym* sym = &_symbols[int(i)];
+        sym->setCode(r.code);
+        sym->setIndex(r.index);
+        sym->setBbox(QRectF(r.bbox[0], r.bbox[1], r.bbox[2], r.bbox[3]));
+        sym->setAdvance(r.advance);
+    }
+    for (quint32 i = 0; i < h.anchors; ++i, p += sizeof(AnchorRecord)) {
+        AnchorRecord r;
+        memcpy(&r, p, sizeof(r));
+        if (r.sym < h.symbols) {
+            _symbols[int(r.sym)].setSmuflAnchor(SmuflAnchorId(r.anchor), QPointF(r.x, r.y));
+        }
+    }
+    for (quint32 i = 0; i < h.defaults; ++i, p += sizeof(DefaultRecord)) {
+        DefaultRecord r;
+        memcpy(&r, p, sizeof(r));
+        _engravingDefaults.push_back(std::make_pair(Sid(r.sid), r.value));
+    }
+    _textEnclosureThickness = h.textEnclosureThickness;
+    return true;
+}
+
+//---------------------------------------------------------
+//   writeMetrics
+//---------------------------------------------------------
+
+void ScoreFont::writeMetrics(const QString& path, const QByteArray& hash) const
+{
+    if (path.isEmpty() || hash.size() != int(sizeof(MetricsHeader::hash))) {
+        return;
+    }
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qDebug("ScoreFont: cannot write metrics cache <%s>", qPrintable(path));
+        return;
+    }
+
+    std::vector<AnchorRecord> anchors;
+    for (int i = 0; i < _symbols.size(); ++i) {
+        for (const auto& a : _symbols[i].smuflAnchors) {
+            anchors.push_back({ quint32(i), quint32(a.first), a.second.x(), a.second.y() });
+        }
+    }
+
+    MetricsHeader h;
+    memcpy(h.magic, METRICS_MAGIC, sizeof(h.magic));
+    h.version    = METRICS_VERSION;
+    memcpy(h.hash, hash.constData(), sizeof(h.hash));
+    h.symbols    = quint32(_symbols.size());
+    h.anchors    = quint32(anchors.size());
+    h.defaults   = quint32(_engravingDefaults.size());
+    h.recordSize = METRICS_RECORD_SIZE;
+    h.textEnclosureThickness = _textEnclosureThickness;
+    f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+    for (const Sym& sym : _symbols) {
+        const QRectF bb = sym.bbox();
+        SymRecord r { sym.code(), sym.index(), { bb.x(), bb.y(), bb.width(), bb.height() }, sym.advance() };
+        f.write(reinterpret_cast<const char*>(&r), sizeof(r));
+    }
+    f.write(reinterpret_cast<const char*>(anchors.data()), anchors.size() * sizeof(AnchorRecord));
+    for (const auto& d : _engravingDefaults) {
+        DefaultRecord r { quint32(d.first), 0, d.second.toDouble() };
+        f.write(reinterpret_cast<const char*>(&r), sizeof(r));
+    }
+    if (!f.commit()) {
+        qDebug("ScoreFont: cannot write metrics cache <%s>", qPrintable(path));
+    }
+}
+
 //---------------------------------------------------------
 //   fontFactory
 //---------------------------------------------------------
@@ -7134,11 +7424,5 @@ ScoreFont::ScoreFont(const ScoreFont& f)
     _filename = f._filename;
 
     // fontImage;
-    cache = 0;
-}
-
-ScoreFont::~ScoreFont()
-{
-    delete cache;
 }
 }
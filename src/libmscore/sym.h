@@ -14,6 +14,7 @@
 #define __SYM_H__
 
 #include <QApplication>
+#include <QPainterPath>
 
 #include "config.h"
 #include "style.h"
@@ -3103,40 +3104,6 @@ public:
     friend class ScoreFont;
 };
 
-//---------------------------------------------------------
-//   GlyphKey
-///   \cond PLUGIN_API \private \endcond
-//---------------------------------------------------------
-
-struct GlyphKey {
-    FT_Face face;
-    SymId id;
-    qreal magX;
-    qreal magY;
-    qreal worldScale;
-    QColor color;
-
-public:
-    GlyphKey(FT_Face _f, SymId _id, float mx, float my, float s, QColor c)
-        : face(_f), id(_id), magX(mx), magY(my), worldScale(s), color(c) {}
-    bool operator==(const GlyphKey&) const;
-};
-
-//---------------------------------------------------------
-//   GlyphPixmap
-///   \cond PLUGIN_API \private \endcond
-//---------------------------------------------------------
-
-struct GlyphPixmap {
-    QPixmap pm;
-    QPointF offset;
-};
-
-inline uint qHash(const GlyphKey& k)
-{
-    return (int(k.id) << 16) + (int(k.magX * 100) << 8) + k.magY * 100;
-}
-
 //---------------------------------------------------------
 //   ScoreFont
 ///   \cond PLUGIN_API \private \endcond
@@ -3151,16 +3118,23 @@ class ScoreFont
     QString _fontPath;
     QString _filename;
     QByteArray fontImage;
-    QCache<GlyphKey, GlyphPixmap>* cache { 0 };
     std::list<std::pair<Sid, QVariant> > _engravingDefaults;
     double _textEnclosureThickness = 0;
     mutable QFont* font { 0 };
+    mutable QHash<int, QPainterPath> _outlines;     // flattened glyph outlines by SymId
 
     static QVector<ScoreFont> _scoreFonts;
     static std::array<uint, size_t(SymId::lastSym) + 1> _mainSymCodeTable;
+    static QString _metricsCacheDir;
+    static qreal _outlineThreshold;
     void load();
+    void loadMetrics(const QByteArray& metadata);
     void computeMetrics(Sym* sym, int code);
 
+    QString metricsCachePath() const;
+    bool readMetrics(const QString& path, const QByteArray& hash);
+    void writeMetrics(const QString& path, const QByteArray& hash) const;
+
 public:
     ScoreFont() {}
     ScoreFont(const ScoreFont&);
@@ -3170,8 +3144,6 @@ public:
         _symbols = QVector<Sym>(int(SymId::lastSym) + 1);
     }
 
-    ~ScoreFont();
-
     const QString& name() const { return _name; }
     const QString& family() const { return _family; }
     std::list<std::pair<Sid, QVariant> > engravingDefaults() { return _engravingDefaults; }
@@ -3184,8 +3156,15 @@ public:
     static const char* fallbackTextFont();
     static const QVector<ScoreFont>& scoreFonts() { return _scoreFonts; }
     static QJsonObject initGlyphNamesJson();
+    //! directory of the binary metrics cache; an empty string disables it
+    static void setMetricsCacheDir(const QString& dir) { _metricsCacheDir = dir; }
+    //! glyphs larger than this many device pixels (128 by default) are
+    //! filled as outlines when drawing with the raster engine
+    static void setOutlineThreshold(qreal pixels) { _outlineThreshold = pixels; }
+    static qreal outlineThreshold() { return _outlineThreshold; }
 
     QString toString(SymId) const;
+    QPainterPath outline(SymId) const;
     QPixmap sym2pixmap(SymId, qreal) { return QPixmap(); }        // TODOxxxx
 
     void draw(SymId id,                  QPainter*, const QSizeF& mag, const QPointF& pos, qreal scale) const;
@@ -1403,9 +1403,32 @@ Element* System::prevSegmentElement()
 //
 //    this - top system
 //    s2   - bottom system
+//
+//    With MScore::reuseUnchangedSystems the distance is
+//    kept until either system is collected again.
 //---------------------------------------------------------
 
 qreal System::minDistance(System* s2) const
+{
+    if (MScore::reuseUnchangedSystems && _distanceTo == s2 && _distanceVersion == _contentVersion
+        && _distanceToVersion == s2->contentVersion() && _contentVersion) {
+        fixedDownDistance = _cachedFixedDistance;
+        return _cachedDistance;
+    }
+    qreal dist = computeMinDistance(s2);
+    _distanceTo          = s2;
+    _distanceVersion     = _contentVersion;
+    _distanceToVersion   = s2->contentVersion();
+    _cachedDistance      = dist;
+    _cachedFixedDistance = fixedDownDistance;
+    return dist;
+}
+
+//---------------------------------------------------------
+//   computeMinDistance
+//---------------------------------------------------------
+
+qreal System::computeMinDistance(System* s2) const
 {
     if (vbox() && !s2->vbox()) {
         return qMax(vbox()->bottomGap(), s2->minTop());
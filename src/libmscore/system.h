@@ -101,8 +101,17 @@ class System final : public Element
     mutable Spacer* activeSpacer   { nullptr };
     qreal _distance                { 0.0 };     /// temp. variable used during layout
     qreal _systemHeight            { 0.0 };
+    int _contentVersion            { 0 };       ///< version of the layout pass which last collected this system
+
+    // minDistance() to the next system, kept while neither system is collected again
+    mutable const System* _distanceTo  { nullptr };
+    mutable int _distanceVersion       { 0 };
+    mutable int _distanceToVersion     { 0 };
+    mutable qreal _cachedDistance      { 0.0 };
+    mutable bool _cachedFixedDistance  { false };
 
     int firstVisibleSysStaff() const;
+    qreal computeMinDistance(System*) const;
     int lastVisibleSysStaff() const;
 
     int getBracketsColumnsCount();
@@ -205,6 +214,8 @@ public:
     int nextVisibleStaff(int) const;
     qreal distance() const { return _distance; }
     void setDistance(qreal d) { _distance = d; }
+    int contentVersion() const { return _contentVersion; }
+    void setContentVersion(int v) { _contentVersion = v; }
 
     int firstSysStaffOfPart(const Part* part) const;
     int firstVisibleSysStaffOfPart(const Part* part) const;
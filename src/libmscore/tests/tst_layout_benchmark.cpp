@@ -13,6 +13,16 @@
 #include "testing/qtestsuite.h"
 #include "testbase.h"
 #include "libmscore/score.h"
+#include "libmscore/page.h"
+#include "libmscore/system.h"
+#include "libmscore/measure.h"
+#include "libmscore/layoutbreak.h"
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/segment.h"
+#include "libmscore/glyphcache.h"
+#include "libmscore/allocationscope.h"
+#include "libmscore/sym.h"
 
 static const QString LAYOUT_DATA_DIR("layout_data/");
 
@@ -38,7 +48,18 @@ private slots:
     void benchmark3();
     void benchmark1();
     void benchmark2();
+    void benchmark2Allocations();   // element and shape allocations of a warm full layout
     void benchmark4();              // incremental layout (one page)
+    void benchmark5_data();
+    void benchmark5();              // insert measures on page 1 of a 100 page score and undo
+    void benchmark6();              // build page hit testing tree
+    void benchmark7();              // page hit testing queries
+    void benchmark8();              // paint a page (glyph cache)
+    void glyphColors();             // one cached mask per glyph, colored when drawn
+    void benchmark9();              // replay a recorded page display list
+    void benchmark10();             // paint a page at 600 dpi with glyph outlines
+    void benchmark11_data();
+    void benchmark11();             // paint pages at export resolutions, glyph masks vs outlines
 };
 
 //---------------------------------------------------------
@@ -81,6 +102,14 @@ void TestLayoutBenchmark::benchmark2()
     }
 }
 
+void TestLayoutBenchmark::benchmark2Allocations()
+{
+    score->doLayout();
+    AllocationScope allocations;
+    score->doLayout();
+    QTest::setBenchmarkResult(allocations.count(), QTest::Events);
+}
+
 void TestLayoutBenchmark::benchmark4()
 {
     QBENCHMARK {
@@ -90,5 +119,371 @@ void TestLayoutBenchmark::benchmark4()
     }
 }
 
+void TestLayoutBenchmark::benchmark5_data()
+{
+    QTest::addColumn<bool>("reuseSystems");
+
+    QTest::newRow("relayout") << false;
+    QTest::newRow("reuse") << true;
+}
+
+//---------------------------------------------------------
+//   layoutSnapshot
+//    first measure and position of every system by page
+//---------------------------------------------------------
+
+static QStringList layoutSnapshot(Score* score)
+{
+    QStringList list;
+    for (Page* page : score->pages()) {
+        for (System* system : page->systems()) {
+            list.append(QString("%1 %2 %3 %4").arg(page->no()).arg(system->measures().front()->tick().ticks())
+                        .arg(system->x()).arg(system->y()));
+        }
+    }
+    return list;
+}
+
+//---------------------------------------------------------
+//   benchmark5
+//    a 100 page score with a page break on every page, so
+//    inserting a page of measures on page 1 moves all
+//    following pages by one. This runs on its own copy of
+//    the score, the other benchmarks use the original one.
+//    With system reuse the incremental layout must match
+//    a full layout.
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark5()
+{
+    QFETCH(bool, reuseSystems);
+
+    MasterScore* s = readScore(LAYOUT_DATA_DIR + "goldberg.mscx");
+    QVERIFY(s);
+    s->setStyleValue(Sid::pageTwosided, false);
+    s->doLayout();
+    while (s->npages() < 100) {
+        s->startCmd();
+        s->appendMeasures(32);
+        s->endCmd();
+    }
+    s->startCmd();
+    for (Page* page : s->pages()) {
+        MeasureBase* mb = page->systems().back()->measures().back();
+        if (!mb->pageBreak()) {
+            LayoutBreak* lb = new LayoutBreak(s);
+            lb->setLayoutBreakType(LayoutBreak::Type::PAGE);
+            lb->setTrack(-1);
+            lb->setParent(mb);
+            s->undoAddElement(lb);
+        }
+    }
+    s->endCmd();
+
+    int firstPageMeasures = 0;
+    for (System* system : s->pages().front()->systems()) {
+        firstPageMeasures += system->measures().size();
+    }
+
+    bool oldReuse = MScore::reuseUnchangedSystems;
+    MScore::reuseUnchangedSystems = reuseSystems;
+    QBENCHMARK {
+        s->startCmd();
+        for (int i = 0; i < firstPageMeasures; ++i) {
+            s->insertMeasure(ElementType::MEASURE, s->firstMeasure());
+        }
+        s->endCmd();
+        s->undoRedo(true, nullptr);
+    }
+
+    s->startCmd();
+    for (int i = 0; i < firstPageMeasures; ++i) {
+        s->insertMeasure(ElementType::MEASURE, s->firstMeasure());
+    }
+    s->endCmd();
+    const QStringList incremental = layoutSnapshot(s);
+    MScore::reuseUnchangedSystems = oldReuse;
+
+    if (reuseSystems) {
+        s->doLayout();
+        QCOMPARE(incremental, layoutSnapshot(s));
+    }
+    delete s;
+}
+
+void TestLayoutBenchmark::benchmark6()
+{
+    Page* page = score->pages().front();
+    QBENCHMARK {
+        page->rebuildBspTree();
+        page->items(QPointF());
+    }
+}
+
+void TestLayoutBenchmark::benchmark7()
+{
+    Page* page = score->pages().front();
+    page->items(QPointF());            // make sure the tree is built
+    const QRectF r = page->bbox();
+    int found = 0;
+    QBENCHMARK {
+        for (qreal y = r.top(); y < r.bottom(); y += 10.0) {
+            for (qreal x = r.left(); x < r.right(); x += 10.0) {
+                page->visitItems(QRectF(x, y, 10.0, 10.0), [&found](Element*) { ++found; });
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void TestLayoutBenchmark::benchmark8()
+{
+    Page* page = score->pages().front();
+    const QList<Element*> el = page->items(page->abbox());
+    QImage img(page->bbox().size().toSize(), QImage::Format_ARGB32_Premultiplied);
+    GlyphCache* cache = GlyphCache::instance();
+    cache->resetStats();
+    QBENCHMARK {
+        QPainter p(&img);
+        for (const Element* e : el) {
+            p.save();
+            p.translate(e->pagePos());
+            e->draw(&p);
+            p.restore();
+        }
+    }
+    const GlyphCache::Stats stats = cache->stats();
+    QVERIFY(stats.hits > stats.misses);
+}
+
+//---------------------------------------------------------
+//   glyphColors
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::glyphColors()
+{
+    GlyphCache* cache = GlyphCache::instance();
+    cache->clear();
+    cache->resetStats();
+
+    for (QRgb color : { qRgb(255, 0, 0), qRgb(0, 0, 255), qRgba(0, 0, 255, 128) }) {
+        QImage img(64, 64, QImage::Format_ARGB32_Premultiplied);
+        img.fill(Qt::transparent);
+        QPainter p(&img);
+        p.setPen(QColor::fromRgba(color));
+        ScoreFont::fallbackFont()->draw(SymId::noteheadBlack, &p, 1.0, QPointF(16.0, 40.0));
+        p.end();
+
+        // the most opaque pixel of the glyph has the pen's color
+        QRgb opaque = 0;
+        for (int y = 0; y < img.height(); ++y) {
+            for (int x = 0; x < img.width(); ++x) {
+                if (qAlpha(img.pixel(x, y)) > qAlpha(opaque)) {
+                    opaque = img.pixel(x, y);
+                }
+            }
+        }
+        QCOMPARE(qAlpha(opaque), qAlpha(color));
+        QVERIFY(qAbs(qRed(opaque) - qRed(color)) <= 1);
+        QVERIFY(qAbs(qBlue(opaque) - qBlue(color)) <= 1);
+    }
+
+    const GlyphCache::Stats stats = cache->stats();
+    QCOMPARE(stats.misses, quint64(1));
+    QCOMPARE(stats.hits, quint64(2));
+}
+
+void TestLayoutBenchmark::benchmark9()
+{
+    Page* page = score->pages().front();
+    QImage img(page->bbox().size().toSize(), QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK {
+        QPainter p(&img);
+        p.drawPicture(0, 0, page->displayList());
+    }
+    QVERIFY(!page->displayList().isNull());
+    const int size = page->displayList().size();
+    score->invalidateDisplayLists();
+    QCOMPARE(page->displayList().size(), size);
+
+    // selection invalidates the list of the page, painting records it again
+    Element* e = score->firstMeasure()->first(SegmentType::ChordRest)->element(0);
+    QVERIFY(e);
+    e->setSelected(true);
+    QVERIFY(!page->displayListValid());
+    page->displayList();
+    QVERIFY(page->displayListValid());
+    e->setSelected(false);
+
+    // layout does not record it, only invalidates it
+    score->doLayout();
+    page = score->pages().front();
+    QVERIFY(!page->displayListValid());
+    page->displayList();
+    QVERIFY(page->displayListValid());
+
+    // so do property changes and playback highlighting
+    Note* note = nullptr;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s && !note; s = s->next1(SegmentType::ChordRest)) {
+        if (s->element(0) && s->element(0)->isChord()) {
+            note = toChord(s->element(0))->upNote();
+        }
+    }
+    QVERIFY(note);
+    page = toPage(note->findAncestor(ElementType::PAGE));
+    QVERIFY(page);
+    page->displayList();
+    const QColor color = note->color();
+    score->startCmd();
+    note->undoChangeProperty(Pid::COLOR, QColor(Qt::red));
+    score->endCmd();
+    QVERIFY(!page->displayListValid());
+    page->displayList();
+    score->undoRedo(true, nullptr);
+    QVERIFY(!page->displayListValid());
+    QCOMPARE(note->color(), color);
+
+    page->displayList();
+    note->setMark(true);
+    QVERIFY(!page->displayListValid());
+    page->displayList();
+    note->setMark(false);
+    QVERIFY(!page->displayListValid());
+}
+
+static QImage paintPage(const Page* page, const QList<Element*>& el, qreal scale)
+{
+    QImage img((page->bbox().size() * scale).toSize(), QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::white);
+    QPainter p(&img);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.scale(scale, scale);
+    for (const Element* e : el) {
+        p.save();
+        p.translate(e->pagePos());
+        e->draw(&p);
+        p.restore();
+    }
+    return img;
+}
+
+//---------------------------------------------------------
+//   edgeErrors
+//    number of pixels of a whose gray value differs by more
+//    than a quarter of the range from every pixel of b in
+//    its 3x3 neighbourhood
+//---------------------------------------------------------
+
+static int edgeErrors(const QImage& a, const QImage& b)
+{
+    constexpr int tolerance = 64;
+    int errors = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        const QRgb* pa = reinterpret_cast<const QRgb*>(a.constScanLine(y));
+        for (int x = 0; x < a.width(); ++x) {
+            const int ga = qGray(pa[x]);
+            int best = 255;
+            for (int yy = qMax(0, y - 1); yy <= qMin(b.height() - 1, y + 1) && best > tolerance; ++yy) {
+                const QRgb* pb = reinterpret_cast<const QRgb*>(b.constScanLine(yy));
+                for (int xx = qMax(0, x - 1); xx <= qMin(b.width() - 1, x + 1); ++xx) {
+                    best = qMin(best, qAbs(ga - qGray(pb[xx])));
+                }
+            }
+            if (best > tolerance) {
+                ++errors;
+            }
+        }
+    }
+    return errors;
+}
+
+void TestLayoutBenchmark::benchmark10()
+{
+    Page* page = score->pages().front();
+    const QList<Element*> el = page->items(page->abbox());
+    const qreal scale = 600.0 / DPI;
+    const qreal threshold = ScoreFont::outlineThreshold();
+
+    ScoreFont::setOutlineThreshold(1e6);           // glyph masks only
+    const QImage masks = paintPage(page, el, scale);
+    ScoreFont::setOutlineThreshold(0.0);           // glyph outlines only
+    QImage outlines;
+    QBENCHMARK {
+        outlines = paintPage(page, el, scale);
+    }
+    ScoreFont::setOutlineThreshold(threshold);
+
+    // the renderings may only differ in the anti-aliasing of glyph edges:
+    // every pixel of one must be close to a pixel of the other at most
+    // one pixel away, so that a missing, misplaced or misscaled glyph fails
+    QCOMPARE(masks.size(), outlines.size());
+    QCOMPARE(edgeErrors(masks, outlines), 0);
+    QCOMPARE(edgeErrors(outlines, masks), 0);
+}
+
+//---------------------------------------------------------
+//   benchmark11
+//    the first pages of the score as an image export paints
+//    them, starting with an empty glyph cache. The rows time
+//    masks only, outlines only and the default threshold, the
+//    numbers to choose ScoreFont::outlineThreshold() from.
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark11_data()
+{
+    QTest::addColumn<qreal>("dpi");
+    QTest::addColumn<qreal>("threshold");       // negative: the default
+
+    for (qreal dpi : { 300.0, 600.0 }) {
+        const QByteArray res = QByteArray::number(int(dpi)) + " dpi ";
+        QTest::newRow((res + "masks").constData()) << dpi << 1e6;
+        QTest::newRow((res + "outlines").constData()) << dpi << 0.0;
+        QTest::newRow((res + "default").constData()) << dpi << -1.0;
+    }
+}
+
+void TestLayoutBenchmark::benchmark11()
+{
+    QFETCH(qreal, dpi);
+    QFETCH(qreal, threshold);
+
+    constexpr int pages = 4;
+    const qreal scale = dpi / DPI;
+    const qreal defaultThreshold = ScoreFont::outlineThreshold();
+
+    // the repeated noteheads must stay on the mask path up to 600 dpi
+    Note* note = nullptr;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s && !note; s = s->next1(SegmentType::ChordRest)) {
+        if (s->element(0) && s->element(0)->isChord()) {
+            note = toChord(s->element(0))->upNote();
+        }
+    }
+    QVERIFY(note);
+    QVERIFY(note->bbox().width() * scale < defaultThreshold);
+
+    if (threshold >= 0.0) {
+        ScoreFont::setOutlineThreshold(threshold);
+    }
+    GlyphCache* cache = GlyphCache::instance();
+    QImage img((score->pages().front()->bbox().size() * scale).toSize(), QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK {
+        cache->clear();
+        for (int i = 0; i < qMin(pages, score->pages().size()); ++i) {
+            const Page* page = score->pages().at(i);
+            img.fill(Qt::white);
+            QPainter p(&img);
+            p.setRenderHint(QPainter::Antialiasing, true);
+            p.scale(scale, scale);
+            for (const Element* e : page->items(page->abbox())) {
+                p.save();
+                p.translate(e->pagePos());
+                e->draw(&p);
+                p.restore();
+            }
+        }
+    }
+    ScoreFont::setOutlineThreshold(defaultThreshold);
+}
+
 QTEST_MAIN(TestLayoutBenchmark)
 #include "tst_layout_benchmark.moc"
@@ -31,6 +31,7 @@
 #include "libmscore/sym.h"
 #include "libmscore/chordline.h"
 #include "libmscore/sym.h"
+#include "libmscore/accidental.h"
 
 static const QString PARTS_DATA_DIR("parts_data/");
 
@@ -127,6 +128,8 @@ private slots:
 
     void measureProperties();
 
+    void chordLayoutReplay();
+
     // second part has system text on empty chordrest segment
     void createPart3()
     {
@@ -1209,6 +1212,118 @@ void TestParts::measureProperties()
 {
 }
 
+//---------------------------------------------------------
+//   chordLayoutSnapshot
+//    note positions of all chords of a score
+//---------------------------------------------------------
+
+static QStringList chordLayoutSnapshot(Score* score)
+{
+    QStringList sl;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* e : s->elist()) {
+            if (!e || !e->isChord()) {
+                continue;
+            }
+            Chord* c = toChord(e);
+            for (Note* n : c->notes()) {
+                QPointF ap = n->accidental() ? n->accidental()->pos() : QPointF();
+                sl.append(QString("%1 %2 %3 %4 %5 %6 %7 %8")
+                          .arg(s->tick().ticks()).arg(c->track())
+                          .arg(n->pagePos().x()).arg(n->pagePos().y()).arg(n->mirror())
+                          .arg(ap.x()).arg(s->dotPosX(c->staffIdx())).arg(int(n->dotPosition())));
+            }
+        }
+    }
+    return sl;
+}
+
+//---------------------------------------------------------
+//   chordLayoutReplay
+//    parts laid out with the chord layout of the master
+//    score must look the same as parts laid out on their
+//    own, also after the master score has been edited
+//---------------------------------------------------------
+
+void TestParts::chordLayoutReplay()
+{
+    const bool reuse = MScore::reuseMasterChordLayout;
+
+    MScore::reuseMasterChordLayout = false;
+    MasterScore* score = readScore(PARTS_DATA_DIR + "part-all.mscx");
+    QVERIFY(score);
+    createParts(score);
+    score->doLayout();
+    QList<QStringList> ref;
+    for (Excerpt* ex : score->excerpts()) {
+        ex->partScore()->doLayout();
+        ref.append(chordLayoutSnapshot(ex->partScore()));
+    }
+
+    MScore::reuseMasterChordLayout = true;
+    score->doLayout();
+    QVERIFY(score->chordLayoutCache().size() > 0);
+    for (int i = 0; i < score->excerpts().size(); ++i) {
+        Score* part = score->excerpts().at(i)->partScore();
+        part->doLayout();
+        QCOMPARE(chordLayoutSnapshot(part), ref.at(i));
+    }
+
+    // move a note by an octave, the cached entry of its chord must not be used
+    Element* e = score->firstSegment(SegmentType::ChordRest)->element(0);
+    QVERIFY(e && e->isChord());
+    Chord* chord = toChord(e);
+    Note* note = chord->upNote();
+    score->startCmd();
+    score->undoChangePitch(note, note->pitch() + 12, note->tpc1(), note->tpc2());
+    score->endCmd();
+
+    QList<QStringList> replayed;
+    for (Excerpt* ex : score->excerpts()) {
+        replayed.append(chordLayoutSnapshot(ex->partScore()));
+    }
+    MScore::reuseMasterChordLayout = false;
+    for (int i = 0; i < score->excerpts().size(); ++i) {
+        Score* part = score->excerpts().at(i)->partScore();
+        part->doLayout();
+        QCOMPARE(replayed.at(i), chordLayoutSnapshot(part));
+    }
+
+    // user overrides of mirror and dot position in a part only, the part's chord
+    // no longer matches its cached entry
+    MScore::reuseMasterChordLayout = true;
+    score->doLayout();
+    Score* part = score->excerpts().front()->partScore();
+    Note* partNote = nullptr;
+    for (ScoreElement* se : note->linkList()) {
+        if (se->score() == part) {
+            partNote = toNote(se);
+        }
+    }
+    QVERIFY(partNote);
+    partNote->setUserMirror(MScore::DirectionH::LEFT);
+    partNote->setUserDotPosition(Direction::DOWN);
+    part->doLayout();
+    const QStringList overridden = chordLayoutSnapshot(part);
+    MScore::reuseMasterChordLayout = false;
+    part->doLayout();
+    QCOMPARE(overridden, chordLayoutSnapshot(part));
+    partNote->setUserMirror(MScore::DirectionH::AUTO);
+    partNote->setUserDotPosition(Direction::AUTO);
+
+    // removing the chord drops its entry
+    MScore::reuseMasterChordLayout = true;
+    score->doLayout();
+    const size_t n = score->chordLayoutCache().size();
+    score->startCmd();
+    score->deleteItem(chord);
+    score->endCmd();
+    QVERIFY(score->chordLayoutCache().size() < n);
+
+    MScore::reuseMasterChordLayout = reuse;
+    delete score;
+}
+
 QTEST_MAIN(TestParts)
 
 #include "tst_parts.moc"
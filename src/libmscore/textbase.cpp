@@ -35,6 +35,7 @@
 #include "xml.h"
 #include "undo.h"
 #include "mscore.h"
+#include "textmetricscache.h"
 
 namespace Ms {
 #ifdef Q_OS_MAC
@@ -1012,29 +1013,7 @@ QFont TextFragment::font(const TextBase* t) const
 
         // check if all symbols are available
         font.setFamily(family);
-        QFontMetricsF fm(font);
-
-        bool fail = false;
-        for (int i = 0; i < text.size(); ++i) {
-            QChar c = text[i];
-            if (c.isHighSurrogate()) {
-                if (i + 1 == text.size()) {
-                    qFatal("bad string");
-                }
-                QChar c2 = text[i + 1];
-                ++i;
-                uint v = QChar::surrogateToUcs4(c, c2);
-                if (!fm.inFontUcs4(v)) {
-                    fail = true;
-                    break;
-                }
-            } else {
-                if (!fm.inFont(c)) {
-                    fail = true;
-                    break;
-                }
-            }
-        }
+        bool fail = !TextMetricsCache::instance()->inFont(font, text);
         if (fail) {
             family = ScoreFont::fallbackTextFont();
         }
@@ -1112,9 +1091,9 @@ void TextBlock::layout(TextBase* t)
         auto fi = _fragments.begin();
         TextFragment& f = *fi;
         f.pos.setX(x);
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
+        const TextMetricsCache::FontData fm = TextMetricsCache::instance()->fontData(f.font(t));
         if (f.format.valign() != VerticalAlignment::AlignNormal) {
-            qreal voffset = fm.xHeight() / subScriptSize;   // use original height
+            qreal voffset = fm.xHeight / subScriptSize;   // use original height
             if (f.format.valign() == VerticalAlignment::AlignSubScript) {
                 voffset *= subScriptOffset;
             } else {
@@ -1126,17 +1105,19 @@ void TextBlock::layout(TextBase* t)
             f.pos.setY(0.0);
         }
 
-        QRectF temp(0.0, -fm.ascent(), 1.0, fm.descent());
+        QRectF temp(0.0, -fm.ascent, 1.0, fm.descent);
         _bbox |= temp;
-        _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
+        _lineSpacing = qMax(_lineSpacing, fm.lineSpacing);
     } else {
         const auto fiLast = --_fragments.end();
         for (auto fi = _fragments.begin(); fi != _fragments.end(); ++fi) {
             TextFragment& f = *fi;
             f.pos.setX(x);
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
+            const QFont font = f.font(t);
+            const TextMetricsCache::FontData fm = TextMetricsCache::instance()->fontData(font);
+            const TextMetricsCache::TextData tm = TextMetricsCache::instance()->textData(font, f.text);
             if (f.format.valign() != VerticalAlignment::AlignNormal) {
-                qreal voffset = fm.xHeight() / subScriptSize;           // use original height
+                qreal voffset = fm.xHeight / subScriptSize;           // use original height
                 if (f.format.valign() == VerticalAlignment::AlignSubScript) {
                     voffset *= subScriptOffset;
                 } else {
@@ -1150,12 +1131,11 @@ void TextBlock::layout(TextBase* t)
             // Optimization: don't calculate character position
             // for the next fragment if there is no next fragment
             if (fi != fiLast) {
-                const qreal w  = fm.width(f.text);
-                x += w;
+                x += tm.width;
             }
 
-            _bbox   |= fm.tightBoundingRect(f.text).translated(f.pos);
-            _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
+            _bbox   |= tm.tightBoundingRect.translated(f.pos);
+            _lineSpacing = qMax(_lineSpacing, fm.lineSpacing);
         }
     }
 
@@ -1206,18 +1186,15 @@ qreal TextBlock::xpos(int column, const TextBase* t) const
         if (column == col) {
             return f.pos.x();
         }
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
-        int idx = 0;
-        for (const QChar& c : qAsConst(f.text)) {
-            ++idx;
-            if (c.isHighSurrogate()) {
-                continue;
-            }
-            ++col;
-            if (column == col) {
-                return f.pos.x() + fm.width(f.text.left(idx));
+        const QFont font = f.font(t);
+        const TextMetricsCache::TextData tm = TextMetricsCache::instance()->textData(font, f.text);
+        if (column <= col + tm.columns) {
+            if (column == col + tm.columns) {
+                return f.pos.x() + tm.width;
             }
+            return f.pos.x() + TextMetricsCache::instance()->columnX(font, f.text, column - col - 1);
         }
+        col += tm.columns;
     }
     return _bbox.x();
 }
@@ -1301,18 +1278,14 @@ int TextBlock::column(qreal x, TextBase* t) const
 {
     int col = 0;
     for (const TextFragment& f : _fragments) {
-        int idx = 0;
         if (x <= f.pos.x()) {
             return col;
         }
         qreal px = 0.0;
-        for (const QChar& c : qAsConst(f.text)) {
-            ++idx;
-            if (c.isHighSurrogate()) {
-                continue;
-            }
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
-            qreal xo = fm.width(f.text.left(idx));
+        const QFont font = f.font(t);
+        const TextMetricsCache::TextData tm = TextMetricsCache::instance()->textData(font, f.text);
+        for (int i = 0; i < tm.columns; ++i) {
+            const qreal xo = i == tm.columns - 1 ? tm.width : TextMetricsCache::instance()->columnX(font, f.text, i);
             if (x <= f.pos.x() + px + (xo - px) * .5) {
                 return col;
             }
@@ -0,0 +1,211 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QFontMetricsF>
+
+#include "textmetricscache.h"
+#include "mscore.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   TextMetricsCache
+//---------------------------------------------------------
+
+TextMetricsCache::TextMetricsCache(int maxTexts)
+    : _fonts(256), _texts(maxTexts), _inFont(maxTexts), _columnX(maxTexts / 20)
+{
+}
+
+//---------------------------------------------------------
+//   instance
+//---------------------------------------------------------
+
+TextMetricsCache* TextMetricsCache::instance()
+{
+    static TextMetricsCache cache;
+    return &cache;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void TextMetricsCache::clear()
+{
+    QMutexLocker lock(&_mutex);
+    _fonts.clear();
+    _texts.clear();
+    _inFont.clear();
+    _columnX.clear();
+}
+
+//---------------------------------------------------------
+//   key
+//    metrics differ between devices of different
+//    resolution, so the device's is part of the key
+//---------------------------------------------------------
+
+TextMetricsCache::Key TextMetricsCache::key(const QFont& font, const QString& text, const QPaintDevice* device)
+{
+    if (!device) {
+        return { font, text, -1, -1 };
+    }
+    return { font, text, device->logicalDpiX(), device->logicalDpiY() };
+}
+
+//---------------------------------------------------------
+//   fontData
+//---------------------------------------------------------
+
+TextMetricsCache::FontData TextMetricsCache::fontData(const QFont& font, const QPaintDevice* device)
+{
+    if (!device) {
+        device = MScore::paintDevice();
+    }
+    const Key k = key(font, QString(), device);
+    {
+        QMutexLocker lock(&_mutex);
+        if (const FontData* d = _fonts.object(k)) {
+            return *d;
+        }
+    }
+    QFontMetricsF fm(font, const_cast<QPaintDevice*>(device));
+    FontData* d    = new FontData;
+    d->ascent      = fm.ascent();
+    d->descent     = fm.descent();
+    d->xHeight     = fm.xHeight();
+    d->lineSpacing = fm.lineSpacing();
+    const FontData result = *d;
+
+    QMutexLocker lock(&_mutex);
+    _fonts.insert(k, d);
+    return result;
+}
+
+//---------------------------------------------------------
+//   textData
+//---------------------------------------------------------
+
+TextMetricsCache::TextData TextMetricsCache::textData(const QFont& font, const QString& text, const QPaintDevice* device)
+{
+    if (!device) {
+        device = MScore::paintDevice();
+    }
+    const Key k = key(font, text, device);
+    {
+        QMutexLocker lock(&_mutex);
+        if (const TextData* d = _texts.object(k)) {
+            return *d;
+        }
+    }
+    QFontMetricsF fm(font, const_cast<QPaintDevice*>(device));
+    TextData* d = new TextData;
+    d->width             = fm.width(text);
+    d->tightBoundingRect = fm.tightBoundingRect(text);
+    for (const QChar& c : text) {
+        if (!c.isHighSurrogate()) {
+            ++d->columns;
+        }
+    }
+    const TextData result = *d;
+
+    QMutexLocker lock(&_mutex);
+    _texts.insert(k, d);
+    return result;
+}
+
+//---------------------------------------------------------
+//   columnX
+//    width of text up to and including column.
+//    Only cursor handling needs this, so the widths are
+//    measured on demand and only up to the column asked
+//    for; later calls continue where the last one stopped.
+//---------------------------------------------------------
+
+qreal TextMetricsCache::columnX(const QFont& font, const QString& text, int column, const QPaintDevice* device)
+{
+    if (!device) {
+        device = MScore::paintDevice();
+    }
+    const Key k = key(font, text, device);
+    QVector<qreal> x;
+    {
+        QMutexLocker lock(&_mutex);
+        if (const QVector<qreal>* v = _columnX.object(k)) {
+            if (column < v->size()) {
+                return v->at(column);
+            }
+            x = *v;
+        }
+    }
+    QFontMetricsF fm(font, const_cast<QPaintDevice*>(device));
+    int col = 0;
+    int idx = 0;
+    for (const QChar& c : text) {
+        ++idx;
+        if (c.isHighSurrogate()) {
+            continue;
+        }
+        if (col == x.size()) {
+            x.append(fm.width(text.left(idx)));
+        }
+        if (col == column) {
+            break;
+        }
+        ++col;
+    }
+    const qreal result = column < x.size() ? x.at(column) : (x.isEmpty() ? 0.0 : x.last());
+
+    QMutexLocker lock(&_mutex);
+    const QVector<qreal>* v = _columnX.object(k);
+    if (!v || v->size() < x.size()) {
+        _columnX.insert(k, new QVector<qreal>(x), 1 + x.size() / 16);
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   inFont
+//    check with the default paint device, as Qt does for
+//    font fallback
+//---------------------------------------------------------
+
+bool TextMetricsCache::inFont(const QFont& font, const QString& text)
+{
+    const Key k = key(font, text, nullptr);
+    {
+        QMutexLocker lock(&_mutex);
+        if (const bool* b = _inFont.object(k)) {
+            return *b;
+        }
+    }
+    QFontMetricsF fm(font);
+    bool ok = true;
+    for (int i = 0; i < text.size() && ok; ++i) {
+        QChar c = text[i];
+        if (c.isHighSurrogate()) {
+            if (i + 1 == text.size()) {
+                qFatal("bad string");
+            }
+            QChar c2 = text[i + 1];
+            ++i;
+            ok = fm.inFontUcs4(QChar::surrogateToUcs4(c, c2));
+        } else {
+            ok = fm.inFont(c);
+        }
+    }
+
+    QMutexLocker lock(&_mutex);
+    _inFont.insert(k, new bool(ok));
+    return ok;
+}
+}
@@ -0,0 +1,91 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __TEXTMETRICSCACHE_H__
+#define __TEXTMETRICSCACHE_H__
+
+#include <QCache>
+#include <QFont>
+#include <QMutex>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+class QPaintDevice;
+
+namespace Ms {
+//---------------------------------------------------------
+//   TextMetricsCache
+//    process wide least recently used cache of font and
+//    text metrics measured on a paint device, by default
+//    MScore::paintDevice(), keyed by font (family, size,
+//    style), string and the logical resolution of the
+//    device. Text layout measures the same syllables,
+//    dynamics and tempo texts over and over; this avoids
+//    creating a QFontMetricsF and shaping the string each
+//    time.
+//---------------------------------------------------------
+
+class TextMetricsCache
+{
+public:
+    struct FontData {
+        qreal ascent      { 0.0 };
+        qreal descent     { 0.0 };
+        qreal xHeight     { 0.0 };
+        qreal lineSpacing { 0.0 };
+    };
+
+    struct TextData {
+        qreal width { 0.0 };
+        QRectF tightBoundingRect;
+        int columns { 0 };            // characters, surrogate pairs count as one
+    };
+
+private:
+    struct Key {
+        QFont font;
+        QString text;           // empty for font data
+        int dpiX;               // of the device measured on, -1 for Qt's default device
+        int dpiY;
+        bool operator==(const Key& k) const
+        {
+            return dpiX == k.dpiX && dpiY == k.dpiY && text == k.text && font == k.font;
+        }
+    };
+    friend uint qHash(const Key& k, uint seed)
+    {
+        return qHash(k.font, seed) ^ qHash(k.text, seed) ^ ::qHash((k.dpiX << 16) ^ k.dpiY, seed);
+    }
+
+    static Key key(const QFont& font, const QString& text, const QPaintDevice* device);
+
+    mutable QMutex _mutex;
+    QCache<Key, FontData> _fonts;
+    QCache<Key, TextData> _texts;
+    QCache<Key, bool> _inFont;
+    QCache<Key, QVector<qreal> > _columnX;    // filled on demand by columnX()
+
+public:
+    TextMetricsCache(int maxTexts = 20000);
+
+    static TextMetricsCache* instance();
+
+    //! device defaults to MScore::paintDevice()
+    FontData fontData(const QFont& font, const QPaintDevice* device = nullptr);
+    TextData textData(const QFont& font, const QString& text, const QPaintDevice* device = nullptr);
+    qreal columnX(const QFont& font, const QString& text, int column, const QPaintDevice* device = nullptr);
+    bool inFont(const QFont& font, const QString& text);
+    void clear();
+};
+}     // namespace Ms
+#endif
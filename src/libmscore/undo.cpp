@@ -2009,6 +2009,9 @@ void InsertRemoveMeasures::removeMeasures()
             break;
         }
     }
+    if (score->isMaster()) {
+        score->masterScore()->chordLayoutCache().remove(fm, lm);
+    }
     score->measures()->remove(fm, lm);
 
     score->fixTicks();
@@ -2327,6 +2330,7 @@ void ChangeProperty::flip(EditData*)
 
     element->setProperty(id, property);
     element->setPropertyFlags(id, flags);
+    element->invalidateDisplayList();     // colors and other properties change without a layout
     property = v;
     flags = ps;
 }
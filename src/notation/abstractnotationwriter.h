@@ -26,6 +26,8 @@ namespace mu::notation {
 class AbstractNotationWriter : public INotationWriter
 {
 public:
+    Ret writeParts(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                   const Options& options = Options()) override;
     void abort() override;
     framework::ProgressChannel progress() const override;
 
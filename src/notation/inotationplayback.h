@@ -33,6 +33,8 @@ public:
     virtual ~INotationPlayback() = default;
 
     virtual std::shared_ptr<midi::MidiStream> midiStream() const = 0;
+    //! the whole score in one stream that doesn't request data, for offline rendering
+    virtual std::shared_ptr<midi::MidiStream> offlineMidiStream() const = 0;
 
     virtual QTime totalPlayTime() const = 0;
 
@@ -20,6 +20,8 @@
 #ifndef MU_NOTATION_INOTATIONWRITER_H
 #define MU_NOTATION_INOTATIONWRITER_H
 
+#include <vector>
+
 #include "ret.h"
 #include "val.h"
 
@@ -36,7 +38,8 @@ public:
         PAGE_NUMBER,
         TRANSPARENT_BACKGROUND,
         TRIM_MARGINS_SIZE,
-        NOTES_COLORS
+        NOTES_COLORS,
+        REUSE_GLYPHS
     };
 
     using Options = QMap<OptionKey, Val>;
@@ -44,6 +47,10 @@ public:
     virtual ~INotationWriter() = default;
 
     virtual Ret write(const INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) = 0;
+
+    //! writes each part of the notation to its own device, in the order of the parts, in one pass
+    virtual Ret writeParts(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                           const Options& options = Options()) = 0;
     virtual void abort() = 0;
     virtual framework::ProgressChannel progress() const = 0;
 };
@@ -24,6 +24,11 @@
 using namespace mu::notation;
 using namespace mu::framework;
 
+mu::Ret AbstractNotationWriter::writeParts(const INotationPtr, const std::vector<system::IODevice*>&, const Options&)
+{
+    return make_ret(Ret::Code::NotSupported);
+}
+
 void AbstractNotationWriter::abort()
 {
     NOT_IMPLEMENTED;
@@ -265,6 +265,13 @@ void Notation::paint(QPainter* painter, const QRectF& frameRect)
 
 void Notation::paintPages(QPainter* painter, const QRectF& frameRect, const QList<Ms::Page*>& pages, bool paintBorders) const
 {
+    //! NOTE While dragging or editing, elements change from frame to frame
+    //! without a layout, so they are painted directly
+    const bool useDisplayLists = Ms::MScore::useDisplayLists
+                                 && !m_interaction->isDragStarted()
+                                 && !m_interaction->isTextEditingStarted()
+                                 && !m_interaction->isGripEditStarted();
+
     for (Ms::Page* page : pages) {
         QRectF pageRect(page->abbox().translated(page->pos()));
 
@@ -284,8 +291,12 @@ void Notation::paintPages(QPainter* painter, const QRectF& frameRect, const QLis
         painter->translate(pagePosition);
         painter->fillRect(page->bbox(), configuration()->pageColor());
 
-        QList<Element*> elements = page->items(frameRect.translated(-page->pos()));
-        Ms::paintElements(*painter, elements);
+        if (useDisplayLists) {
+            painter->drawPicture(0, 0, page->displayList());
+        } else {
+            QList<Element*> elements = page->items(frameRect.translated(-page->pos()));
+            Ms::paintElements(*painter, elements);
+        }
 
         painter->translate(-pagePosition);
     }
@@ -125,6 +125,37 @@ std::shared_ptr<MidiStream> NotationPlayback::midiStream() const
     return m_midiStream;
 }
 
+std::shared_ptr<MidiStream> NotationPlayback::offlineMidiStream() const
+{
+    if (!score()) {
+        return nullptr;
+    }
+
+    IF_ASSERT_FAILED(m_midiRenderer) {
+        return nullptr;
+    }
+
+    auto stream = std::make_shared<MidiStream>();
+    stream->isStreamingAllowed = false;
+    m_midiRenderer->setScoreChanged();
+
+    makeInitData(stream->initData, score());
+    stream->lastTick = score()->lastMeasure()->endTick().ticks();
+
+    tick_t tick = 0;
+    while (tick < stream->lastTick) {
+        midi::Chunk chunk;
+        makeChunk(chunk, tick);
+        if (chunk.endTick <= tick) {
+            break;
+        }
+        tick = chunk.endTick;
+        stream->initData.chunks.insert({ chunk.beginTick, std::move(chunk) });
+    }
+
+    return stream;
+}
+
 void NotationPlayback::makeInitData(MidiData& data, Ms::Score* score) const
 {
     data.division = Ms::MScore::division;
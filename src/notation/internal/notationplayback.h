@@ -45,6 +45,7 @@ public:
     void init();
 
     std::shared_ptr<midi::MidiStream> midiStream() const override;
+    std::shared_ptr<midi::MidiStream> offlineMidiStream() const override;
 
     QTime totalPlayTime() const override;
 
@@ -0,0 +1,51 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_NOTATION_MASTERNOTATIONMOCK_H
+#define MU_NOTATION_MASTERNOTATIONMOCK_H
+
+#include <gmock/gmock.h>
+
+#include "notation/imasternotation.h"
+
+namespace mu::notation {
+class MasterNotationMock : public IMasterNotation
+{
+public:
+    MOCK_METHOD(INotationPtr, notation, (), (override));
+
+    MOCK_METHOD(Meta, metaInfo, (), (const, override));
+
+    MOCK_METHOD(Ret, load, (const io::path&), (override));
+    MOCK_METHOD(io::path, path, (), (const, override));
+
+    MOCK_METHOD(Ret, createNew, (const ScoreCreateOptions&), (override));
+    MOCK_METHOD(RetVal<bool>, created, (), (const, override));
+
+    MOCK_METHOD(Ret, save, (const io::path&, SaveMode), (override));
+    MOCK_METHOD(ValNt<bool>, needSave, (), (const, override));
+
+    MOCK_METHOD(ValCh<ExcerptNotationList>, excerpts, (), (const, override));
+    MOCK_METHOD(void, setExcerpts, (const ExcerptNotationList&), (override));
+
+    MOCK_METHOD(INotationPartsPtr, parts, (), (const, override));
+    MOCK_METHOD(INotationPtr, clone, (), (const, override));
+};
+}
+
+#endif // MU_NOTATION_MASTERNOTATIONMOCK_H
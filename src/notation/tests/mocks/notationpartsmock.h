@@ -0,0 +1,73 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_NOTATION_NOTATIONPARTSMOCK_H
+#define MU_NOTATION_NOTATIONPARTSMOCK_H
+
+#include <gmock/gmock.h>
+
+#include "notation/inotationparts.h"
+
+namespace mu::notation {
+class NotationPartsMock : public INotationParts
+{
+public:
+    MOCK_METHOD(async::NotifyList<const Part*>, partList, (), (const, override));
+    MOCK_METHOD(async::NotifyList<instruments::Instrument>, instrumentList, (const ID&), (const, override));
+    MOCK_METHOD(async::NotifyList<const Staff*>, staffList, (const ID&, const ID&), (const, override));
+
+    MOCK_METHOD(ValCh<bool>, canChangeInstrumentVisibility, (const ID&, const ID&), (const, override));
+    MOCK_METHOD(bool, voiceVisible, (int), (const, override));
+
+    MOCK_METHOD(void, setInstruments, (const instruments::InstrumentList&), (override));
+    MOCK_METHOD(void, setPartVisible, (const ID&, bool), (override));
+    MOCK_METHOD(void, setInstrumentVisible, (const ID&, const ID&, bool), (override));
+    MOCK_METHOD(void, setStaffVisible, (const ID&, bool), (override));
+    MOCK_METHOD(void, setVoiceVisible, (int, bool), (override));
+    MOCK_METHOD(void, setVoiceVisible, (const ID&, int, bool), (override));
+    MOCK_METHOD(void, setPartName, (const ID&, const QString&), (override));
+    MOCK_METHOD(void, setPartSharpFlat, (const ID&, const SharpFlat&), (override));
+    MOCK_METHOD(void, setPartTransposition, (const ID&, const instruments::Interval&), (override));
+    MOCK_METHOD(void, setInstrumentName, (const ID&, const ID&, const QString&), (override));
+    MOCK_METHOD(void, setInstrumentAbbreviature, (const ID&, const ID&, const QString&), (override));
+    MOCK_METHOD(void, setStaffType, (const ID&, StaffType), (override));
+    MOCK_METHOD(void, setCutawayEnabled, (const ID&, bool), (override));
+    MOCK_METHOD(void, setSmallStaff, (const ID&, bool), (override));
+
+    MOCK_METHOD(void, setStaffConfig, (const ID&, const StaffConfig&), (override));
+
+    MOCK_METHOD(void, removeParts, (const IDList&), (override));
+    MOCK_METHOD(void, removeInstruments, (const IDList&, const ID&), (override));
+    MOCK_METHOD(void, removeStaves, (const IDList&), (override));
+
+    MOCK_METHOD(void, moveParts, (const IDList&, const ID&, InsertMode), (override));
+    MOCK_METHOD(void, moveInstruments, (const IDList&, const ID&, const ID&, const ID&, InsertMode), (override));
+    MOCK_METHOD(void, moveStaves, (const IDList&, const ID&, InsertMode), (override));
+
+    MOCK_METHOD(void, appendDoublingInstrument, (const instruments::Instrument&, const ID&), (override));
+    MOCK_METHOD(void, appendStaff, (Staff*, const ID&), (override));
+
+    MOCK_METHOD(void, cloneStaff, (const ID&, const ID&), (override));
+
+    MOCK_METHOD(void, replaceInstrument, (const ID&, const ID&, const instruments::Instrument&), (override));
+
+    MOCK_METHOD(async::Notification, partsChanged, (), (const, override));
+};
+}
+
+#endif // MU_NOTATION_NOTATIONPARTSMOCK_H
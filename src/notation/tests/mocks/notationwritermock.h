@@ -0,0 +1,37 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_NOTATION_NOTATIONWRITERMOCK_H
+#define MU_NOTATION_NOTATIONWRITERMOCK_H
+
+#include <gmock/gmock.h>
+
+#include "notation/inotationwriter.h"
+
+namespace mu::notation {
+class NotationWriterMock : public INotationWriter
+{
+public:
+    MOCK_METHOD(Ret, write, (const INotationPtr, system::IODevice&, const Options&), (override));
+    MOCK_METHOD(Ret, writeParts, (const INotationPtr, const std::vector<system::IODevice*>&, const Options&), (override));
+    MOCK_METHOD(void, abort, (), (override));
+    MOCK_METHOD(framework::ProgressChannel, progress, (), (const, override));
+};
+}
+
+#endif // MU_NOTATION_NOTATIONWRITERMOCK_H
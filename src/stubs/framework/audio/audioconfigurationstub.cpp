@@ -26,6 +26,11 @@ unsigned int AudioConfigurationStub::driverBufferSize() const
     return 0;
 }
 
+int AudioConfigurationStub::zerberusStreamingPreloadTime() const
+{
+    return 0;
+}
+
 std::vector<io::path> AudioConfigurationStub::soundFontPaths() const
 {
     return {};
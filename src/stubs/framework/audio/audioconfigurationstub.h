@@ -27,6 +27,8 @@ class AudioConfigurationStub : public IAudioConfiguration
 public:
     unsigned int driverBufferSize() const override;
 
+    int zerberusStreamingPreloadTime() const override;
+
     std::vector<io::path> soundFontPaths() const override;
     const synth::SynthesizerState& synthesizerState() const override;
     Ret saveSynthesizerState(const synth::SynthesizerState& state) override;
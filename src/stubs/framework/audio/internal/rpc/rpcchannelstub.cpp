@@ -37,3 +37,11 @@ IRpcChannel::ListenID RpcChannelStub::listen(IRpcChannel::Handler)
 void RpcChannelStub::unlisten(IRpcChannel::ListenID)
 {
 }
+
+void RpcChannelStub::sendCommand(const Command&)
+{
+}
+
+void RpcChannelStub::listenCommands(IRpcChannel::CommandHandler)
+{
+}
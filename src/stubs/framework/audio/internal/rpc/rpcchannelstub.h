@@ -31,6 +31,9 @@ public:
 
     ListenID listen(Handler h) override;
     void unlisten(ListenID id) override;
+
+    void sendCommand(const Command& cmd) override;
+    void listenCommands(CommandHandler h) override;
 };
 }
 
@@ -99,6 +99,10 @@ bool SynthesizerStub::handleEvent(const midi::Event&)
     return false;
 }
 
+void SynthesizerStub::scheduleEvent(const midi::Event&, unsigned int)
+{
+}
+
 void SynthesizerStub::writeBuf(float*, unsigned int)
 {
 }